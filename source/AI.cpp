@@ -27,10 +27,12 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Point.h"
 #include "Preferences.h"
 #include "Random.h"
+#include "RouteCache.h"
 #include "Ship.h"
 #include "ShipEvent.h"
 #include "StellarObject.h"
 #include "System.h"
+#include "ThreadPool.h"
 #include "Weapon.h"
 
 #include <algorithm>
@@ -53,7 +55,7 @@ namespace {
 	bool IsStranded(const Ship &ship)
 	{
 		return ship.GetSystem() && !ship.IsEnteringHyperspace() && !ship.GetSystem()->HasFuelFor(ship)
-			&& ship.JumpFuel() && ship.Attributes().Get("fuel capacity") && !ship.JumpsRemaining();
+			&& ship.JumpFuel() && ship.Attributes().Get(Attribute::FUEL_CAPACITY) && !ship.JumpsRemaining();
 	}
 	
 	bool CanBoard(const Ship &ship, const Ship &target)
@@ -185,7 +187,7 @@ namespace {
 	bool ShouldRefuel(const Ship &ship, const DistanceMap &route, double fuelCapacity = 0.)
 	{
 		if(!fuelCapacity)
-			fuelCapacity = ship.Attributes().Get("fuel capacity");
+			fuelCapacity = ship.Attributes().Get(Attribute::FUEL_CAPACITY);
 		
 		const System *from = ship.GetSystem();
 		const bool systemHasFuel = from->HasFuelFor(ship) && fuelCapacity;
@@ -213,7 +215,7 @@ namespace {
 	{
 		if(!to || ship.Fuel() == 1. || !ship.GetSystem()->HasFuelFor(ship))
 			return false;
-		double fuelCapacity = ship.Attributes().Get("fuel capacity");
+		double fuelCapacity = ship.Attributes().Get(Attribute::FUEL_CAPACITY);
 		if(!fuelCapacity)
 			return false;
 		double needed = ship.JumpFuel(to);
@@ -223,7 +225,7 @@ namespace {
 		{
 			// If no direct jump route, or the target system has no
 			// fuel, perform a more elaborate refueling check.
-			return ShouldRefuel(ship, DistanceMap(ship, to), fuelCapacity);
+			return ShouldRefuel(ship, *RouteCache::Get(ship, to), fuelCapacity);
 		}
 	}
 	
@@ -258,9 +260,9 @@ namespace {
 		const System *from = ship.GetSystem();
 		if(from == targetSystem || !targetSystem)
 			return;
-		const DistanceMap route(ship, targetSystem);
-		const bool needsRefuel = ShouldRefuel(ship, route);
-		const System *to = route.Route(from);
+		const shared_ptr<const DistanceMap> route = RouteCache::Get(ship, targetSystem);
+		const bool needsRefuel = ShouldRefuel(ship, *route);
+		const System *to = route->Route(from);
 		// The destination may be accessible by both jump and wormhole.
 		// Prefer wormhole travel in these cases, to conserve fuel. Must
 		// check accessibility as DistanceMap may only see the jump path.
@@ -297,12 +299,145 @@ namespace {
 	// The health remaining before becoming disabled, at which fighters and
 	// other ships consider retreating from battle.
 	const double RETREAT_HEALTH = .25;
+	
+	// The most that the preferences in FindTarget() can make a target seem
+	// closer than it actually is, with some margin.
+	const double TARGET_RANGE_BONUS = 4000.;
+	
+	// Scramble the bits of the given number (this is the last part of the
+	// SplitMix64 generator), so that similar numbers give unrelated seeds.
+	uint64_t Mix(uint64_t value)
+	{
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		return value ^ (value >> 31);
+	}
+	
+	// Find the ship at the top of the fleet that the given ship belongs to, by
+	// following its parents. The flagship does not count, because it has already
+	// moved when the other ships decide what to do, so each of the player's
+	// escorts leads a fleet of its own. The leader of each ship on the way is
+	// remembered, so that every fleet is only followed up once.
+	const Ship *FleetLeader(const Ship &ship, const Ship *flagship, map<const Ship *, const Ship *> &leaders)
+	{
+		vector<const Ship *> chain;
+		const Ship *leader = &ship;
+		for(shared_ptr<const Ship> it = ship.shared_from_this(); it && it.get() != flagship; it = it->GetParent())
+		{
+			auto known = leaders.find(it.get());
+			if(known != leaders.end())
+			{
+				leader = known->second;
+				break;
+			}
+			// Parents should never loop back around, but if they do, stop there.
+			if(find(chain.begin(), chain.end(), it.get()) != chain.end())
+				break;
+			chain.push_back(it.get());
+			leader = it.get();
+		}
+		for(const Ship *member : chain)
+			leaders[member] = leader;
+		return leader;
+	}
+	
+	// Check if the given ship may make a decision that depends on or changes
+	// the ships outside of its own fleet, other than the changes that are only
+	// made once every ship has decided what to do: claiming one of the limited
+	// places for miners, looking for a new parent to be carried by, or leaving
+	// a parent that is not part of this ship's fleet.
+	bool AffectsOtherFleets(const Ship &ship, bool isPresent, bool canMine, const Ship *flagship)
+	{
+		const Personality &personality = ship.GetPersonality();
+		if(isPresent && canMine && personality.IsMining())
+			return true;
+		
+		shared_ptr<const Ship> parent = ship.GetParent();
+		if(!parent)
+			return ship.CanBeCarried();
+		// A ship whose parent was destroyed follows its parent's parent instead.
+		if(parent->IsDestroyed())
+			return true;
+		// The flagship's escorts belong to many different fleets.
+		if(parent.get() == flagship && (personality.IsCoward() || personality.IsSwarming()))
+			return true;
+		return ship.CanBeCarried() && (personality.IsCoward() || parent->GetGovernment() != ship.GetGovernment()
+			|| parent->GetSystem() != ship.GetSystem() || !parent->BaysFree(ship.Attributes().Category()));
+	}
 }
 
 
 
-AI::AI(const List<Ship> &ships, const List<Minable> &minables, const List<Flotsam> &flotsam)
-	: ships(ships), minables(minables), flotsam(flotsam)
+// The random numbers used in the decisions about a ship. The player's ship
+// uses the shared generator, but the other ships are decided on worker threads,
+// so each of them gets a generator (SplitMix64) seeded for that ship in this
+// step. That way, the choices do not depend on which thread makes them.
+class AI::ShipRandom {
+public:
+	// Use the shared generator.
+	ShipRandom() = default;
+	// Use a generator that starts from the given seed.
+	explicit ShipRandom(uint64_t seed) : isSeeded(true), state(seed) {}
+	
+	uint32_t Int(uint32_t upperBound)
+	{
+		if(!isSeeded)
+			return Random::Int(upperBound);
+		return (static_cast<uint64_t>(Next() >> 32) * upperBound) >> 32;
+	}
+	double Real()
+	{
+		if(!isSeeded)
+			return Random::Real();
+		return (Next() >> 11) / static_cast<double>(1ull << 53);
+	}
+	
+private:
+	uint64_t Next()
+	{
+		return Mix(state += 0x9E3779B97F4A7C15ull);
+	}
+	
+private:
+	bool isSeeded = false;
+	uint64_t state = 0;
+};
+
+
+
+// What the AI knows about a ship in this step, and the decisions about it that
+// affect other ships or the rest of the game. Those are only carried out once
+// every ship has decided what to do, in the order of the ships.
+class AI::ShipStep {
+public:
+	ShipStep(const shared_ptr<Ship> &ship, uint64_t seed) : ship(ship), random(seed) {}
+	
+	shared_ptr<Ship> ship;
+	ShipRandom random;
+	double healthRemaining = 0.;
+	bool isPresent = false;
+	bool isStranded = false;
+	bool thisIsLaunching = false;
+	bool opportunistic = false;
+	// Whether this ship may switch targets in this step.
+	bool isTargetTurn = false;
+	// Whether the ship that this ship was asked to help can still be helped.
+	// This is checked before any ship decides what to do, because it depends
+	// on where the other ship is planning to go.
+	bool canAssist = false;
+	
+	// The cargo that this ship decided to jettison.
+	vector<pair<string, int>> jettison;
+	string message;
+	// The ships that this ship stopped or started swarming around.
+	const Ship *swarmLeft = nullptr;
+	const Ship *swarmJoined = nullptr;
+};
+
+
+
+AI::AI(const List<Ship> &ships, const List<Minable> &minables, const List<Flotsam> &flotsam, ThreadPool &workers)
+	: ships(ships), minables(minables), flotsam(flotsam), workers(workers), randomSeed(Random::Int())
 {
 }
 
@@ -363,7 +498,7 @@ void AI::UpdateKeys(PlayerInfo &player, Command &activeCommands)
 	// Only toggle the "cloak" command if one of your ships has a cloaking device.
 	if(activeCommands.Has(Command::CLOAK))
 		for(const auto &it : player.Ships())
-			if(!it->IsParked() && it->Attributes().Get("cloak"))
+			if(!it->IsParked() && it->Attributes().Get(Attribute::CLOAK))
 			{
 				isCloaking = !isCloaking;
 				Messages::Add(isCloaking ? "Engaging cloaking device." : "Disengaging cloaking device."
@@ -523,25 +658,35 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 	const Ship *flagship = player.Flagship();
 	step = (step + 1) & 31;
 	int targetTurn = 0;
-	int minerCount = 0;
-	const int maxMinerCount = minables.empty() ? 0 : 9;
+	minerCount = 0;
+	const bool canMine = !minables.empty();
 	bool opportunisticEscorts = !Preferences::Has("Turrets focus fire");
 	bool fightersRetreat = Preferences::Has("Damaged fighters retreat");
+	const uint64_t stepSeed = Mix(randomSeed += 0x9E3779B97F4A7C15ull);
+	
+	// What the flagship is doing matters to many other ships, so the player
+	// moves first.
 	for(const auto &it : ships)
-	{
-		// Skip any carried fighters or drones that are somehow in the list.
-		if(!it->GetSystem())
-			continue;
-		
 		if(it.get() == flagship)
 		{
 			// Player cannot do anything if the flagship is landing.
-			if(!flagship->IsLanding())
+			if(it->GetSystem() && !flagship->IsLanding())
 				MovePlayer(*it, player, activeCommands);
-			continue;
+			break;
 		}
+	
+	// Next, figure out which ships are able to act. Disabled and stranded ships
+	// ask for help now, before any ship has changed its plans.
+	vector<ShipStep> steps;
+	steps.reserve(ships.size());
+	size_t nextIndex = 0;
+	for(const auto &it : ships)
+	{
+		const size_t index = nextIndex++;
+		// Skip any carried fighters or drones that are somehow in the list.
+		if(!it->GetSystem() || it.get() == flagship)
+			continue;
 		
-		const Government *gov = it->GetGovernment();
 		const Personality &personality = it->GetPersonality();
 		double healthRemaining = it->Health();
 		bool isPresent = (it->GetSystem() == playerSystem);
@@ -583,368 +728,465 @@ void AI::Step(const PlayerInfo &player, Command &activeCommands)
 		isStranded |= (flagship && it == flagship->GetTargetShip() && CanBoard(*flagship, *it)
 			&& autoPilot.Has(Command::BOARD));
 		
-		Command command;
-		if(it->IsYours())
-		{
-			if(it->HasBays() && thisIsLaunching)
-			{
-				// If this is a carrier, launch whichever of its fighters are at
-				// good enough health to survive a fight.
-				command |= Command::DEPLOY;
-				Deploy(*it, !fightersRetreat);
-			}
-			if(isCloaking)
-				command |= Command::CLOAK;
-		}
-		// Cloak if the AI considers it appropriate.
-		else if(DoCloak(*it, command))
+		steps.emplace_back(it, Mix(stepSeed + index));
+		ShipStep &next = steps.back();
+		next.healthRemaining = healthRemaining;
+		next.isPresent = isPresent;
+		next.isStranded = isStranded;
+		next.thisIsLaunching = thisIsLaunching;
+		next.opportunistic = (it->IsYours() ? opportunisticEscorts : personality.IsOpportunistic());
+		// Each ship only switches targets twice a second, so that it can
+		// focus on damaging one particular ship.
+		if(isPresent && !personality.IsSwarming())
 		{
-			// The ship chose to retreat from its target, e.g. to repair.
-			it->SetCommands(command);
-			continue;
+			targetTurn = (targetTurn + 1) & 31;
+			next.isTargetTurn = (targetTurn == step);
 		}
-		
-		shared_ptr<Ship> parent = it->GetParent();
-		if(parent && parent->IsDestroyed())
+		// Appeasing ships keep track of how damaged they were when they last
+		// jettisoned cargo. Make sure there is a place for that already.
+		if(personality.IsAppeasing())
+			appeasmentThreshold[it.get()];
+	}
+	// Check if the ships that were recruited to assist another ship can still
+	// do so. This depends on the other ship's plans, so it must be done before
+	// any ship has made new ones.
+	for(ShipStep &next : steps)
+	{
+		const Ship &ship = *next.ship;
+		shared_ptr<const Ship> shipToAssist = ship.GetShipToAssist();
+		next.canAssist = shipToAssist && !shipToAssist->IsDestroyed() && shipToAssist->GetSystem() == ship.GetSystem()
+			&& !shipToAssist->IsLanding() && !shipToAssist->IsHyperspacing()
+			&& !shipToAssist->GetGovernment()->IsEnemy(ship.GetGovernment())
+			&& (shipToAssist->IsDisabled() || !shipToAssist->JumpsRemaining());
+	}
+	
+	// What a ship decides to do depends on what the other ships in its fleet are
+	// doing, but not on the plans of any other ships. So, the fleets are spread
+	// over all the available threads, with the ships in each fleet taking turns
+	// in their usual order. A fleet stops at the first ship that may need to
+	// look beyond its fleet, and the rest of those ships go one at a time after
+	// all the fleets are done.
+	map<const Ship *, const Ship *> leaders;
+	map<const Ship *, size_t> fleetIndex;
+	vector<vector<size_t>> fleets;
+	for(size_t i = 0; i < steps.size(); ++i)
+	{
+		auto fit = fleetIndex.emplace(FleetLeader(*steps[i].ship, flagship, leaders), fleets.size());
+		if(fit.second)
+			fleets.emplace_back();
+		fleets[fit.first->second].push_back(i);
+	}
+	vector<size_t> stopped(fleets.size());
+	workers.ForEach(fleets.size(), [this, &player, &steps, &fleets, &stopped, flagship, canMine, fightersRetreat](size_t i) -> void
+	{
+		const vector<size_t> &fleet = fleets[i];
+		size_t &position = stopped[i];
+		for(position = 0; position < fleet.size(); ++position)
 		{
-			// An NPC that loses its fleet leader should attempt to
-			// follow that leader's parent. For most mission NPCs,
-			// this is the player. Any regular NPCs and mission NPCs
-			// with "personality uninterested" become independent.
-			parent = parent->GetParent();
-			it->SetParent(parent);
+			ShipStep &next = steps[fleet[position]];
+			if(AffectsOtherFleets(*next.ship, next.isPresent, canMine, flagship))
+				break;
+			MoveShip(next, player, fightersRetreat);
 		}
-		
-		// Pick a target and automatically fire weapons.
-		shared_ptr<Ship> target = it->GetTargetShip();
-		if(isPresent && !personality.IsSwarming())
+	});
+	vector<size_t> remaining;
+	for(size_t i = 0; i < fleets.size(); ++i)
+		remaining.insert(remaining.end(), fleets[i].begin() + stopped[i], fleets[i].end());
+	sort(remaining.begin(), remaining.end());
+	for(size_t i : remaining)
+		MoveShip(steps[i], player, fightersRetreat);
+	
+	// Finally, carry out the decisions that affect the other ships.
+	for(ShipStep &next : steps)
+	{
+		// Allow another swarming ship to consider the target this ship left.
+		if(next.swarmLeft)
 		{
-			// Each ship only switches targets twice a second, so that it can
-			// focus on damaging one particular ship.
-			targetTurn = (targetTurn + 1) & 31;
-			if(targetTurn == step || !target || target->IsDestroyed() || (target->IsDisabled()
-					&& personality.Disables()) || !target->IsTargetable())
-				it->SetTargetShip(FindTarget(*it));
+			auto sit = swarmCount.find(next.swarmLeft);
+			if(sit != swarmCount.end() && sit->second > 0)
+				--sit->second;
 		}
-		if(isPresent)
+		if(next.swarmJoined)
+			++swarmCount[next.swarmJoined];
+		for(const auto &cargo : next.jettison)
+			next.ship->Jettison(cargo.first, cargo.second, true);
+		if(!next.message.empty())
+			Messages::Add(next.message, Messages::Importance::High);
+	}
+}
+
+
+
+// Decide what the given ship should do in this step, and set its commands.
+void AI::MoveShip(ShipStep &shipStep, const PlayerInfo &player, bool fightersRetreat)
+{
+	const shared_ptr<Ship> &it = shipStep.ship;
+	const System *playerSystem = player.GetSystem();
+	const Government *gov = it->GetGovernment();
+	const Personality &personality = it->GetPersonality();
+	const double healthRemaining = shipStep.healthRemaining;
+	const bool isPresent = shipStep.isPresent;
+	const bool isStranded = shipStep.isStranded;
+	const bool thisIsLaunching = shipStep.thisIsLaunching;
+	const int maxMinerCount = minables.empty() ? 0 : 9;
+	
+	Command command;
+	if(it->IsYours())
+	{
+		if(it->HasBays() && thisIsLaunching)
 		{
-			AimTurrets(*it, command, it->IsYours() ? opportunisticEscorts : personality.IsOpportunistic());
-			AutoFire(*it, command);
+			// If this is a carrier, launch whichever of its fighters are at
+			// good enough health to survive a fight.
+			command |= Command::DEPLOY;
+			Deploy(*it, !fightersRetreat);
 		}
-		
-		// If this ship is hyperspacing, or in the act of
-		// launching or landing, it can't do anything else.
-		if(it->IsHyperspacing() || it->Zoom() < 1.)
+		if(isCloaking)
+			command |= Command::CLOAK;
+	}
+	// Cloak if the AI considers it appropriate.
+	else if(DoCloak(*it, command))
+	{
+		// The ship chose to retreat from its target, e.g. to repair.
+		it->SetCommands(command);
+		return;
+	}
+	
+	shared_ptr<Ship> parent = it->GetParent();
+	if(parent && parent->IsDestroyed())
+	{
+		// An NPC that loses its fleet leader should attempt to
+		// follow that leader's parent. For most mission NPCs,
+		// this is the player. Any regular NPCs and mission NPCs
+		// with "personality uninterested" become independent.
+		parent = parent->GetParent();
+		it->SetParent(parent);
+	}
+	
+	// Pick a target and automatically fire weapons.
+	shared_ptr<Ship> target = it->GetTargetShip();
+	if(isPresent && !personality.IsSwarming())
+	{
+		if(shipStep.isTargetTurn || !target || target->IsDestroyed() || (target->IsDisabled()
+				&& personality.Disables()) || !target->IsTargetable())
+			it->SetTargetShip(FindTarget(*it));
+	}
+	if(isPresent)
+	{
+		AimTurrets(*it, command, shipStep.opportunistic, shipStep.random);
+		AutoFire(*it, command);
+	}
+	
+	// If this ship is hyperspacing, or in the act of
+	// launching or landing, it can't do anything else.
+	if(it->IsHyperspacing() || it->Zoom() < 1.)
+	{
+		it->SetCommands(command);
+		return;
+	}
+	
+	// Special actions when a ship is heavily damaged:
+	if(healthRemaining < RETREAT_HEALTH + .1)
+	{
+		// Cowards abandon their fleets.
+		if(parent && personality.IsCoward())
 		{
-			it->SetCommands(command);
-			continue;
+			parent.reset();
+			it->SetParent(parent);
 		}
-		
-		// Special actions when a ship is heavily damaged:
-		if(healthRemaining < RETREAT_HEALTH + .1)
+		// Appeasing ships jettison cargo to distract their pursuers.
+		if(personality.IsAppeasing() && it->Cargo().Used())
 		{
-			// Cowards abandon their fleets.
-			if(parent && personality.IsCoward())
-			{
-				parent.reset();
-				it->SetParent(parent);
-			}
-			// Appeasing ships jettison cargo to distract their pursuers.
-			if(personality.IsAppeasing() && it->Cargo().Used())
+			double health = .5 * it->Shields() + it->Hull();
+			double &threshold = appeasmentThreshold.at(it.get());
+			if(1. - health > threshold)
 			{
-				double health = .5 * it->Shields() + it->Hull();
-				double &threshold = appeasmentThreshold[it.get()];
-				if(1. - health > threshold)
-				{
-					int toDump = 11 + (1. - health) * .5 * it->Cargo().Size();
-					for(const auto &commodity : it->Cargo().Commodities())
-						if(commodity.second && toDump > 0)
-						{
-							int dumped = min(commodity.second, toDump);
-							it->Jettison(commodity.first, dumped, true);
-							toDump -= dumped;
-						}
-					Messages::Add(gov->Name() + " " + it->Noun() + " \"" + it->Name()
-						+ "\": Please, just take my cargo and leave me alone.", Messages::Importance::High);
-					threshold = (1. - health) + .1;
-				}
+				// The cargo is dumped once all ships have decided what to do,
+				// because dumping it changes how fast this ship can move.
+				int toDump = 11 + (1. - health) * .5 * it->Cargo().Size();
+				for(const auto &commodity : it->Cargo().Commodities())
+					if(commodity.second && toDump > 0)
+					{
+						int dumped = min(commodity.second, toDump);
+						shipStep.jettison.emplace_back(commodity.first, dumped);
+						toDump -= dumped;
+					}
+				shipStep.message = gov->Name() + " " + it->Noun() + " \"" + it->Name()
+					+ "\": Please, just take my cargo and leave me alone.";
+				threshold = (1. - health) + .1;
 			}
 		}
-		
-		// If recruited to assist a ship, follow through on the commitment
-		// instead of ignoring it due to other personality traits.
-		shared_ptr<Ship> shipToAssist = it->GetShipToAssist();
-		if(shipToAssist)
+	}
+	
+	// If recruited to assist a ship, follow through on the commitment
+	// instead of ignoring it due to other personality traits.
+	shared_ptr<Ship> shipToAssist = it->GetShipToAssist();
+	if(shipToAssist)
+	{
+		if(!shipStep.canAssist)
 		{
-			if(shipToAssist->IsDestroyed() || shipToAssist->GetSystem() != it->GetSystem()
-					|| shipToAssist->IsLanding() || shipToAssist->IsHyperspacing()
-					|| shipToAssist->GetGovernment()->IsEnemy(gov)
-					|| (!shipToAssist->IsDisabled() && shipToAssist->JumpsRemaining()))
-			{
-				shipToAssist.reset();
-				it->SetShipToAssist(shipToAssist);
-			}
-			else if(!it->IsBoarding())
-			{
-				MoveTo(*it, command, shipToAssist->Position(), shipToAssist->Velocity(), 40., .8);
-				command |= Command::BOARD;
-			}
-			
-			if(shipToAssist)
-			{
-				it->SetTargetShip(shipToAssist);
-				it->SetCommands(command);
-				continue;
-			}
+			shipToAssist.reset();
+			it->SetShipToAssist(shipToAssist);
 		}
-		
-		// This ship may have updated its target ship.
-		double targetDistance = numeric_limits<double>::infinity();
-		target = it->GetTargetShip();
-		if(target)
-			targetDistance = target->Position().Distance(it->Position());
-		
-		// Behave in accordance with personality traits.
-		if(isPresent && personality.IsSwarming() && !isStranded)
+		else if(!it->IsBoarding())
 		{
-			// Swarming ships should not wait for (or be waited for by) any ship.
-			if(parent)
-			{
-				parent.reset();
-				it->SetParent(parent);
-			}
-			// Flock between allied, in-system ships.
-			DoSwarming(*it, command, target);
-			it->SetCommands(command);
-			continue;
+			MoveTo(*it, command, shipToAssist->Position(), shipToAssist->Velocity(), 40., .8);
+			command |= Command::BOARD;
 		}
 		
-		// Surveillance NPCs with enforcement authority (or those from
-		// missions) should perform scans and surveys of the system.
-		if(isPresent && personality.IsSurveillance() && !isStranded
-				&& (scanPermissions[gov] || it->IsSpecial()))
+		if(shipToAssist)
 		{
-			DoSurveillance(*it, command, target);
+			it->SetTargetShip(shipToAssist);
 			it->SetCommands(command);
-			continue;
+			return;
 		}
-		
-		// Ships that harvest flotsam prioritize it over stopping to be refueled.
-		if(isPresent && personality.Harvests() && DoHarvesting(*it, command))
+	}
+	
+	// This ship may have updated its target ship.
+	double targetDistance = numeric_limits<double>::infinity();
+	target = it->GetTargetShip();
+	if(target)
+		targetDistance = target->Position().Distance(it->Position());
+	
+	// Behave in accordance with personality traits.
+	if(isPresent && personality.IsSwarming() && !isStranded)
+	{
+		// Swarming ships should not wait for (or be waited for by) any ship.
+		if(parent)
 		{
-			it->SetCommands(command);
-			continue;
+			parent.reset();
+			it->SetParent(parent);
 		}
-		
-		// Attacking a hostile ship and stopping to be refueled are more important than mining.
-		if(isPresent && personality.IsMining() && !target && !isStranded && maxMinerCount)
+		// Flock between allied, in-system ships.
+		DoSwarming(shipStep, command, target);
+		it->SetCommands(command);
+		return;
+	}
+	
+	// Surveillance NPCs with enforcement authority (or those from
+	// missions) should perform scans and surveys of the system.
+	if(isPresent && personality.IsSurveillance() && !isStranded
+			&& (scanPermissions.at(gov) || it->IsSpecial()))
+	{
+		DoSurveillance(*it, command, target, shipStep.random);
+		it->SetCommands(command);
+		return;
+	}
+	
+	// Ships that harvest flotsam prioritize it over stopping to be refueled.
+	if(isPresent && personality.Harvests() && DoHarvesting(*it, command, shipStep.random))
+	{
+		it->SetCommands(command);
+		return;
+	}
+	
+	// Attacking a hostile ship and stopping to be refueled are more important than mining.
+	if(isPresent && personality.IsMining() && !target && !isStranded && maxMinerCount)
+	{
+		// Miners with free cargo space and available mining time should mine. Mission NPCs
+		// should mine even if there are other miners or they have been mining a while.
+		if(it->Cargo().Free() >= 5 && IsArmed(*it) && (it->IsSpecial()
+				|| (++miningTime[&*it] < 3600 && ++minerCount < maxMinerCount)))
 		{
-			// Miners with free cargo space and available mining time should mine. Mission NPCs
-			// should mine even if there are other miners or they have been mining a while.
-			if(it->Cargo().Free() >= 5 && IsArmed(*it) && (it->IsSpecial()
-					|| (++miningTime[&*it] < 3600 && ++minerCount < maxMinerCount)))
-			{
-				if(it->HasBays())
-				{
-					command |= Command::DEPLOY;
-					Deploy(*it, false);
-				}
-				DoMining(*it, command);
-				it->SetCommands(command);
-				continue;
-			}
-			// Fighters and drones should assist their parent's mining operation if they cannot
-			// carry ore, and the asteroid is near enough that the parent can harvest the ore.
-			const shared_ptr<Minable> &minable = parent ? parent->GetTargetAsteroid() : nullptr;
-			if(it->CanBeCarried() && parent && miningTime[&*parent] < 3601 && minable
-					&& minable->Position().Distance(parent->Position()) < 600.)
+			if(it->HasBays())
 			{
-				it->SetTargetAsteroid(minable);
-				MoveToAttack(*it, command, *minable);
-				AutoFire(*it, command, *minable);
-				it->SetCommands(command);
-				continue;
+				command |= Command::DEPLOY;
+				Deploy(*it, false);
 			}
-			else
-				it->SetTargetAsteroid(nullptr);
+			DoMining(*it, command);
+			it->SetCommands(command);
+			return;
 		}
-		
-		// Handle carried ships:
-		if(it->CanBeCarried())
+		// Fighters and drones should assist their parent's mining operation if they cannot
+		// carry ore, and the asteroid is near enough that the parent can harvest the ore.
+		const shared_ptr<Minable> &minable = parent ? parent->GetTargetAsteroid() : nullptr;
+		if(it->CanBeCarried() && parent && miningTime[&*parent] < 3601 && minable
+				&& minable->Position().Distance(parent->Position()) < 600.)
+		{
+			it->SetTargetAsteroid(minable);
+			MoveToAttack(*it, command, *minable);
+			AutoFire(*it, command, *minable);
+			it->SetCommands(command);
+			return;
+		}
+		else
+			it->SetTargetAsteroid(nullptr);
+	}
+	
+	// Handle carried ships:
+	if(it->CanBeCarried())
+	{
+		// A carried ship must belong to the same government as its parent to dock with it.
+		bool hasParent = parent && !parent->IsDestroyed() && parent->GetGovernment() == gov;
+		bool inParentSystem = hasParent && parent->GetSystem() == it->GetSystem();
+		bool parentHasSpace = inParentSystem && parent->BaysFree(it->Attributes().Category());
+		if(!hasParent || (!inParentSystem && !it->JumpFuel()) || (!parentHasSpace && !shipStep.random.Int(1800)))
 		{
-			// A carried ship must belong to the same government as its parent to dock with it.
-			bool hasParent = parent && !parent->IsDestroyed() && parent->GetGovernment() == gov;
-			bool inParentSystem = hasParent && parent->GetSystem() == it->GetSystem();
-			bool parentHasSpace = inParentSystem && parent->BaysFree(it->Attributes().Category());
-			if(!hasParent || (!inParentSystem && !it->JumpFuel()) || (!parentHasSpace && !Random::Int(1800)))
+			// Find the possible parents for orphaned fighters and drones.
+			auto parentChoices = vector<shared_ptr<Ship>>{};
+			parentChoices.reserve(ships.size() * .1);
+			auto getParentFrom = [&it, &gov, &parentChoices](const list<shared_ptr<Ship>> otherShips) -> shared_ptr<Ship>
 			{
-				// Find the possible parents for orphaned fighters and drones.
-				auto parentChoices = vector<shared_ptr<Ship>>{};
-				parentChoices.reserve(ships.size() * .1);
-				auto getParentFrom = [&it, &gov, &parentChoices](const list<shared_ptr<Ship>> otherShips) -> shared_ptr<Ship>
-				{
-					for(const auto &other : otherShips)
-						if(other->GetGovernment() == gov && other->GetSystem() == it->GetSystem() && !other->CanBeCarried())
-						{
-							if(!other->IsDisabled() && other->CanCarry(*it.get()))
-								return other;
-							else
-								parentChoices.emplace_back(other);
-						}
-					return shared_ptr<Ship>();
-				};
-				// Mission ships should only pick amongst ships from the same mission.
-				auto missionIt = it->IsSpecial() && !it->IsYours()
-					? find_if(player.Missions().begin(), player.Missions().end(),
-						[&it](const Mission &m) { return m.HasShip(it); })
-					: player.Missions().end();
-				
-				shared_ptr<Ship> newParent;
-				if(missionIt != player.Missions().end())
-				{
-					auto &npcs = missionIt->NPCs();
-					for(const auto &npc : npcs)
+				for(const auto &other : otherShips)
+					if(other->GetGovernment() == gov && other->GetSystem() == it->GetSystem() && !other->CanBeCarried())
 					{
-						// Don't reparent to NPC ships that have not been spawned.
-						if(!npc.ShouldSpawn())
-							continue;
-						newParent = getParentFrom(npc.Ships());
-						if(newParent)
-							break;
+						if(!other->IsDisabled() && other->CanCarry(*it.get()))
+							return other;
+						else
+							parentChoices.emplace_back(other);
 					}
-				}
-				else
-					newParent = getParentFrom(ships);
-				
-				// If a new parent was found, then this carried ship should always reparent
-				// as a ship of its own government is in-system and has space to carry it.
-				if(newParent)
-					parent = newParent;
-				// Otherwise, if one or more in-system ships of the same government were found,
-				// this carried ship should flock with one of them, even if they can't carry it.
-				else if(!parentChoices.empty())
-					parent = parentChoices[Random::Int(parentChoices.size())];
-				// Player-owned carriables that can't be carried and have no ships to flock with
-				// should keep their current parent, or if it is destroyed, their parent's parent.
-				else if(it->IsYours())
+				return shared_ptr<Ship>();
+			};
+			// Mission ships should only pick amongst ships from the same mission.
+			auto missionIt = it->IsSpecial() && !it->IsYours()
+				? find_if(player.Missions().begin(), player.Missions().end(),
+					[&it](const Mission &m) { return m.HasShip(it); })
+				: player.Missions().end();
+			
+			shared_ptr<Ship> newParent;
+			if(missionIt != player.Missions().end())
+			{
+				auto &npcs = missionIt->NPCs();
+				for(const auto &npc : npcs)
 				{
-					if(parent && parent->IsDestroyed())
-						parent = parent->GetParent();
+					// Don't reparent to NPC ships that have not been spawned.
+					if(!npc.ShouldSpawn())
+						continue;
+					newParent = getParentFrom(npc.Ships());
+					if(newParent)
+						break;
 				}
-				// All remaining non-player ships should forget their previous parent entirely.
-				else
-					parent.reset();
-				
-				it->SetParent(parent);
-			}
-			// Otherwise, check if this ship wants to return to its parent (e.g. to repair).
-			else if(parentHasSpace && ShouldDock(*it, *parent, playerSystem))
-			{
-				it->SetTargetShip(parent);
-				MoveTo(*it, command, parent->Position(), parent->Velocity(), 40., .8);
-				command |= Command::BOARD;
-				it->SetCommands(command);
-				continue;
 			}
-			// If we get here, it means that the ship has not decided to return
-			// to its mothership. So, it should continue to be deployed.
-			command |= Command::DEPLOY;
-		}
-		// If this ship has decided to recall all of its fighters because combat has ceased,
-		// it comes to a stop to facilitate their reboarding process.
-		bool mustRecall = false;
-		if(!target && it->HasBays() && !(it->IsYours() ?
-				thisIsLaunching : it->Commands().Has(Command::DEPLOY)))
-			for(const weak_ptr<Ship> &ptr : it->GetEscorts())
+			else
+				newParent = getParentFrom(ships);
+			
+			// If a new parent was found, then this carried ship should always reparent
+			// as a ship of its own government is in-system and has space to carry it.
+			if(newParent)
+				parent = newParent;
+			// Otherwise, if one or more in-system ships of the same government were found,
+			// this carried ship should flock with one of them, even if they can't carry it.
+			else if(!parentChoices.empty())
+				parent = parentChoices[shipStep.random.Int(parentChoices.size())];
+			// Player-owned carriables that can't be carried and have no ships to flock with
+			// should keep their current parent, or if it is destroyed, their parent's parent.
+			else if(it->IsYours())
 			{
-				shared_ptr<const Ship> escort = ptr.lock();
-				// Note: HasDeployOrder is always `false` for NPC ships, as it is solely used for player ships.
-				if(escort && escort->CanBeCarried() && !escort->HasDeployOrder() && escort->GetSystem() == it->GetSystem()
-						&& !escort->IsDisabled() && it->BaysFree(escort->Attributes().Category()))
-				{
-					mustRecall = true;
-					break;
-				}
+				if(parent && parent->IsDestroyed())
+					parent = parent->GetParent();
 			}
-		
-		// Construct movement / navigation commands as appropriate for the ship.
-		if(mustRecall || isStranded)
-		{
-			// Stopping to let fighters board or to be refueled takes priority
-			// even over following orders from the player.
-			if(it->Velocity().Length() > .001 || !target)
-				Stop(*it, command);
+			// All remaining non-player ships should forget their previous parent entirely.
 			else
-				command.SetTurn(TurnToward(*it, TargetAim(*it)));
-		}
-		else if(FollowOrders(*it, command))
-		{
-			// If this is an escort and it followed orders, its only final task
-			// is to convert completed MOVE_TO orders into HOLD_POSITION orders.
-			UpdateOrders(*it);
+				parent.reset();
+			
+			it->SetParent(parent);
 		}
-		// Hostile "escorts" (i.e. NPCs that are trailing you) only revert to
-		// escort behavior when in a different system from you. Otherwise,
-		// the behavior depends on what the parent is doing, whether there
-		// are hostile targets nearby, and whether the escort has any
-		// immediate needs (like refueling).
-		else if(!parent)
-			MoveIndependent(*it, command);
-		else if(parent->GetSystem() != it->GetSystem())
+		// Otherwise, check if this ship wants to return to its parent (e.g. to repair).
+		else if(parentHasSpace && ShouldDock(*it, *parent, playerSystem))
 		{
-			if(personality.IsStaying() || !it->Attributes().Get("fuel capacity"))
-				MoveIndependent(*it, command);
-			else
-				MoveEscort(*it, command);
-		}
-		// From here down, we're only dealing with ships that have a "parent"
-		// which is in the same system as them.
-		else if(parent->GetGovernment()->IsEnemy(gov))
-		{
-			// Fight your target, if you have one.
-			if(target)
-				MoveIndependent(*it, command);
-			// Otherwise try to find and fight your parent. If your parent
-			// can't be both targeted and pursued, then don't follow them.
-			else if(parent->IsTargetable() && CanPursue(*it, *parent))
-				MoveEscort(*it, command);
-			else
-				MoveIndependent(*it, command);
+			it->SetTargetShip(parent);
+			MoveTo(*it, command, parent->Position(), parent->Velocity(), 40., .8);
+			command |= Command::BOARD;
+			it->SetCommands(command);
+			return;
 		}
-		else if(parent->IsDisabled() && !it->CanBeCarried())
+		// If we get here, it means that the ship has not decided to return
+		// to its mothership. So, it should continue to be deployed.
+		command |= Command::DEPLOY;
+	}
+	// If this ship has decided to recall all of its fighters because combat has ceased,
+	// it comes to a stop to facilitate their reboarding process.
+	bool mustRecall = false;
+	if(!target && it->HasBays() && !(it->IsYours() ?
+			thisIsLaunching : it->Commands().Has(Command::DEPLOY)))
+		for(const weak_ptr<Ship> &ptr : it->GetEscorts())
 		{
-			// Your parent is disabled, and is in this system. If you have enemy
-			// targets present, fight them. Otherwise, repair your parent.
-			if(target)
-				MoveIndependent(*it, command);
-			else if(!parent->GetPersonality().IsDerelict())
-				it->SetShipToAssist(parent);
-			else
-				CircleAround(*it, command, *parent);
+			shared_ptr<const Ship> escort = ptr.lock();
+			// Note: HasDeployOrder is always `false` for NPC ships, as it is solely used for player ships.
+			if(escort && escort->CanBeCarried() && !escort->HasDeployOrder() && escort->GetSystem() == it->GetSystem()
+					&& !escort->IsDisabled() && it->BaysFree(escort->Attributes().Category()))
+			{
+				mustRecall = true;
+				break;
+			}
 		}
-		else if(personality.IsStaying())
-			MoveIndependent(*it, command);
-		// This is a friendly escort. If the parent is getting ready to
-		// jump, always follow.
-		else if(parent->Commands().Has(Command::JUMP) && it->JumpsRemaining())
+	
+	// Construct movement / navigation commands as appropriate for the ship.
+	if(mustRecall || isStranded)
+	{
+		// Stopping to let fighters board or to be refueled takes priority
+		// even over following orders from the player.
+		if(it->Velocity().Length() > .001 || !target)
+			Stop(*it, command);
+		else
+			command.SetTurn(TurnToward(*it, TargetAim(*it)));
+	}
+	else if(FollowOrders(*it, command, shipStep.random))
+	{
+		// If this is an escort and it followed orders, its only final task
+		// is to convert completed MOVE_TO orders into HOLD_POSITION orders.
+		UpdateOrders(*it);
+	}
+	// Hostile "escorts" (i.e. NPCs that are trailing you) only revert to
+	// escort behavior when in a different system from you. Otherwise,
+	// the behavior depends on what the parent is doing, whether there
+	// are hostile targets nearby, and whether the escort has any
+	// immediate needs (like refueling).
+	else if(!parent)
+		MoveIndependent(*it, command, shipStep.random);
+	else if(parent->GetSystem() != it->GetSystem())
+	{
+		if(personality.IsStaying() || !it->Attributes().Get(Attribute::FUEL_CAPACITY))
+			MoveIndependent(*it, command, shipStep.random);
+		else
 			MoveEscort(*it, command);
-		// Timid ships always stay near their parent. Injured player
-		// escorts will stay nearby until they have repaired a bit.
-		else if((personality.IsTimid() || (it->IsYours() && healthRemaining < RETREAT_HEALTH))
-				&& parent->Position().Distance(it->Position()) > 500.)
+	}
+	// From here down, we're only dealing with ships that have a "parent"
+	// which is in the same system as them.
+	else if(parent->GetGovernment()->IsEnemy(gov))
+	{
+		// Fight your target, if you have one.
+		if(target)
+			MoveIndependent(*it, command, shipStep.random);
+		// Otherwise try to find and fight your parent. If your parent
+		// can't be both targeted and pursued, then don't follow them.
+		else if(parent->IsTargetable() && CanPursue(*it, *parent))
 			MoveEscort(*it, command);
-		// Otherwise, attack targets depending on how heroic you are.
-		else if(target && (targetDistance < 2000. || personality.IsHeroic()))
-			MoveIndependent(*it, command);
-		// This ship does not feel like fighting.
 		else
-			MoveEscort(*it, command);
-		
-		// Force ships that are overlapping each other to "scatter":
-		DoScatter(*it, command);
-		
-		it->SetCommands(command);
+			MoveIndependent(*it, command, shipStep.random);
+	}
+	else if(parent->IsDisabled() && !it->CanBeCarried())
+	{
+		// Your parent is disabled, and is in this system. If you have enemy
+		// targets present, fight them. Otherwise, repair your parent.
+		if(target)
+			MoveIndependent(*it, command, shipStep.random);
+		else if(!parent->GetPersonality().IsDerelict())
+			it->SetShipToAssist(parent);
+		else
+			CircleAround(*it, command, *parent);
 	}
+	else if(personality.IsStaying())
+		MoveIndependent(*it, command, shipStep.random);
+	// This is a friendly escort. If the parent is getting ready to
+	// jump, always follow.
+	else if(parent->Commands().Has(Command::JUMP) && it->JumpsRemaining())
+		MoveEscort(*it, command);
+	// Timid ships always stay near their parent. Injured player
+	// escorts will stay nearby until they have repaired a bit.
+	else if((personality.IsTimid() || (it->IsYours() && healthRemaining < RETREAT_HEALTH))
+			&& parent->Position().Distance(it->Position()) > 500.)
+		MoveEscort(*it, command);
+	// Otherwise, attack targets depending on how heroic you are.
+	else if(target && (targetDistance < 2000. || personality.IsHeroic()))
+		MoveIndependent(*it, command, shipStep.random);
+	// This ship does not feel like fighting.
+	else
+		MoveEscort(*it, command);
+	
+	// Force ships that are overlapping each other to "scatter":
+	DoScatter(*it, command);
+	
+	it->SetCommands(command);
 }
 
 
@@ -1153,8 +1395,14 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 	if(!person.IsHeroic() && strengthIt != shipStrength.end())
 		maxStrength = 2 * strengthIt->second;
 	
-	// Get a list of all targetable, hostile ships in this system.
-	const auto enemies = GetShipsList(ship, true);
+	// Get a list of all targetable, hostile ships in this system that are close
+	// enough that they could end up being the closest target, even after the
+	// preferences below are taken into account. Nemesis ships prefer some
+	// targets no matter how far away they are, so they must check all ships.
+	double searchRange = -1.;
+	if(!person.IsNemesis() && closest < numeric_limits<double>::infinity())
+		searchRange = closest + TARGET_RANGE_BONUS + 60. * (ship.Velocity().Length() + maxShipSpeed);
+	const auto enemies = GetShipsList(ship, true, searchRange);
 	for(const auto &foe : enemies)
 	{
 		// If this is a "nemesis" ship and it has found one of the player's
@@ -1216,8 +1464,8 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 	// mission NPCs) should consider friendly targets for surveillance.
 	if(!isYours && !target && (ship.IsSpecial() || scanPermissions.at(gov)))
 	{
-		bool cargoScan = ship.Attributes().Get("cargo scan power");
-		bool outfitScan = ship.Attributes().Get("outfit scan power");
+		bool cargoScan = ship.Attributes().Get(Attribute::CARGO_SCAN_POWER);
+		bool outfitScan = ship.Attributes().Get(Attribute::OUTFIT_SCAN_POWER);
 		if(cargoScan || outfitScan)
 		{
 			closest = numeric_limits<double>::infinity();
@@ -1249,7 +1497,7 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 	{
 		// Make sure the ship has somewhere to flee to.
 		const System *system = ship.GetSystem();
-		if(ship.JumpsRemaining() && (!system->Links().empty() || ship.Attributes().Get("jump drive")))
+		if(ship.JumpsRemaining() && (!system->Links().empty() || ship.Attributes().Get(Attribute::JUMP_DRIVE)))
 			target.reset();
 		else
 			for(const StellarObject &object : system->Objects())
@@ -1285,31 +1533,47 @@ vector<shared_ptr<Ship>> AI::GetShipsList(const Ship &ship, bool targetEnemies,
 	
 	auto targets = vector<shared_ptr<Ship>>();
 	
-	// The cached lists are built each step based on the current ships in the player's system.
-	const auto &rosters = targetEnemies ? enemyLists : allyLists;
+	// The relations are cached each step based on the current ships in the player's system.
+	const auto it = rosterIndex.find(ship.GetGovernment());
+	if(it == rosterIndex.end())
+		return targets;
 	
-	const auto it = rosters.find(ship.GetGovernment());
-	if(it != rosters.end() && !it->second.empty())
+	const System *here = ship.GetSystem();
+	const Point &p = ship.Position();
+	auto check = [&](const shared_ptr<Ship> &target) -> void
 	{
-		targets.reserve(it->second.size());
-		
-		const System *here = ship.GetSystem();
-		const Point &p = ship.Position();
-		for(const auto &target : it->second)
-			if(target->IsTargetable() && target->GetSystem() == here
-					&& !(target->IsHyperspacing() && target->Velocity().Length() > 10.)
-					&& p.Distance(target->Position()) < maxRange
-					&& (ship.IsYours() || !target->GetPersonality().IsMarked())
-					&& (target->IsYours() || !ship.GetPersonality().IsMarked()))
-				targets.emplace_back(target);
+		if(target->IsTargetable() && target->GetSystem() == here
+				&& !(target->IsHyperspacing() && target->Velocity().Length() > 10.)
+				&& p.Distance(target->Position()) < maxRange
+				&& (ship.IsYours() || !target->GetPersonality().IsMarked())
+				&& (target->IsYours() || !ship.GetPersonality().IsMarked()))
+			targets.emplace_back(target);
+	};
+	const auto enemies = isEnemy.begin() + it->second * governmentRosters.size();
+	
+	// If the range covers fewer cells than the grid has, only check the ships
+	// in those cells. Otherwise, check all the rosters of the right governments.
+	// Either way, the ships are found in the same order.
+	if(shipGrid.IsWorthSearching(maxRange))
+	{
+		for(const ShipGrid::Entry *entry : shipGrid.Find(p, maxRange))
+			if(enemies[entry->roster] == targetEnemies)
+				check(*entry->ship);
+		return targets;
 	}
 	
+	auto enemy = enemies;
+	for(const auto &roster : governmentRosters)
+		if(*enemy++ == targetEnemies)
+			for(const auto &target : roster.second)
+				check(target);
+	
 	return targets;
 }
 
 
 
-bool AI::FollowOrders(Ship &ship, Command &command) const
+bool AI::FollowOrders(Ship &ship, Command &command, ShipRandom &random) const
 {
 	auto it = orders.find(&ship);
 	if(it == orders.end())
@@ -1338,7 +1602,7 @@ bool AI::FollowOrders(Ship &ship, Command &command) const
 		
 		// Travel there even if your parent is not planning to travel.
 		if(ship.GetTargetSystem())
-			MoveIndependent(ship, command);
+			MoveIndependent(ship, command, random);
 		else
 			return false;
 	}
@@ -1362,14 +1626,14 @@ bool AI::FollowOrders(Ship &ship, Command &command) const
 	else if(type == Orders::GATHER)
 		CircleAround(ship, command, *target);
 	else
-		MoveIndependent(ship, command);
+		MoveIndependent(ship, command, random);
 	
 	return true;
 }
 
 
 
-void AI::MoveIndependent(Ship &ship, Command &command) const
+void AI::MoveIndependent(Ship &ship, Command &command, ShipRandom &random) const
 {
 	shared_ptr<const Ship> target = ship.GetTargetShip();
 	// NPCs should not be beyond the "fence" unless their target is
@@ -1421,8 +1685,8 @@ void AI::MoveIndependent(Ship &ship, Command &command) const
 	else if(target)
 	{
 		// An AI ship that is targeting a non-hostile ship should scan it, or move on.
-		bool cargoScan = ship.Attributes().Get("cargo scan power");
-		bool outfitScan = ship.Attributes().Get("outfit scan power");
+		bool cargoScan = ship.Attributes().Get(Attribute::CARGO_SCAN_POWER);
+		bool outfitScan = ship.Attributes().Get(Attribute::OUTFIT_SCAN_POWER);
 		if((!cargoScan || Has(gov, target, ShipEvent::SCAN_CARGO))
 				&& (!outfitScan || Has(gov, target, ShipEvent::SCAN_OUTFITS)))
 			target.reset();
@@ -1450,7 +1714,7 @@ void AI::MoveIndependent(Ship &ship, Command &command) const
 		
 		vector<int> systemWeights;
 		int totalWeight = 0;
-		const set<const System *> &links = ship.Attributes().Get("jump drive")
+		const set<const System *> &links = ship.Attributes().Get(Attribute::JUMP_DRIVE)
 			? origin->JumpNeighbors(ship.JumpRange()) : origin->Links();
 		if(jumps)
 		{
@@ -1497,7 +1761,7 @@ void AI::MoveIndependent(Ship &ship, Command &command) const
 		}
 		
 		set<const System *>::const_iterator it = links.begin();
-		int choice = Random::Int(totalWeight);
+		int choice = random.Int(totalWeight);
 		if(choice < systemTotalWeight)
 		{
 			for(unsigned i = 0; i < systemWeights.size(); ++i, ++it)
@@ -1535,7 +1799,7 @@ void AI::MoveIndependent(Ship &ship, Command &command) const
 	else if(ship.GetTargetStellar())
 	{
 		MoveToPlanet(ship, command);
-		if(!shouldStay && ship.Attributes().Get("fuel capacity") && ship.GetTargetStellar()->HasSprite()
+		if(!shouldStay && ship.Attributes().Get(Attribute::FUEL_CAPACITY) && ship.GetTargetStellar()->HasSprite()
 				&& ship.GetTargetStellar()->GetPlanet() && ship.GetTargetStellar()->GetPlanet()->CanLand(ship))
 			command |= Command::LAND;
 		else if(ship.Position().Distance(ship.GetTargetStellar()->Position()) < 100.)
@@ -1543,7 +1807,7 @@ void AI::MoveIndependent(Ship &ship, Command &command) const
 	}
 	else if(shouldStay && !ship.GetSystem()->Objects().empty())
 	{
-		unsigned i = Random::Int(origin->Objects().size());
+		unsigned i = random.Int(origin->Objects().size());
 		ship.SetTargetStellar(&origin->Objects()[i]);
 	}
 }
@@ -1553,7 +1817,7 @@ void AI::MoveIndependent(Ship &ship, Command &command) const
 void AI::MoveEscort(Ship &ship, Command &command) const
 {
 	const Ship &parent = *ship.GetParent();
-	bool hasFuelCapacity = ship.Attributes().Get("fuel capacity") && ship.JumpFuel();
+	bool hasFuelCapacity = ship.Attributes().Get(Attribute::FUEL_CAPACITY) && ship.JumpFuel();
 	bool isStaying = ship.GetPersonality().IsStaying() || !hasFuelCapacity;
 	bool parentIsHere = (ship.GetSystem() == parent.GetSystem());
 	// Check if the parent has a target planet that is in the parent's system.
@@ -1606,8 +1870,7 @@ void AI::MoveEscort(Ship &ship, Command &command) const
 	// If the parent is in-system and planning to jump, non-staying escorts should follow suit.
 	else if(parent.Commands().Has(Command::JUMP) && parent.GetTargetSystem() && !isStaying)
 	{
-		DistanceMap distance(ship, parent.GetTargetSystem());
-		const System *dest = distance.Route(ship.GetSystem());
+		const System *dest = RouteCache::Get(ship, parent.GetTargetSystem())->Route(ship.GetSystem());
 		ship.SetTargetSystem(dest);
 		if(!dest)
 			// This ship has no route to the parent's destination system, so protect it until it jumps away.
@@ -1717,9 +1980,9 @@ bool AI::ShouldDock(const Ship &ship, const Ship &parent, const System *playerSy
 	
 	// If a carried ship has fuel capacity but is very low, it should return if
 	// the parent can refuel it.
-	double maxFuel = ship.Attributes().Get("fuel capacity");
+	double maxFuel = ship.Attributes().Get(Attribute::FUEL_CAPACITY);
 	if(maxFuel && ship.Fuel() < .005 && parent.JumpFuel() < parent.Fuel() *
-			parent.Attributes().Get("fuel capacity") - maxFuel)
+			parent.Attributes().Get(Attribute::FUEL_CAPACITY) - maxFuel)
 		return true;
 	
 	// If an out-of-combat NPC carried ship is carrying a significant cargo
@@ -1835,7 +2098,7 @@ bool AI::Stop(Ship &ship, Command &command, double maxSpeed, const Point directi
 	
 	// If you have a reverse thruster, figure out whether using it is faster
 	// than turning around and using your main thruster.
-	if(ship.Attributes().Get("reverse thrust"))
+	if(ship.Attributes().Get(Attribute::REVERSE_THRUST))
 	{
 		// Figure out your stopping time using your main engine:
 		double degreesToTurn = TO_DEG * acos(min(1., max(-1., -velocity.Unit().Dot(angle.Unit()))));
@@ -1843,7 +2106,7 @@ bool AI::Stop(Ship &ship, Command &command, double maxSpeed, const Point directi
 		forwardTime += stopTime;
 		
 		// Figure out your reverse thruster stopping time:
-		double reverseAcceleration = ship.Attributes().Get("reverse thrust") / ship.Mass();
+		double reverseAcceleration = ship.Attributes().Get(Attribute::REVERSE_THRUST) / ship.Mass();
 		double reverseTime = (180. - degreesToTurn) / ship.TurnRate();
 		reverseTime += speed / reverseAcceleration;
 		
@@ -1881,9 +2144,9 @@ bool AI::Stop(Ship &ship, Command &command, double maxSpeed, const Point directi
 
 void AI::PrepareForHyperspace(Ship &ship, Command &command)
 {
-	bool hasHyperdrive = ship.Attributes().Get("hyperdrive");
-	double scramThreshold = ship.Attributes().Get("scram drive");
-	bool hasJumpDrive = ship.Attributes().Get("jump drive");
+	bool hasHyperdrive = ship.Attributes().Get(Attribute::HYPERDRIVE);
+	double scramThreshold = ship.Attributes().Get(Attribute::SCRAM_DRIVE);
+	bool hasJumpDrive = ship.Attributes().Get(Attribute::JUMP_DRIVE);
 	if(!hasHyperdrive && !hasJumpDrive)
 		return;
 	
@@ -1923,9 +2186,9 @@ void AI::PrepareForHyperspace(Ship &ship, Command &command)
 	}
 	// If we're a jump drive, just stop.
 	else if(isJump)
-		Stop(ship, command, ship.Attributes().Get("jump speed"));
+		Stop(ship, command, ship.Attributes().Get(Attribute::JUMP_SPEED));
 	// Else stop in the fastest way to end facing in the right direction
-	else if(Stop(ship, command, ship.Attributes().Get("jump speed"), direction))
+	else if(Stop(ship, command, ship.Attributes().Get(Attribute::JUMP_SPEED), direction))
 		command.SetTurn(TurnToward(ship, direction));
 }
 
@@ -2036,12 +2299,12 @@ void AI::KeepStation(Ship &ship, Command &command, const Body &target)
 		command.SetTurn(targetAngle);
 	
 	// Determine whether to apply thrust.
-	Point drag = ship.Velocity() * (ship.Attributes().Get("drag") / mass);
-	if(ship.Attributes().Get("reverse thrust"))
+	Point drag = ship.Velocity() * (ship.Attributes().Get(Attribute::DRAG) / mass);
+	if(ship.Attributes().Get(Attribute::REVERSE_THRUST))
 	{
 		// Don't take drag into account when reverse thrusting, because this
 		// estimate of how it will be applied can be quite inaccurate.
-		Point a = (unit * (-ship.Attributes().Get("reverse thrust") / mass)).Unit();
+		Point a = (unit * (-ship.Attributes().Get(Attribute::REVERSE_THRUST) / mass)).Unit();
 		double direction = positionWeight * positionDelta.Dot(a) / POSITION_DEADBAND
 			+ velocityWeight * velocityDelta.Dot(a) / VELOCITY_DEADBAND;
 		if(direction > THRUST_DEADBAND)
@@ -2144,7 +2407,7 @@ void AI::MoveToAttack(Ship &ship, Command &command, const Body &target)
 	
 	// If the ship has reverse thrusters and the target is behind it, we can
 	// use them to reach the target more quickly.
-	if(ship.Facing().Unit().Dot(d.Unit()) < -.75 && ship.Attributes().Get("reverse thrust"))
+	if(ship.Facing().Unit().Dot(d.Unit()) < -.75 && ship.Attributes().Get(Attribute::REVERSE_THRUST))
 		command |= Command::BACK;
 	// This isn't perfect, but it works well enough.
 	else if((ship.Facing().Unit().Dot(d) >= 0. && d.Length() > diameter)
@@ -2192,18 +2455,18 @@ void AI::PickUp(Ship &ship, Command &command, const Body &target)
 // energy strain, or undue thermal loads if almost overheated.
 bool AI::ShouldUseAfterburner(Ship &ship)
 {
-	if(!ship.Attributes().Get("afterburner thrust"))
+	if(!ship.Attributes().Get(Attribute::AFTERBURNER_THRUST))
 		return false;
 	
-	double fuel = ship.Fuel() * ship.Attributes().Get("fuel capacity");
-	double neededFuel = ship.Attributes().Get("afterburner fuel");
-	double energy = ship.Energy() * ship.Attributes().Get("energy capacity");
-	double neededEnergy = ship.Attributes().Get("afterburner energy");
+	double fuel = ship.Fuel() * ship.Attributes().Get(Attribute::FUEL_CAPACITY);
+	double neededFuel = ship.Attributes().Get(Attribute::AFTERBURNER_FUEL);
+	double energy = ship.Energy() * ship.Attributes().Get(Attribute::ENERGY_CAPACITY);
+	double neededEnergy = ship.Attributes().Get(Attribute::AFTERBURNER_ENERGY);
 	if(energy == 0.)
-		energy = ship.Attributes().Get("energy generation")
-				+ 0.2 * ship.Attributes().Get("solar collection")
-				- ship.Attributes().Get("energy consumption");
-	double outputHeat = ship.Attributes().Get("afterburner heat") / (100 * ship.Mass());
+		energy = ship.Attributes().Get(Attribute::ENERGY_GENERATION)
+				+ 0.2 * ship.Attributes().Get(Attribute::SOLAR_COLLECTION)
+				- ship.Attributes().Get(Attribute::ENERGY_CONSUMPTION);
+	double outputHeat = ship.Attributes().Get(Attribute::AFTERBURNER_HEAT) / (100 * ship.Mass());
 	if((!neededFuel || fuel - neededFuel > ship.JumpFuel())
 			&& (!neededEnergy || neededEnergy / energy < 0.25)
 			&& (!outputHeat || ship.Heat() + outputHeat < .9))
@@ -2215,18 +2478,18 @@ bool AI::ShouldUseAfterburner(Ship &ship)
 
 
 // Find a target ship to flock around at high speed.
-void AI::DoSwarming(Ship &ship, Command &command, shared_ptr<Ship> &target)
+void AI::DoSwarming(ShipStep &shipStep, Command &command, shared_ptr<Ship> &target) const
 {
+	Ship &ship = *shipStep.ship;
 	// Find a new ship to target on average every 10 seconds, or if the current target
 	// is no longer eligible. If landing, release the old target so others can swarm it.
-	if(ship.IsLanding() || !target || !CanSwarm(ship, *target) || !Random::Int(600))
+	if(ship.IsLanding() || !target || !CanSwarm(ship, *target) || !shipStep.random.Int(600))
 	{
 		if(target)
 		{
-			// Allow another swarming ship to consider the target.
-			auto sit = swarmCount.find(target.get());
-			if(sit != swarmCount.end() && sit->second > 0)
-				--sit->second;
+			// Allow another swarming ship to consider the target, once all
+			// the ships have decided what to do.
+			shipStep.swarmLeft = target.get();
 			// Release the current target.
 			target.reset();
 			ship.SetTargetShip(target);
@@ -2242,7 +2505,8 @@ void AI::DoSwarming(Ship &ship, Command &command, shared_ptr<Ship> &target)
 			if(!other->GetPersonality().IsSwarming())
 			{
 				// Prefer to swarm ships that are not already being heavily swarmed.
-				int count = swarmCount[other.get()] + Random::Int(4);
+				auto sit = swarmCount.find(other.get());
+				int count = (sit == swarmCount.end() ? 0 : sit->second) + shipStep.random.Int(4);
 				if(count < lowestCount)
 				{
 					target = other;
@@ -2250,8 +2514,7 @@ void AI::DoSwarming(Ship &ship, Command &command, shared_ptr<Ship> &target)
 				}
 			}
 		ship.SetTargetShip(target);
-		if(target)
-			++swarmCount[target.get()];
+		shipStep.swarmJoined = target.get();
 	}
 	// If a friendly ship to flock with was not found, return to an available planet.
 	if(target)
@@ -2262,7 +2525,7 @@ void AI::DoSwarming(Ship &ship, Command &command, shared_ptr<Ship> &target)
 
 
 
-void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target) const
+void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target, ShipRandom &random) const
 {
 	// Since DoSurveillance is called after target-seeking and firing, if this
 	// ship has a target, that target is guaranteed to be targetable.
@@ -2275,7 +2538,7 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 	if(target && ship.GetGovernment()->IsEnemy(target->GetGovernment()))
 	{
 		// Automatic aiming and firing already occurred.
-		MoveIndependent(ship, command);
+		MoveIndependent(ship, command, random);
 		return;
 	}
 	
@@ -2295,9 +2558,9 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 	{
 		// Approach the planet and "land" on it (i.e. scan it).
 		MoveToPlanet(ship, command);
-		double atmosphereScan = ship.Attributes().Get("atmosphere scan");
+		double atmosphereScan = ship.Attributes().Get(Attribute::ATMOSPHERE_SCAN);
 		double distance = ship.Position().Distance(ship.GetTargetStellar()->Position());
-		if(distance < atmosphereScan && !Random::Int(100))
+		if(distance < atmosphereScan && !random.Int(100))
 			ship.SetTargetStellar(nullptr);
 		else
 			command |= Command::LAND;
@@ -2305,8 +2568,8 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 	else if(target)
 	{
 		// Approach and scan the targeted, friendly ship's cargo or outfits.
-		bool cargoScan = ship.Attributes().Get("cargo scan power");
-		bool outfitScan = ship.Attributes().Get("outfit scan power");
+		bool cargoScan = ship.Attributes().Get(Attribute::CARGO_SCAN_POWER);
+		bool outfitScan = ship.Attributes().Get(Attribute::OUTFIT_SCAN_POWER);
 		// If the pointer to the target ship exists, it is targetable and in-system.
 		bool mustScanCargo = cargoScan && !Has(ship, target, ShipEvent::SCAN_CARGO);
 		bool mustScanOutfits = outfitScan && !Has(ship, target, ShipEvent::SCAN_OUTFITS);
@@ -2325,8 +2588,8 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 		
 		// Consider scanning any non-hostile ship in this system that you haven't yet personally scanned.
 		vector<shared_ptr<Ship>> targetShips;
-		bool cargoScan = ship.Attributes().Get("cargo scan power");
-		bool outfitScan = ship.Attributes().Get("outfit scan power");
+		bool cargoScan = ship.Attributes().Get(Attribute::CARGO_SCAN_POWER);
+		bool outfitScan = ship.Attributes().Get(Attribute::OUTFIT_SCAN_POWER);
 		if(cargoScan || outfitScan)
 			for(const auto &grit : governmentRosters)
 			{
@@ -2345,7 +2608,7 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 		
 		// Consider scanning any planetary object in the system, if able.
 		vector<const StellarObject *> targetPlanets;
-		double atmosphereScan = ship.Attributes().Get("atmosphere scan");
+		double atmosphereScan = ship.Attributes().Get(Attribute::ATMOSPHERE_SCAN);
 		if(atmosphereScan)
 			for(const StellarObject &object : system->Objects())
 				if(object.HasSprite() && !object.IsStar() && !object.IsStation())
@@ -2355,7 +2618,7 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 		vector<const System *> targetSystems;
 		if(ship.JumpsRemaining(false))
 		{
-			const auto &links  = ship.Attributes().Get("jump drive") ? system->JumpNeighbors(ship.JumpRange()) : system->Links();
+			const auto &links  = ship.Attributes().Get(Attribute::JUMP_DRIVE) ? system->JumpNeighbors(ship.JumpRange()) : system->Links();
 			targetSystems.insert(targetSystems.end(), links.begin(), links.end());
 		}
 		
@@ -2368,7 +2631,7 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 			return;
 		}
 		
-		unsigned index = Random::Int(total);
+		unsigned index = random.Int(total);
 		if(index < targetShips.size())
 			ship.SetTargetShip(targetShips[index]);
 		else
@@ -2433,7 +2696,7 @@ void AI::DoMining(Ship &ship, Command &command)
 
 
 
-bool AI::DoHarvesting(Ship &ship, Command &command)
+bool AI::DoHarvesting(Ship &ship, Command &command, ShipRandom &random)
 {
 	// If the ship has no target to pick up, do nothing.
 	shared_ptr<Flotsam> target = ship.GetTargetFlotsam();
@@ -2445,7 +2708,7 @@ bool AI::DoHarvesting(Ship &ship, Command &command)
 	if(!target)
 	{
 		// Only check for new targets every 10 frames, on average.
-		if(Random::Int(10))
+		if(random.Int(10))
 			return false;
 		
 		// Don't chase anything that will take more than 10 seconds to reach.
@@ -2496,15 +2759,15 @@ bool AI::DoHarvesting(Ship &ship, Command &command)
 // Check if this ship should cloak. Returns true if this ship decided to run away while cloaking.
 bool AI::DoCloak(Ship &ship, Command &command)
 {
-	if(ship.Attributes().Get("cloak"))
+	if(ship.Attributes().Get(Attribute::CLOAK))
 	{
 		// Never cloak if it will cause you to be stranded.
 		const Outfit &attributes = ship.Attributes();
-		double fuelCost = attributes.Get("cloaking fuel") + attributes.Get("fuel consumption") - attributes.Get("fuel generation");
-		if(attributes.Get("cloaking fuel") && !attributes.Get("ramscoop"))
+		double fuelCost = attributes.Get(Attribute::CLOAKING_FUEL) + attributes.Get(Attribute::FUEL_CONSUMPTION) - attributes.Get(Attribute::FUEL_GENERATION);
+		if(attributes.Get(Attribute::CLOAKING_FUEL) && !attributes.Get(Attribute::RAMSCOOP))
 		{
-			double fuel = ship.Fuel() * attributes.Get("fuel capacity");
-			int steps = ceil((1. - ship.Cloaking()) / attributes.Get("cloak"));
+			double fuel = ship.Fuel() * attributes.Get(Attribute::FUEL_CAPACITY);
+			int steps = ceil((1. - ship.Cloaking()) / attributes.Get(Attribute::CLOAK));
 			// Only cloak if you will be able to fully cloak and also maintain it
 			// for as long as it will take you to reach full cloak.
 			fuel -= fuelCost * (1 + 2 * steps);
@@ -2546,7 +2809,7 @@ bool AI::DoCloak(Ship &ship, Command &command)
 		bool cloakFreely = (fuelCost <= 0.) && !ship.GetShipToAssist();
 		// If this ship is injured / repairing, it should cloak while under threat.
 		bool cloakToRepair = (ship.Health() < RETREAT_HEALTH + hysteresis)
-				&& (attributes.Get("shield generation") || attributes.Get("hull repair rate"));
+				&& (attributes.Get(Attribute::SHIELD_GENERATION) || attributes.Get(Attribute::HULL_REPAIR_RATE));
 		if(cloakToRepair && (cloakFreely || range < 2000. * (1. + hysteresis)))
 		{
 			command |= Command::CLOAK;
@@ -2643,10 +2906,10 @@ Point AI::StoppingPoint(const Ship &ship, const Point &targetVelocity, bool &sho
 	// The average term's value will be v / 2. So:
 	stopDistance += .5 * v * v / acceleration;
 	
-	if(ship.Attributes().Get("reverse thrust"))
+	if(ship.Attributes().Get(Attribute::REVERSE_THRUST))
 	{
 		// Figure out your reverse thruster stopping distance:
-		double reverseAcceleration = ship.Attributes().Get("reverse thrust") / ship.Mass();
+		double reverseAcceleration = ship.Attributes().Get(Attribute::REVERSE_THRUST) / ship.Mass();
 		double reverseDistance = v * (180. - degreesToTurn) / turnRate;
 		reverseDistance += .5 * v * v / reverseAcceleration;
 		
@@ -2710,7 +2973,7 @@ Point AI::TargetAim(const Ship &ship, const Body &target)
 
 
 // Aim the given ship's turrets.
-void AI::AimTurrets(const Ship &ship, Command &command, bool opportunistic) const
+void AI::AimTurrets(const Ship &ship, Command &command, bool opportunistic, ShipRandom &random) const
 {
 	// First, get the set of potential hostile ships.
 	auto targets = vector<const Body *>();
@@ -2772,12 +3035,12 @@ void AI::AimTurrets(const Ship &ship, Command &command, bool opportunistic) cons
 				// First, check if this turret is currently in motion. If not,
 				// it only has a small chance of beginning to move.
 				double previous = ship.Commands().Aim(index);
-				if(!previous && (Random::Int(60)))
+				if(!previous && (random.Int(60)))
 					continue;
 				
 				Angle centerAngle = Angle(hardpoint.GetPoint());
 				double bias = (centerAngle - hardpoint.GetAngle()).Degrees() / 180.;
-				double acceleration = Random::Real() - Random::Real() + bias;
+				double acceleration = random.Real() - random.Real() + bias;
 				command.SetAim(index, previous + .1 * acceleration);
 			}
 		return;
@@ -2942,7 +3205,7 @@ void AI::AutoFire(const Ship &ship, Command &command, bool secondary) const
 		// fuel that you cannot leave the system if necessary.
 		if(weapon->FiringFuel())
 		{
-			double fuel = ship.Fuel() * ship.Attributes().Get("fuel capacity");
+			double fuel = ship.Fuel() * ship.Attributes().Get(Attribute::FUEL_CAPACITY);
 			fuel -= weapon->FiringFuel();
 			// If the ship is not ever leaving this system, it does not need to
 			// reserve any fuel.
@@ -3429,7 +3692,7 @@ void AI::MovePlayer(Ship &ship, const PlayerInfo &player, Command &activeCommand
 		if(!ship.GetTargetSystem() && !isWormhole)
 		{
 			double bestMatch = -2.;
-			const auto &links = (ship.Attributes().Get("jump drive") ?
+			const auto &links = (ship.Attributes().Get(Attribute::JUMP_DRIVE) ?
 				ship.GetSystem()->JumpNeighbors(ship.JumpRange()) : ship.GetSystem()->Links());
 			for(const System *link : links)
 			{
@@ -3466,7 +3729,8 @@ void AI::MovePlayer(Ship &ship, const PlayerInfo &player, Command &activeCommand
 		command |= Command::SCAN;
 	
 	const shared_ptr<const Ship> target = ship.GetTargetShip();
-	AimTurrets(ship, command, !Preferences::Has("Turrets focus fire"));
+	ShipRandom random;
+	AimTurrets(ship, command, !Preferences::Has("Turrets focus fire"), random);
 	if(Preferences::Has("Automatic firing") && !ship.IsBoarding()
 			&& !(autoPilot | activeCommands).Has(Command::LAND | Command::JUMP | Command::BOARD)
 			&& (!target || target->GetGovernment()->IsEnemy()))
@@ -3479,7 +3743,7 @@ void AI::MovePlayer(Ship &ship, const PlayerInfo &player, Command &activeCommand
 			command.SetTurn(activeCommands.Has(Command::RIGHT) - activeCommands.Has(Command::LEFT));
 		if(activeCommands.Has(Command::BACK))
 		{
-			if(!activeCommands.Has(Command::FORWARD) && ship.Attributes().Get("reverse thrust"))
+			if(!activeCommands.Has(Command::FORWARD) && ship.Attributes().Get(Attribute::REVERSE_THRUST))
 				command |= Command::BACK;
 			else if(!activeCommands.Has(Command::RIGHT | Command::LEFT))
 				command.SetTurn(TurnBackward(ship));
@@ -3573,7 +3837,7 @@ void AI::MovePlayer(Ship &ship, const PlayerInfo &player, Command &activeCommand
 	}
 	else if(autoPilot.Has(Command::JUMP))
 	{
-		if(!ship.Attributes().Get("hyperdrive") && !ship.Attributes().Get("jump drive"))
+		if(!ship.Attributes().Get(Attribute::HYPERDRIVE) && !ship.Attributes().Get(Attribute::JUMP_DRIVE))
 		{
 			Messages::Add("You do not have a hyperdrive installed.", Messages::Importance::Highest);
 			autoPilot.Clear();
@@ -3731,23 +3995,36 @@ void AI::UpdateStrengths(map<const Government *, int64_t> &strength, const Syste
 
 
 
-// Cache various lists of all targetable ships in the player's system for this Step.
+// Cache which of the governments with ships in the player's system are enemies
+// of each other for this Step.
 void AI::CacheShipLists()
 {
-	allyLists.clear();
-	enemyLists.clear();
+	const size_t count = governmentRosters.size();
+	rosterIndex.clear();
+	isEnemy.assign(count * count, false);
+	
+	size_t row = 0;
 	for(const auto &git : governmentRosters)
 	{
-		allyLists.emplace(git.first, vector<shared_ptr<Ship>>());
-		allyLists.at(git.first).reserve(ships.size());
-		enemyLists.emplace(git.first, vector<shared_ptr<Ship>>());
-		enemyLists.at(git.first).reserve(ships.size());
+		rosterIndex.emplace(git.first, row);
+		size_t column = 0;
 		for(const auto &oit : governmentRosters)
+			isEnemy[row * count + column++] = git.first->IsEnemy(oit.first);
+		++row;
+	}
+	
+	// Sort the ships into the grid, reusing the cells from the previous step.
+	shipGrid.Clear();
+	maxShipSpeed = 0.;
+	row = 0;
+	for(const auto &git : governmentRosters)
+	{
+		for(const shared_ptr<Ship> &it : git.second)
 		{
-			auto &list = git.first->IsEnemy(oit.first)
-					? enemyLists[git.first] : allyLists[git.first];
-			list.insert(list.end(), oit.second.begin(), oit.second.end());
+			shipGrid.Add(it, row);
+			maxShipSpeed = max(maxShipSpeed, it->Velocity().Length());
 		}
+		++row;
 	}
 }
 
@@ -15,6 +15,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #include "Command.h"
 #include "Point.h"
+#include "ShipGrid.h"
 
 #include <cstdint>
 #include <list>
@@ -33,6 +34,7 @@ class Ship;
 class ShipEvent;
 class StellarObject;
 class System;
+class ThreadPool;
 
 
 
@@ -47,8 +49,9 @@ public:
 	// Any object that can be a ship's target is in a list of this type:
 template <class Type>
 	using List = std::list<std::shared_ptr<Type>>;
-	// Constructor, giving the AI access to various object lists.
-	AI(const List<Ship> &ships, const List<Minable> &minables, const List<Flotsam> &flotsam);
+	// Constructor, giving the AI access to various object lists, and to the
+	// worker threads it can spread its work over.
+	AI(const List<Ship> &ships, const List<Minable> &minables, const List<Flotsam> &flotsam, ThreadPool &workers);
 	
 	// Fleet commands from the player.
 	void IssueShipTarget(const PlayerInfo &player, const std::shared_ptr<Ship> &target);
@@ -72,6 +75,15 @@ template <class Type>
 	
 	
 private:
+	// A source of random numbers for the decisions about one ship.
+	class ShipRandom;
+	// The state of the decisions about one ship in the current step.
+	class ShipStep;
+	
+	
+private:
+	// Decide what the given ship should do in this step.
+	void MoveShip(ShipStep &shipStep, const PlayerInfo &player, bool fightersRetreat);
 	// Check if a ship can pursue its target (i.e. beyond the "fence").
 	bool CanPursue(const Ship &ship, const Ship &target) const;
 	// Disabled or stranded ships coordinate with other ships to get assistance.
@@ -83,8 +95,8 @@ private:
 	// Obtain a list of ships matching the desired hostility.
 	std::vector<std::shared_ptr<Ship>> GetShipsList(const Ship &ship, bool targetEnemies, double maxRange = -1.) const;
 	
-	bool FollowOrders(Ship &ship, Command &command) const;
-	void MoveIndependent(Ship &ship, Command &command) const;
+	bool FollowOrders(Ship &ship, Command &command, ShipRandom &random) const;
+	void MoveIndependent(Ship &ship, Command &command, ShipRandom &random) const;
 	void MoveEscort(Ship &ship, Command &command) const;
 	static void Refuel(Ship &ship, Command &command);
 	static bool CanRefuel(const Ship &ship, const StellarObject *target);
@@ -106,10 +118,10 @@ private:
 	// Special decisions a ship might make.
 	static bool ShouldUseAfterburner(Ship &ship);
 	// Special personality behaviors.
-	void DoSwarming(Ship &ship, Command &command, std::shared_ptr<Ship> &target);
-	void DoSurveillance(Ship &ship, Command &command, std::shared_ptr<Ship> &target) const;
+	void DoSwarming(ShipStep &shipStep, Command &command, std::shared_ptr<Ship> &target) const;
+	void DoSurveillance(Ship &ship, Command &command, std::shared_ptr<Ship> &target, ShipRandom &random) const;
 	void DoMining(Ship &ship, Command &command);
-	bool DoHarvesting(Ship &ship, Command &command);
+	bool DoHarvesting(Ship &ship, Command &command, ShipRandom &random);
 	bool DoCloak(Ship &ship, Command &command);
 	// Prevent ships from stacking on each other when many are moving in sync.
 	void DoScatter(Ship &ship, Command &command);
@@ -122,7 +134,7 @@ private:
 	static Point TargetAim(const Ship &ship);
 	static Point TargetAim(const Ship &ship, const Body &target);
 	// Aim the given ship's turrets.
-	void AimTurrets(const Ship &ship, Command &command, bool opportunistic = false) const;
+	void AimTurrets(const Ship &ship, Command &command, bool opportunistic, ShipRandom &random) const;
 	// Fire whichever of the given ship's weapons can hit a hostile target.
 	// Return a bitmask giving the weapons to fire.
 	void AutoFire(const Ship &ship, Command &command, bool secondary = true) const;
@@ -181,10 +193,15 @@ private:
 	const List<Ship> &ships;
 	const List<Minable> &minables;
 	const List<Flotsam> &flotsam;
+	ThreadPool &workers;
 	
 	// The current step count for the AI, ranging from 0 to 30. Its value
 	// helps limit how often certain actions occur (such as changing targets).
 	int step = 0;
+	// The seed for the random decisions made about each ship in this step.
+	uint64_t randomSeed = 0;
+	// The number of ships that have started mining in this step.
+	int minerCount = 0;
 	
 	// Command applied by the player's "autopilot."
 	Command autoPilot;
@@ -221,8 +238,16 @@ private:
 	std::map<const Government *, int64_t> enemyStrength;
 	std::map<const Government *, int64_t> allyStrength;
 	std::map<const Government *, std::vector<std::shared_ptr<Ship>>> governmentRosters;
-	std::map<const Government *, std::vector<std::shared_ptr<Ship>>> enemyLists;
-	std::map<const Government *, std::vector<std::shared_ptr<Ship>>> allyLists;
+	// The index of each government in governmentRosters, and a matrix of which
+	// of those governments are enemies, with one row for each government. The
+	// ships a government considers enemies or allies are found by going through
+	// the rosters with the matching bits in its row, instead of copying them.
+	std::map<const Government *, size_t> rosterIndex;
+	std::vector<bool> isEnemy;
+	// The ships in governmentRosters, sorted into a grid of cells by position.
+	// Also track how fast the fastest of them is moving.
+	ShipGrid shipGrid;
+	double maxShipSpeed = 0.;
 };
 
 
@@ -80,17 +80,17 @@ void AsteroidField::Add(const Minable *minable, int count, double energy, double
 // Move all the asteroids forward one step.
 void AsteroidField::Step(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam, int step)
 {
-	asteroidCollisions.Clear(step);
+	asteroidCollisions.Update(step);
 	for(Asteroid &asteroid : asteroids)
 	{
-		asteroidCollisions.Add(asteroid);
 		asteroid.Step();
+		asteroidCollisions.Add(asteroid);
 	}
 	asteroidCollisions.Finish();
 	
 	// Step through the minables. Since they are destructible, we may need to
 	// remove them from the list.
-	minableCollisions.Clear(step);
+	minableCollisions.Update(step);
 	auto it = minables.begin();
 	while(it != minables.end())
 	{
@@ -119,9 +119,11 @@ void AsteroidField::Draw(DrawList &draw, const Point &center, double zoom) const
 
 
 // Check if the given projectile collides with any asteroids.
-Body *AsteroidField::Collide(const Projectile &projectile, double *closestHit)
+Body *AsteroidField::Collide(const Projectile &projectile, double *closestHit, vector<const Body *> &seen,
+		Minable **minable) const
 {
 	Body *hit = nullptr;
+	*minable = nullptr;
 	
 	// First, check for collisions with ordinary asteroids, which are tiled.
 	// Rather than tiling the collision set, tile the projectile.
@@ -144,7 +146,7 @@ Body *AsteroidField::Collide(const Projectile &projectile, double *closestHit)
 		for(int x = 0; x < tileX; ++x)
 		{
 			Point offset = Point(x, y) * WRAP;
-			Body *body = asteroidCollisions.Line(from + offset, to + offset, closestHit);
+			Body *body = asteroidCollisions.Line(from + offset, to + offset, seen, closestHit);
 			if(body)
 				hit = body;
 		}
@@ -153,11 +155,11 @@ Body *AsteroidField::Collide(const Projectile &projectile, double *closestHit)
 	// very last collision check to be done, if a minable asteroid is the
 	// closest hit, it really is what the projectile struck - that is, we are
 	// not going to later find a ship or something else that is closer.
-	Body *body = minableCollisions.Line(projectile, closestHit);
+	Body *body = minableCollisions.Line(projectile, seen, closestHit);
 	if(body)
 	{
 		hit = body;
-		reinterpret_cast<Minable *>(body)->TakeDamage(projectile);
+		*minable = reinterpret_cast<Minable *>(body);
 	}
 	return hit;
 }
@@ -56,7 +56,11 @@ public:
 	void Draw(DrawList &draw, const Point &center, double zoom) const;
 	// Check if the given projectile has hit any of the asteroids, using the information
 	// in the collision sets. If a collision occurs, returns a pointer to the hit body.
-	Body *Collide(const Projectile &projectile, double *closestHit);
+	// This does not damage the asteroid that was hit, so it can be called from several
+	// threads at once. Instead, if it is a minable, it is returned in "minable," and
+	// the caller should apply the damage. The "seen" vector is used as scratch space.
+	Body *Collide(const Projectile &projectile, double *closestHit, std::vector<const Body *> &seen,
+		Minable **minable) const;
 	
 	// Get the list of minable asteroids.
 	const std::list<std::shared_ptr<Minable>> &Minables() const;
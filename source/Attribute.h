@@ -0,0 +1,117 @@
+/* Attribute.h
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef ATTRIBUTE_H_
+#define ATTRIBUTE_H_
+
+// Identifiers for the outfit attributes that the engine looks up for every ship
+// in every frame. An Outfit keeps the values of these in a flat array, so they
+// can be looked up without searching its attributes by name. Any attribute can
+// still be looked up by name, including these ones. Each identifier is the
+// attribute's name in upper case, with underscores instead of spaces.
+enum class Attribute : int {
+	ACTIVE_COOLING,
+	AFTERBURNER_ENERGY,
+	AFTERBURNER_FUEL,
+	AFTERBURNER_HEAT,
+	AFTERBURNER_THRUST,
+	ATMOSPHERE_SCAN,
+	AUTOMATON,
+	BUNKS,
+	BURN_RESISTANCE,
+	BURN_RESISTANCE_ENERGY,
+	BURN_RESISTANCE_FUEL,
+	BURN_RESISTANCE_HEAT,
+	CARGO_SCAN_POWER,
+	CLOAK,
+	CLOAKING_ENERGY,
+	CLOAKING_FUEL,
+	CLOAKING_HEAT,
+	COOLING,
+	COOLING_ENERGY,
+	COOLING_INEFFICIENCY,
+	CORROSION_RESISTANCE,
+	CORROSION_RESISTANCE_ENERGY,
+	CORROSION_RESISTANCE_FUEL,
+	CORROSION_RESISTANCE_HEAT,
+	DISCHARGE_RESISTANCE,
+	DISCHARGE_RESISTANCE_ENERGY,
+	DISCHARGE_RESISTANCE_FUEL,
+	DISCHARGE_RESISTANCE_HEAT,
+	DISRUPTION_RESISTANCE,
+	DISRUPTION_RESISTANCE_ENERGY,
+	DISRUPTION_RESISTANCE_FUEL,
+	DISRUPTION_RESISTANCE_HEAT,
+	DRAG,
+	ENERGY_CAPACITY,
+	ENERGY_CONSUMPTION,
+	ENERGY_GENERATION,
+	FUEL_CAPACITY,
+	FUEL_CONSUMPTION,
+	FUEL_ENERGY,
+	FUEL_GENERATION,
+	FUEL_HEAT,
+	HEAT_DISSIPATION,
+	HEAT_GENERATION,
+	HULL,
+	HULL_ENERGY,
+	HULL_ENERGY_MULTIPLIER,
+	HULL_FUEL,
+	HULL_FUEL_MULTIPLIER,
+	HULL_HEAT,
+	HULL_HEAT_MULTIPLIER,
+	HULL_REPAIR_MULTIPLIER,
+	HULL_REPAIR_RATE,
+	HYPERDRIVE,
+	ION_RESISTANCE,
+	ION_RESISTANCE_ENERGY,
+	ION_RESISTANCE_FUEL,
+	ION_RESISTANCE_HEAT,
+	JUMP_DRIVE,
+	JUMP_RANGE,
+	JUMP_SPEED,
+	LEAK_RESISTANCE,
+	LEAK_RESISTANCE_ENERGY,
+	LEAK_RESISTANCE_FUEL,
+	LEAK_RESISTANCE_HEAT,
+	OUTFIT_SCAN_POWER,
+	RAMSCOOP,
+	REQUIRED_CREW,
+	REVERSE_THRUST,
+	SCRAM_DRIVE,
+	SELF_DESTRUCT,
+	SHIELD_ENERGY,
+	SHIELD_ENERGY_MULTIPLIER,
+	SHIELD_FUEL,
+	SHIELD_FUEL_MULTIPLIER,
+	SHIELD_GENERATION,
+	SHIELD_GENERATION_MULTIPLIER,
+	SHIELD_HEAT,
+	SHIELD_HEAT_MULTIPLIER,
+	SHIELDS,
+	SLOWING_RESISTANCE,
+	SLOWING_RESISTANCE_ENERGY,
+	SLOWING_RESISTANCE_FUEL,
+	SLOWING_RESISTANCE_HEAT,
+	SOLAR_COLLECTION,
+	SOLAR_HEAT,
+	THRUST,
+	TURN,
+	TURNING_ENERGY,
+	TURNING_HEAT,
+	// The number of attributes above.
+	COUNT
+};
+
+
+
+#endif
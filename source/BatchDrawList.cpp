@@ -17,27 +17,101 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Screen.h"
 #include "Sprite.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
 
 namespace {
-	void Push(vector<float> &v, const Point &pos, float s, float t, float frame)
+	void Push(float *&v, const Point &pos, float s, float t, float frame)
 	{
-		v.push_back(pos.X());
-		v.push_back(pos.Y());
-		v.push_back(s);
-		v.push_back(t);
-		v.push_back(frame);
+		*v++ = pos.X();
+		*v++ = pos.Y();
+		*v++ = s;
+		*v++ = t;
+		*v++ = frame;
 	}
 }
 
 
 
+void BatchDrawList::Storage::Clear()
+{
+	records.clear();
+	vertices.clear();
+}
+
+
+
+// Get space for the vertex data of one more copy of the given sprite.
+float *BatchDrawList::Storage::Add(const Sprite *sprite)
+{
+	Reserve(records, 1);
+	Reserve(vertices, FLOATS);
+	
+	records.emplace_back(sprite, vertices.size());
+	vertices.resize(vertices.size() + FLOATS);
+	return &vertices[records.back().second];
+}
+
+
+
+// Group the vertex data by sprite.
+void BatchDrawList::Storage::Sort()
+{
+	// The index of each copy's data is unique, so sorting by it as well keeps
+	// the copies of each sprite in order without needing a stable sort (which
+	// may allocate memory).
+	sort(records.begin(), records.end());
+	
+	groups.clear();
+	sorted.clear();
+	Reserve(sorted, vertices.size());
+	for(const pair<const Sprite *, size_t> &it : records)
+	{
+		if(groups.empty() || groups.back().sprite != it.first)
+		{
+			Reserve(groups, 1);
+			groups.push_back(Group{it.first, sorted.size(), sorted.size()});
+		}
+		sorted.insert(sorted.end(), vertices.begin() + it.second, vertices.begin() + it.second + FLOATS);
+		groups.back().end = sorted.size();
+	}
+}
+
+
+
+const vector<BatchDrawList::Storage::Group> &BatchDrawList::Storage::Groups() const
+{
+	return groups;
+}
+
+
+
+const vector<float> &BatchDrawList::Storage::Sorted() const
+{
+	return sorted;
+}
+
+
+
+template <class Type>
+void BatchDrawList::Storage::Reserve(vector<Type> &v, size_t count)
+{
+	if(v.size() + count <= v.capacity())
+		return;
+	
+	// Grow the same way push_back() would, so adding one copy at a time does
+	// not allocate every time.
+	v.reserve(max(v.size() + count, 2 * v.capacity()));
+}
+
+
+
 // Clear the list, also setting the global time step for animation.
 void BatchDrawList::Clear(int step, double zoom)
 {
-	data.clear();
+	data.Clear();
 	this->step = step;
 	this->zoom = zoom;
 	isHighDPI = (Screen::IsHighResolution() ? zoom > .5 : zoom > 1.);
@@ -81,10 +155,13 @@ bool BatchDrawList::AddVisual(const Body &visual)
 // Draw all the items in this list.
 void BatchDrawList::Draw() const
 {
+	data.Sort();
+	
 	BatchShader::Bind();
 	
-	for(const pair<const Sprite * const, vector<float>> &it : data)
-		BatchShader::Add(it.first, isHighDPI, it.second);
+	const vector<float> &sorted = data.Sorted();
+	for(const Storage::Group &group : data.Groups())
+		BatchShader::Add(group.sprite, isHighDPI, sorted.data() + group.begin, group.end - group.begin);
 	
 	BatchShader::Unbind();
 }
@@ -119,8 +196,8 @@ bool BatchDrawList::Add(const Body &body, Point position, float clip)
 	if(Cull(body, position))
 		return false;
 	
-	// Get the data vector for this particular sprite.
-	vector<float> &v = data[body.GetSprite()];
+	// Get space for this sprite's vertex data.
+	float *v = data.Add(body.GetSprite());
 	// The sprite frame is the same for every vertex.
 	float frame = body.GetFrame(step);
 	
@@ -15,7 +15,8 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #include "Point.h"
 
-#include <map>
+#include <cstddef>
+#include <utility>
 #include <vector>
 
 class Body;
@@ -26,6 +27,56 @@ class Sprite;
 // This class collects a set of OpenGL draw commands to issue and groups them by
 // sprite, so all instances of each sprite can be drawn with a single command.
 class BatchDrawList {
+public:
+	// Storage for the vertex data of every sprite in the list. The data is kept
+	// in the order it was added and only grouped by sprite when it is drawn.
+	// Clearing it keeps all the memory it has allocated, so once it is large
+	// enough for the busiest frame it does not need to allocate any more.
+	class Storage {
+	public:
+		// A range of the sorted vertex data that all uses the same sprite.
+		class Group {
+		public:
+			const Sprite *sprite;
+			size_t begin;
+			size_t end;
+		};
+		
+		// Each sprite consists of six vertices (four vertices to form a quad and
+		// two dummy vertices to mark the break in between them). Each of those
+		// vertices has five attributes: (x, y) position in pixels, (s, t) texture
+		// coordinates, and the index of the sprite frame.
+		static const size_t FLOATS = 30;
+		
+	public:
+		void Clear();
+		// Get space for the vertex data of one more copy of the given sprite.
+		float *Add(const Sprite *sprite);
+		// Group the vertex data by sprite. The copies of each sprite stay in the
+		// order they were added in.
+		void Sort();
+		
+		// Get the groups and the vertex data that they refer to. These are only
+		// valid after sorting.
+		const std::vector<Group> &Groups() const;
+		const std::vector<float> &Sorted() const;
+		
+	private:
+		// Make room for the given number of elements to be added to a vector.
+		template <class Type>
+		void Reserve(std::vector<Type> &v, size_t count);
+		
+	private:
+		// The sprite used by each copy, and the index of its vertex data.
+		std::vector<std::pair<const Sprite *, size_t>> records;
+		// The vertex data, in the order it was added.
+		std::vector<float> vertices;
+		
+		std::vector<Group> groups;
+		std::vector<float> sorted;
+	};
+	
+	
 public:
 	// Clear the list, also setting the global time step for animation.
 	void Clear(int step = 0, double zoom = 1.);
@@ -53,11 +104,8 @@ private:
 	bool isHighDPI = false;
 	Point center;
 	
-	// Each sprite consists of six vertices (four vertices to form a quad and
-	// two dummy vertices to mark the break in between them). Each of those
-	// vertices has five attributes: (x, y) position in pixels, (s, t) texture
-	// coordinates, and the index of the sprite frame.
-	std::map<const Sprite *, std::vector<float>> data;
+	// The vertex data is sorted when the list is drawn.
+	mutable Storage data;
 };
 
 
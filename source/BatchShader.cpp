@@ -122,10 +122,10 @@ void BatchShader::Bind()
 
 
 
-void BatchShader::Add(const Sprite *sprite, bool isHighDPI, const vector<float> &data)
+void BatchShader::Add(const Sprite *sprite, bool isHighDPI, const float *data, size_t size)
 {
 	// Do nothing if there are no sprites to draw.
-	if(data.empty())
+	if(!size)
 		return;
 	
 	// First, bind the proper texture.
@@ -134,10 +134,10 @@ void BatchShader::Add(const Sprite *sprite, bool isHighDPI, const vector<float>
 	glUniform1f(frameCountI, sprite->Frames());
 	
 	// Upload the vertex data.
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * data.size(), data.data(), GL_STREAM_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * size, data, GL_STREAM_DRAW);
 	
 	// Draw all the vertices.
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, data.size() / 5);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, size / 5);
 }
 
 
@@ -15,7 +15,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 class Sprite;
 
-#include <vector>
+#include <cstddef>
 
 
 
@@ -27,7 +27,8 @@ public:
 	static void Init();
 	
 	static void Bind();
-	static void Add(const Sprite *sprite, bool isHighDPI, const std::vector<float> &data);
+	// Draw the given number of floats of vertex data.
+	static void Add(const Sprite *sprite, bool isHighDPI, const float *data, size_t size);
 	static void Unbind();
 };
 
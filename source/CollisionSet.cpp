@@ -21,11 +21,14 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Ship.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
-#include <numeric>
-#include <set>
 #include <string>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 
 namespace {
@@ -34,7 +37,49 @@ namespace {
 	// Velocity used for any projectiles with v > MAX_VELOCITY
 	constexpr int USED_MAX_VELOCITY = MAX_VELOCITY - 1;
 	// Warn the user only once about too-large projectile velocities.
-	bool warned = false;
+	atomic<bool> warned(false);
+	// Positions are copied as floats for the range checks, so allow for some
+	// rounding error when deciding which objects are out of range.
+	constexpr float RANGE_MARGIN = 1.f;
+	
+	// Check which of the objects with the given positions and radii might be
+	// touching a ring around the given point. Up to four objects, starting at
+	// the given index, are checked, and the result has a bit set for each of
+	// them that could not be ruled out.
+	unsigned InRange(const float *x, const float *y, const float *radius, size_t index, size_t count,
+		float centerX, float centerY, float inner, float outer)
+	{
+#ifdef __SSE2__
+		if(index + 4 <= count)
+		{
+			const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + index), _mm_set1_ps(centerX));
+			const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + index), _mm_set1_ps(centerY));
+			const __m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+			const __m128 r = _mm_add_ps(_mm_loadu_ps(radius + index), _mm_set1_ps(RANGE_MARGIN));
+			// An object is out of range if it is entirely outside the outer
+			// edge of the ring, or entirely inside the inner edge.
+			const __m128 far = _mm_add_ps(_mm_set1_ps(outer), r);
+			const __m128 near = _mm_max_ps(_mm_sub_ps(_mm_set1_ps(inner), r), _mm_setzero_ps());
+			const __m128 keep = _mm_and_ps(_mm_cmple_ps(distance, _mm_mul_ps(far, far)),
+				_mm_cmpge_ps(distance, _mm_mul_ps(near, near)));
+			return _mm_movemask_ps(keep);
+		}
+#endif
+		unsigned result = 0;
+		const size_t end = min(index + 4, count);
+		for(size_t i = index; i < end; ++i)
+		{
+			const float dx = x[i] - centerX;
+			const float dy = y[i] - centerY;
+			const float distance = dx * dx + dy * dy;
+			const float r = radius[i] + RANGE_MARGIN;
+			const float far = outer + r;
+			const float near = max(inner - r, 0.f);
+			if(distance <= far * far && distance >= near * near)
+				result |= 1u << (i - index);
+		}
+		return result;
+	}
 }
 
 
@@ -54,6 +99,7 @@ CollisionSet::CollisionSet(unsigned cellSize, unsigned cellCount)
 	while(cellCount >>= 1u)
 		CELLS <<= 1;
 	WRAP_MASK = CELLS - 1u;
+	cells.resize(CELLS * CELLS);
 	
 	// Just in case Clear() isn't called before objects are added:
 	Clear(0);
@@ -63,15 +109,28 @@ CollisionSet::CollisionSet(unsigned cellSize, unsigned cellCount)
 
 // Clear all objects in the set.
 void CollisionSet::Clear(int step)
+{
+	for(Cell &cell : cells)
+	{
+		cell.entries.clear();
+		cell.x.clear();
+		cell.y.clear();
+		cell.radius.clear();
+	}
+	ranges.clear();
+	
+	Update(step);
+}
+
+
+
+// Begin a new step, keeping the objects that are already in the set.
+void CollisionSet::Update(int step)
 {
 	this->step = step;
 	
 	added.clear();
-	sorted.clear();
-	counts.clear();
-	// The counts vector starts with two sentinel slots that will be used in the
-	// course of performing the radix sort.
-	counts.resize(CELLS * CELLS + 2u, 0u);
+	++generation;
 }
 
 
@@ -80,22 +139,46 @@ void CollisionSet::Clear(int step)
 void CollisionSet::Add(Body &body)
 {
 	// Calculate the range of (x, y) grid coordinates this object covers.
-	int minX = static_cast<int>(body.Position().X() - body.Radius()) >> SHIFT;
-	int minY = static_cast<int>(body.Position().Y() - body.Radius()) >> SHIFT;
-	int maxX = static_cast<int>(body.Position().X() + body.Radius()) >> SHIFT;
-	int maxY = static_cast<int>(body.Position().Y() + body.Radius()) >> SHIFT;
+	Range range;
+	range.minX = static_cast<int>(body.Position().X() - body.Radius()) >> SHIFT;
+	range.minY = static_cast<int>(body.Position().Y() - body.Radius()) >> SHIFT;
+	range.maxX = static_cast<int>(body.Position().X() + body.Radius()) >> SHIFT;
+	range.maxY = static_cast<int>(body.Position().Y() + body.Radius()) >> SHIFT;
+	range.generation = generation;
 	
-	// Add a pointer to this object in every grid cell it occupies.
-	for(int y = minY; y <= maxY; ++y)
+	// Objects update their animation frame the first time their mask is asked
+	// for in a given step. Do that for all of them now, so that queries do not
+	// modify the objects and can safely be done from several threads at once.
+	// The size of the mask also limits how far away the object can be touched.
+	const float radius = body.GetMask(step).Radius();
+	
+	auto it = ranges.find(&body);
+	if(it != ranges.end())
 	{
-		auto gy = y & WRAP_MASK;
-		for(int x = minX; x <= maxX; ++x)
+		// Don't add the same object twice.
+		Range &previous = it->second;
+		if(previous.generation == generation)
+			return;
+		added.push_back(&body);
+		
+		// Most objects do not move far enough in one step to reach another
+		// grid cell. Those can stay exactly where they are.
+		if(previous.minX == range.minX && previous.minY == range.minY
+				&& previous.maxX == range.maxX && previous.maxY == range.maxY)
 		{
-			auto gx = x & WRAP_MASK;
-			added.emplace_back(&body, x, y);
-			++counts[gy * CELLS + gx + 2];
+			previous.generation = generation;
+			Refresh(&body, range, radius);
+			return;
 		}
+		Remove(&body, previous);
+		previous = range;
 	}
+	else
+	{
+		added.push_back(&body);
+		ranges.emplace(&body, range);
+	}
+	Place(&body, range, radius);
 }
 
 
@@ -103,24 +186,18 @@ void CollisionSet::Add(Body &body)
 // Finish adding objects (and organize them into the final lookup table).
 void CollisionSet::Finish()
 {
-	// Perform a partial sum to convert the counts of items in each bin into the
-	// index of the output element where that bin begins.
-	partial_sum(counts.begin(), counts.end(), counts.begin());
-	
-	// Allocate space for a sorted copy of the vector.
-	sorted.resize(added.size());
-	
-	// Now, perform a radix sort.
-	for(const Entry &entry : added)
-	{
-		auto gx = entry.x & WRAP_MASK;
-		auto gy = entry.y & WRAP_MASK;
-		auto index = gy * CELLS + gx + 1;
-		
-		sorted[counts[index]++] = entry;
-	}
-	
-	// Now, counts[index] is where a certain bin begins.
+	// Remove any objects that were in the set before but were not added again.
+	if(ranges.size() != added.size())
+		for(auto it = ranges.begin(); it != ranges.end(); )
+		{
+			if(it->second.generation != generation)
+			{
+				Remove(it->first, it->second);
+				it = ranges.erase(it);
+			}
+			else
+				++it;
+		}
 }
 
 
@@ -128,6 +205,46 @@ void CollisionSet::Finish()
 // Get the first object that collides with the given projectile. If a
 // "closest hit" value is given, update that value.
 Body *CollisionSet::Line(const Projectile &projectile, double *closestHit) const
+{
+	vector<const Body *> seen;
+	return Line(projectile, seen, closestHit);
+}
+
+
+
+// Check for collisions with a line, which may be a projectile's current
+// position or its entire expected trajectory (for the auto-firing AI).
+Body *CollisionSet::Line(const Point &from, const Point &to, double *closestHit,
+		const Government *pGov, const Body *target) const
+{
+	vector<const Body *> seen;
+	return Line(from, to, seen, closestHit, pGov, target);
+}
+
+
+
+// Get all objects within the given range of the given point.
+const vector<Body *> &CollisionSet::Circle(const Point &center, double radius) const
+{
+	Ring(center, 0., radius, result);
+	return result;
+}
+
+
+
+// Get all objects touching a ring with a given inner and outer range
+// centered at the given point.
+const vector<Body *> &CollisionSet::Ring(const Point &center, double inner, double outer) const
+{
+	Ring(center, inner, outer, result);
+	return result;
+}
+
+
+
+// Get the first object that collides with the given projectile, using the given
+// vector as scratch space.
+Body *CollisionSet::Line(const Projectile &projectile, vector<const Body *> &seen, double *closestHit) const
 {
 	// What objects the projectile hits depends on its government.
 	const Government *pGov = projectile.GetGovernment();
@@ -135,14 +252,13 @@ Body *CollisionSet::Line(const Projectile &projectile, double *closestHit) const
 	// Convert the start and end coordinates to integers.
 	Point from = projectile.Position();
 	Point to = from + projectile.Velocity();
-	return Line(from, to, closestHit, pGov, projectile.Target());
+	return Line(from, to, seen, closestHit, pGov, projectile.Target());
 }
 
 
 
-// Check for collisions with a line, which may be a projectile's current
-// position or its entire expected trajectory (for the auto-firing AI).
-Body *CollisionSet::Line(const Point &from, const Point &to, double *closestHit,
+// Check for collisions with a line, using the given vector as scratch space.
+Body *CollisionSet::Line(const Point &from, const Point &to, vector<const Body *> &seen, double *closestHit,
 		const Government *pGov, const Body *target) const
 {
 	int x = from.X();
@@ -167,10 +283,8 @@ Body *CollisionSet::Line(const Point &from, const Point &to, double *closestHit,
 	if(gx == endGX && gy == endGY)
 	{
 		// Examine all objects in the current grid cell.
-		auto i = (gy & WRAP_MASK) * CELLS + (gx & WRAP_MASK);
-		vector<Entry>::const_iterator it = sorted.begin() + counts[i];
-		vector<Entry>::const_iterator end = sorted.begin() + counts[i + 1];
-		for( ; it != end; ++it)
+		const vector<Entry> &cell = cells[(gy & WRAP_MASK) * CELLS + (gx & WRAP_MASK)].entries;
+		for(auto it = cell.begin(); it != cell.end(); ++it)
 		{
 			// Skip objects that were put in this same grid cell only because
 			// of the cell coordinates wrapping around.
@@ -202,13 +316,10 @@ Body *CollisionSet::Line(const Point &from, const Point &to, double *closestHit,
 	if(pVelocity.Length() > MAX_VELOCITY)
 	{
 		// Cap projectile velocity to prevent integer overflows.
-		if(!warned)
-		{
+		if(!warned.exchange(true))
 			Files::LogError("Warning: maximum projectile velocity is " + to_string(MAX_VELOCITY));
-			warned = true;
-		}
 		Point newEnd = from + pVelocity.Unit() * USED_MAX_VELOCITY;
-		return Line(from, newEnd, closestHit, pGov, target);
+		return Line(from, newEnd, seen, closestHit, pGov, target);
 	}
 	
 	// When stepping from one grid cell to the next, we'll go in this direction.
@@ -232,24 +343,23 @@ Body *CollisionSet::Line(const Point &from, const Point &to, double *closestHit,
 	if(stepY > 0)
 		ry = fullScale - ry;
 	
-	// Keep track of which objects we've already considered.
-	set<const Body *> seen;
+	// Keep track of which objects we've already considered. A line only passes
+	// through a few objects, so a linear search of them is fast enough.
+	seen.clear();
 	while(true)
 	{
 		// Examine all objects in the current grid cell.
-		auto i = (gy & WRAP_MASK) * CELLS + (gx & WRAP_MASK);
-		vector<Entry>::const_iterator it = sorted.begin() + counts[i];
-		vector<Entry>::const_iterator end = sorted.begin() + counts[i + 1];
-		for( ; it != end; ++it)
+		const vector<Entry> &cell = cells[(gy & WRAP_MASK) * CELLS + (gx & WRAP_MASK)].entries;
+		for(auto it = cell.begin(); it != cell.end(); ++it)
 		{
 			// Skip objects that were put in this same grid cell only because
 			// of the cell coordinates wrapping around.
 			if(it->x != gx || it->y != gy)
 				continue;
 			
-			if(seen.count(it->body))
+			if(find(seen.begin(), seen.end(), it->body) != seen.end())
 				continue;
-			seen.insert(it->body);
+			seen.push_back(it->body);
 			
 			// Check if this projectile can hit this object. If either the
 			// projectile or the object has no government, it will always hit.
@@ -313,16 +423,16 @@ Body *CollisionSet::Line(const Point &from, const Point &to, double *closestHit,
 
 
 // Get all objects within the given range of the given point.
-const vector<Body *> &CollisionSet::Circle(const Point &center, double radius) const
+void CollisionSet::Circle(const Point &center, double radius, vector<Body *> &result) const
 {
-	return Ring(center, 0., radius);
+	Ring(center, 0., radius, result);
 }
 
 
 
 // Get all objects touching a ring with a given inner and outer range
 // centered at the given point.
-const vector<Body *> &CollisionSet::Ring(const Point &center, double inner, double outer) const
+void CollisionSet::Ring(const Point &center, double inner, double outer, vector<Body *> &result) const
 {
 	// Calculate the range of (x, y) grid coordinates this ring covers.
 	int minX = static_cast<int>(center.X() - outer) >> SHIFT;
@@ -330,8 +440,6 @@ const vector<Body *> &CollisionSet::Ring(const Point &center, double inner, doub
 	int maxX = static_cast<int>(center.X() + outer) >> SHIFT;
 	int maxY = static_cast<int>(center.Y() + outer) >> SHIFT;
 	
-	// Keep track of which objects we've already considered.
-	set<const Body *> seen;
 	result.clear();
 	for(int y = minY; y <= maxY; ++y)
 	{
@@ -339,29 +447,124 @@ const vector<Body *> &CollisionSet::Ring(const Point &center, double inner, doub
 		for(int x = minX; x <= maxX; ++x)
 		{
 			auto gx = x & WRAP_MASK;
-			auto i = gy * CELLS + gx;
-			vector<Entry>::const_iterator it = sorted.begin() + counts[i];
-			vector<Entry>::const_iterator end = sorted.begin() + counts[i + 1];
+			const Cell &cell = cells[gy * CELLS + gx];
+			const size_t count = cell.entries.size();
 			
-			for( ; it != end; ++it)
+			// First rule out the objects that are too far away or too close,
+			// using only the copies of their positions. Only the objects that
+			// pass that check need to be looked at in detail.
+			for(size_t index = 0; index < count; index += 4)
 			{
-				// Skip objects that were put in this same grid cell only because
-				// of the cell coordinates wrapping around.
-				if(it->x != x || it->y != y)
-					continue;
-				
-				if(seen.count(it->body))
-					continue;
-				seen.insert(it->body);
-				
-				const Mask &mask = it->body->GetMask(step);
-				Point offset = center - it->body->Position();
-				double length = offset.Length();
-				if((length <= outer && length >= inner)
-					|| mask.WithinRing(offset, it->body->Facing(), inner, outer))
-					result.push_back(it->body);
+				unsigned candidates = InRange(cell.x.data(), cell.y.data(), cell.radius.data(), index, count,
+					center.X(), center.Y(), inner, outer);
+				for(size_t i = index; candidates; ++i, candidates >>= 1)
+				{
+					if(!(candidates & 1u))
+						continue;
+					
+					const Entry &entry = cell.entries[i];
+					// Skip objects that were put in this same grid cell only because
+					// of the cell coordinates wrapping around.
+					if(entry.x != x || entry.y != y)
+						continue;
+					
+					// An object that covers several of the cells in range is only
+					// examined in the first of those cells.
+					if(x != max(minX, entry.minX) || y != max(minY, entry.minY))
+						continue;
+					
+					const Mask &mask = entry.body->GetMask(step);
+					Point offset = center - entry.body->Position();
+					double length = offset.Length();
+					if((length <= outer && length >= inner)
+						|| mask.WithinRing(offset, entry.body->Facing(), inner, outer))
+						result.push_back(entry.body);
+				}
 			}
 		}
 	}
-	return result;
+}
+
+
+
+// Add the given object to all the grid cells in the given range.
+void CollisionSet::Place(Body *body, const Range &range, float radius)
+{
+	const Point &position = body->Position();
+	for(int y = range.minY; y <= range.maxY; ++y)
+	{
+		auto gy = y & WRAP_MASK;
+		for(int x = range.minX; x <= range.maxX; ++x)
+		{
+			auto gx = x & WRAP_MASK;
+			Cell &cell = cells[gy * CELLS + gx];
+			cell.entries.emplace_back(body, x, y, range.minX, range.minY);
+			cell.x.push_back(position.X());
+			cell.y.push_back(position.Y());
+			cell.radius.push_back(radius);
+		}
+	}
+}
+
+
+
+// Update the position and radius of an object that has stayed in the same
+// grid cells.
+void CollisionSet::Refresh(const Body *body, const Range &range, float radius)
+{
+	const Point &position = body->Position();
+	for(int y = range.minY; y <= range.maxY; ++y)
+	{
+		auto gy = y & WRAP_MASK;
+		for(int x = range.minX; x <= range.maxX; ++x)
+		{
+			auto gx = x & WRAP_MASK;
+			Cell &cell = cells[gy * CELLS + gx];
+			const size_t i = cell.Find(body, x, y);
+			if(i == cell.entries.size())
+				continue;
+			
+			cell.x[i] = position.X();
+			cell.y[i] = position.Y();
+			cell.radius[i] = radius;
+		}
+	}
+}
+
+
+
+// Remove the given object from all the grid cells in the given range. The other
+// objects in those cells stay in the same order.
+void CollisionSet::Remove(const Body *body, const Range &range)
+{
+	for(int y = range.minY; y <= range.maxY; ++y)
+	{
+		auto gy = y & WRAP_MASK;
+		for(int x = range.minX; x <= range.maxX; ++x)
+		{
+			auto gx = x & WRAP_MASK;
+			Cell &cell = cells[gy * CELLS + gx];
+			const size_t i = cell.Find(body, x, y);
+			if(i == cell.entries.size())
+				continue;
+			
+			cell.entries.erase(cell.entries.begin() + i);
+			cell.x.erase(cell.x.begin() + i);
+			cell.y.erase(cell.y.begin() + i);
+			cell.radius.erase(cell.radius.begin() + i);
+		}
+	}
+}
+
+
+
+// Find the index of the given object's entry in this cell, or the number of
+// entries if it is not in the cell.
+size_t CollisionSet::Cell::Find(const Body *body, int x, int y) const
+{
+	auto it = find_if(entries.begin(), entries.end(), [body, x, y](const Entry &entry) noexcept -> bool
+		{
+			return entry.body == body && entry.x == x && entry.y == y;
+		});
+	return it - entries.begin();
 }
@@ -13,6 +13,8 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef COLLISION_SET_H_
 #define COLLISION_SET_H_
 
+#include <cstddef>
+#include <unordered_map>
 #include <vector>
 
 class Government;
@@ -34,9 +36,16 @@ public:
 	// Clear all objects in the set. Specify which engine step we are on, so we
 	// know what animation frame each object is on.
 	void Clear(int step);
-	// Add an object to the set.
+	// Begin a new step without clearing the set. Every object that should stay
+	// in the set must be added again, but it is only moved to different grid
+	// cells if the ones it covers have changed. Finish() removes any objects
+	// that were not added again.
+	void Update(int step);
+	// Add an object to the set. This also updates the object's animation frame,
+	// so that querying the set afterwards does not modify anything. The object
+	// should not move until the next step.
 	void Add(Body &body);
-	// Finish adding objects (and organize them into the final lookup table).
+	// Finish adding objects (and remove any that were not added again).
 	void Finish();
 	
 	// Get the first object that collides with the given projectile. If a
@@ -53,18 +62,66 @@ public:
 	// centered at the given point.
 	const std::vector<Body *> &Ring(const Point &center, double inner, double outer) const;
 	
+	// Versions of the queries above that use vectors owned by the caller, so
+	// that several threads can query the set at once. The "seen" vector is
+	// only used as scratch space, and query results replace the contents of
+	// the "result" vector. Reusing the same vectors avoids allocating memory.
+	Body *Line(const Projectile &projectile, std::vector<const Body *> &seen, double *closestHit = nullptr) const;
+	Body *Line(const Point &from, const Point &to, std::vector<const Body *> &seen, double *closestHit = nullptr,
+		const Government *pGov = nullptr, const Body *target = nullptr) const;
+	void Circle(const Point &center, double radius, std::vector<Body *> &result) const;
+	void Ring(const Point &center, double inner, double outer, std::vector<Body *> &result) const;
+	
 	
 private:
 	class Entry {
 	public:
-		Entry() = default;
-		Entry(Body *body, int x, int y) : body(body), x(x), y(y) {}
+		Entry(Body *body, int x, int y, int minX, int minY) : body(body), x(x), y(y), minX(minX), minY(minY) {}
 		
 		Body *body;
 		int x;
 		int y;
+		// The first grid cell that this object occupies, so that queries
+		// covering several cells can tell whether they have seen it already.
+		int minX;
+		int minY;
+	};
+	
+	// The objects in one grid cell. Their positions and radii are also copied
+	// into separate arrays, so that the objects that are out of range of a
+	// query can be ruled out several at a time without looking at them.
+	class Cell {
+	public:
+		// Find the index of the given object's entry in this cell, or the number
+		// of entries if it is not in the cell.
+		size_t Find(const Body *body, int x, int y) const;
+		
+		std::vector<Entry> entries;
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> radius;
 	};
 	
+	// The range of grid cells that an object covers.
+	class Range {
+	public:
+		int minX;
+		int minY;
+		int maxX;
+		int maxY;
+		// The last time this object was added to the set.
+		unsigned generation;
+	};
+	
+	
+private:
+	// Add the given object to all the grid cells in the given range.
+	void Place(Body *body, const Range &range, float radius);
+	// Update the position and radius of an object that is still in the same cells.
+	void Refresh(const Body *body, const Range &range, float radius);
+	// Remove the given object from all the grid cells in the given range.
+	void Remove(const Body *body, const Range &range);
+	
 	
 private:
 	// The size of individual cells of the grid.
@@ -79,11 +136,14 @@ private:
 	// The current game engine step.
 	int step;
 	
-	// Vectors to store the objects in the collision set.
-	std::vector<Entry> added;
-	std::vector<Entry> sorted;
-	// After Finish(), counts[index] is where a certain bin begins.
-	std::vector<unsigned> counts;
+	// The objects in each grid cell. Objects stay where they are in a cell
+	// for as long as they keep covering it.
+	std::vector<Cell> cells;
+	// The cells covered by each object in the set.
+	std::unordered_map<const Body *, Range> ranges;
+	// The objects that have been added since the set was cleared or updated.
+	std::vector<Body *> added;
+	unsigned generation = 0;
 	
 	// Vector for returning the result of a circle query.
 	mutable std::vector<Body *> result;
@@ -95,7 +95,7 @@ namespace {
 	}
 	
 	// Test to determine if unsupported operations are requested.
-	bool HasInvalidOperators(const vector<string> &tokens)
+	bool HasInvalidOperators(const DataNode::TokenList &tokens)
 	{
 		static const set<string> invalids = {
 			"{", "}", "[", "]", "|", "^", "&", "!", "~",
@@ -108,7 +108,7 @@ namespace {
 	}
 	
 	// Ensure the ConditionSet line has balanced parentheses on both sides.
-	bool HasUnbalancedParentheses(const vector<string> &tokens)
+	bool HasUnbalancedParentheses(const DataNode::TokenList &tokens)
 	{
 		int parentheses = 0;
 		for(const string &str : tokens)
@@ -129,7 +129,7 @@ namespace {
 	// The final assessment of its validity will be whether it parses into an evaluable Expression.
 	bool IsValidCondition(const DataNode &node)
 	{
-		const vector<string> &tokens = node.Tokens();
+		const DataNode::TokenList tokens = node.Tokens();
 		int assigns = count_if(tokens.begin(), tokens.end(), IsAssignment);
 		int compares = count_if(tokens.begin(), tokens.end(), IsComparison);
 		if(assigns + compares != 1)
@@ -147,33 +147,6 @@ namespace {
 		return false;
 	}
 	
-	// Converts the given vector of condition tokens (like "reputation: Republic",
-	// "random", or "4") into the integral values they have at runtime.
-	vector<int64_t> SubstituteValues(const vector<string> &side, const map<string, int64_t> &conditions, const map<string, int64_t> &created)
-	{
-		auto result = vector<int64_t>();
-		result.reserve(side.size());
-		for(const string &str : side)
-		{
-			int64_t value = 0;
-			if(str == "random")
-				value = Random::Int(100);
-			else if(DataNode::IsNumber(str))
-				value = static_cast<int64_t>(DataNode::Value(str));
-			else
-			{
-				const auto temp = created.find(str);
-				const auto perm = conditions.find(str);
-				if(temp != created.end())
-					value = temp->second;
-				else if(perm != conditions.end())
-					value = perm->second;
-			}
-			result.emplace_back(value);
-		}
-		return result;
-	}
-	
 	bool UsedAll(const vector<bool> &status)
 	{
 		for(auto v : status)
@@ -476,7 +449,7 @@ void ConditionSet::TestApply(const Conditions &conditions, Conditions &created)
 
 // Constructor for complex expressions.
 ConditionSet::Expression::Expression(const vector<string> &left, const string &op, const vector<string> &right)
-	: op(op), fun(Op(op)), left(left), right(right)
+	: op(op), isTestable(IsComparison(op)), fun(Op(op)), left(left), right(right)
 {
 }
 
@@ -484,7 +457,7 @@ ConditionSet::Expression::Expression(const vector<string> &left, const string &o
 
 // Constructor for simple expressions.
 ConditionSet::Expression::Expression(const string &left, const string &op, const string &right)
-	: op(op), fun(Op(op)), left(left), right(right)
+	: op(op), isTestable(IsComparison(op)), fun(Op(op)), left(left), right(right)
 {
 }
 
@@ -530,7 +503,7 @@ string ConditionSet::Expression::Name() const
 // Returns true if the operator is a comparison and false otherwise.
 bool ConditionSet::Expression::IsTestable() const
 {
-	return IsComparison(op);
+	return isTestable;
 }
 
 
@@ -573,6 +546,7 @@ ConditionSet::Expression::SubExpression::SubExpression(const vector<string> &sid
 	
 	ParseSide(side);
 	GenerateSequence();
+	CompileTokens();
 }
 
 
@@ -582,6 +556,7 @@ ConditionSet::Expression::SubExpression::SubExpression(const vector<string> &sid
 ConditionSet::Expression::SubExpression::SubExpression(const string &side)
 {
 	tokens.emplace_back(side.empty() ? "'" : side);
+	CompileTokens();
 }
 
 
@@ -648,19 +623,49 @@ int64_t ConditionSet::Expression::SubExpression::Evaluate(const Conditions &cond
 	if(tokens.empty())
 		return 0;
 	
+	// Substitute the value that the token with the given index has right now.
+	auto valueOf = [&](size_t index) -> int64_t
+	{
+		const Operand &operand = operands[index];
+		if(operand.type == Operand::Type::NUMBER)
+			return operand.value;
+		if(operand.type == Operand::Type::RANDOM)
+			return Random::Int(100);
+		
+		const uint32_t id = static_cast<uint32_t>(operand.value);
+		if(!created.empty())
+		{
+			const int64_t *temp = created.Find(id);
+			if(temp)
+				return *temp;
+		}
+		return conditions.Get(id);
+	};
+	
 	// For SubExpressions with no Operations (i.e. simple conditions), tokens will consist
 	// of only the condition or numeric value to be returned as-is after substitution.
-	auto data = SubstituteValues(tokens, conditions, created);
+	if(sequence.empty())
+		return valueOf(tokens.size() - 1);
 	
-	if(!sequence.empty())
+	// Each Operation adds to the end of the data. Most expressions are short
+	// enough for it to fit in a buffer on the stack.
+	static const size_t BUFFER_SIZE = 32;
+	int64_t buffer[BUFFER_SIZE];
+	vector<int64_t> overflow;
+	int64_t *data = buffer;
+	if(tokens.size() + sequence.size() > BUFFER_SIZE)
 	{
-		// Each Operation adds to the end of the data vector.
-		data.reserve(operatorCount + data.size());
-		for(const Operation &op : sequence)
-			data.emplace_back(op.fun(data[op.a], data[op.b]));
+		overflow.resize(tokens.size() + sequence.size());
+		data = overflow.data();
 	}
 	
-	return data.back();
+	size_t end = 0;
+	for( ; end < tokens.size(); ++end)
+		data[end] = valueOf(end);
+	for(const Operation &op : sequence)
+		data[end++] = op.fun(data[op.a], data[op.b]);
+	
+	return data[end - 1];
 }
 
 
@@ -815,6 +820,29 @@ bool ConditionSet::Expression::SubExpression::AddOperation(vector<int> &data, si
 
 
 
+// Determine what kind of value each token stands for.
+void ConditionSet::Expression::SubExpression::CompileTokens()
+{
+	operands.clear();
+	operands.reserve(tokens.size());
+	for(const string &token : tokens)
+	{
+		operands.emplace_back();
+		Operand &operand = operands.back();
+		if(token == "random")
+			operand.type = Operand::Type::RANDOM;
+		else if(DataNode::IsNumber(token))
+			operand.value = static_cast<int64_t>(DataNode::Value(token));
+		else
+		{
+			operand.type = Operand::Type::CONDITION;
+			operand.value = ConditionsStore::Id(token);
+		}
+	}
+}
+
+
+
 // Constructor for an Operation, indicating the binary function and the
 // indices of its operands within the evaluation-time data vector.
 ConditionSet::Expression::SubExpression::Operation::Operation(const string &op, size_t &a, size_t &b)
@@ -13,7 +13,8 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef CONDITION_SET_H_
 #define CONDITION_SET_H_
 
-#include <map>
+#include "ConditionsStore.h"
+
 #include <string>
 #include <vector>
 
@@ -28,7 +29,7 @@ class DataWriter;
 // values.
 class ConditionSet {
 public:
-	using Conditions = std::map<std::string, int64_t>;
+	using Conditions = ConditionsStore;
 	ConditionSet() = default;
 	// Construct and Load() at the same time.
 	ConditionSet(const DataNode &node);
@@ -117,6 +118,9 @@ private:
 			void ParseSide(const std::vector<std::string> &side);
 			void GenerateSequence();
 			bool AddOperation(std::vector<int> &data, size_t &index, const size_t &opIndex);
+			// Determine what kind of value each token stands for, so that it does
+			// not need to be worked out again every time this is evaluated.
+			void CompileTokens();
 			
 			
 		private:
@@ -131,12 +135,25 @@ private:
 				size_t b;
 			};
 			
+			// An Operand is a token converted into either a number, a random
+			// number, or the name of a condition whose value must be looked up.
+			// For conditions, the value is the ConditionsStore ID of the name.
+			class Operand {
+			public:
+				enum class Type : int {NUMBER, RANDOM, CONDITION};
+				
+				Type type = Type::NUMBER;
+				int64_t value = 0;
+			};
+			
 			
 		private:
 			// Iteration of the sequence vector yields the result.
 			std::vector<Operation> sequence;
 			// The tokens vector converts into a data vector of numeric values during evaluation.
 			std::vector<std::string> tokens;
+			// The kind of value each token stands for.
+			std::vector<Operand> operands;
 			std::vector<std::string> operators;
 			// The number of true (non-parentheses) operators.
 			int operatorCount = 0;
@@ -146,6 +163,8 @@ private:
 	private:
 		// String representation of the Expression's binary function.
 		std::string op;
+		// Whether the operator is a comparison rather than an assignment.
+		bool isTestable = false;
 		// Pointer to a binary function that defines the assignment or
 		// comparison operation to be performed between SubExpressions.
 		int64_t (*fun)(int64_t, int64_t);
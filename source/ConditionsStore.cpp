@@ -0,0 +1,131 @@
+/* ConditionsStore.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "ConditionsStore.h"
+
+#include <mutex>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+	// Condition sets may be loaded on other threads than the ones that use
+	// them, so the table of IDs must be guarded.
+	mutex idMutex;
+	unordered_map<string, uint32_t> ids;
+}
+
+
+
+// Get the ID of the condition with the given name.
+uint32_t ConditionsStore::Id(const string &name)
+{
+	lock_guard<mutex> lock(idMutex);
+	return ids.emplace(name, static_cast<uint32_t>(ids.size())).first->second;
+}
+
+
+
+ConditionsStore::ConditionsStore(initializer_list<value_type> values)
+	: values(values)
+{
+	for(value_type &entry : this->values)
+		SetSlot(entry);
+}
+
+
+
+ConditionsStore::ConditionsStore(const ConditionsStore &other)
+	: values(other.values)
+{
+	for(value_type &entry : values)
+		SetSlot(entry);
+}
+
+
+
+ConditionsStore &ConditionsStore::operator=(const ConditionsStore &other)
+{
+	if(this != &other)
+	{
+		values = other.values;
+		slots.clear();
+		for(value_type &entry : values)
+			SetSlot(entry);
+	}
+	return *this;
+}
+
+
+
+// Get the value of the condition with the given name, creating it if necessary.
+int64_t &ConditionsStore::operator[](const string &name)
+{
+	auto result = values.emplace(name, 0);
+	if(result.second)
+		SetSlot(*result.first);
+	return result.first->second;
+}
+
+
+
+// Add the given condition if it is not in this store yet.
+pair<ConditionsStore::iterator, bool> ConditionsStore::emplace(const string &name, int64_t value)
+{
+	auto result = values.emplace(name, value);
+	if(result.second)
+		SetSlot(*result.first);
+	return result;
+}
+
+
+
+size_t ConditionsStore::erase(const string &name)
+{
+	auto it = values.find(name);
+	if(it == values.end())
+		return 0;
+	erase(it, next(it));
+	return 1;
+}
+
+
+
+ConditionsStore::iterator ConditionsStore::erase(iterator first, iterator last)
+{
+	for(auto it = first; it != last; ++it)
+	{
+		uint32_t id = Id(it->first);
+		if(id < slots.size())
+			slots[id] = nullptr;
+	}
+	return values.erase(first, last);
+}
+
+
+
+void ConditionsStore::clear()
+{
+	values.clear();
+	slots.clear();
+}
+
+
+
+// Remember which entry has the ID of its name.
+void ConditionsStore::SetSlot(value_type &entry)
+{
+	uint32_t id = Id(entry.first);
+	if(id >= slots.size())
+		slots.resize(id + 1, nullptr);
+	slots[id] = &entry;
+}
@@ -0,0 +1,111 @@
+/* ConditionsStore.h
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef CONDITIONS_STORE_H_
+#define CONDITIONS_STORE_H_
+
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+
+// The values of a set of named conditions, such as the player's. It can be used
+// like a std::map from names to values, but every name is also given an ID that
+// is the same for all stores, and each store keeps track of which of its entries
+// has which ID. Code that looks up the same names over and over again, such as a
+// ConditionSet, can get the IDs of the names once and then look the conditions
+// up by ID, which does not need to compare any strings.
+class ConditionsStore {
+public:
+	using Map = std::map<std::string, int64_t>;
+	using value_type = Map::value_type;
+	using iterator = Map::iterator;
+	using const_iterator = Map::const_iterator;
+
+	// Get the ID of the condition with the given name.
+	static uint32_t Id(const std::string &name);
+
+
+public:
+	ConditionsStore() = default;
+	ConditionsStore(std::initializer_list<value_type> values);
+	// The IDs of a copy refer to the copy's own entries.
+	ConditionsStore(const ConditionsStore &other);
+	ConditionsStore &operator=(const ConditionsStore &other);
+	ConditionsStore(ConditionsStore &&other) noexcept = default;
+	ConditionsStore &operator=(ConditionsStore &&other) noexcept = default;
+
+	// Get the value of the condition with the given ID, or a null pointer if
+	// there is no such condition in this store.
+	const int64_t *Find(uint32_t id) const;
+	// Get the value of the condition with the given ID, or 0 if there is no
+	// such condition in this store.
+	int64_t Get(uint32_t id) const;
+
+	// Get the value of the condition with the given name, creating it if necessary.
+	int64_t &operator[](const std::string &name);
+	// Add the given condition if it is not in this store yet.
+	std::pair<iterator, bool> emplace(const std::string &name, int64_t value);
+
+	iterator find(const std::string &name) { return values.find(name); }
+	const_iterator find(const std::string &name) const { return values.find(name); }
+	iterator lower_bound(const std::string &name) { return values.lower_bound(name); }
+	const_iterator lower_bound(const std::string &name) const { return values.lower_bound(name); }
+	size_t count(const std::string &name) const { return values.count(name); }
+
+	size_t erase(const std::string &name);
+	iterator erase(iterator first, iterator last);
+	void clear();
+
+	iterator begin() { return values.begin(); }
+	const_iterator begin() const { return values.begin(); }
+	iterator end() { return values.end(); }
+	const_iterator end() const { return values.end(); }
+	bool empty() const { return values.empty(); }
+	size_t size() const { return values.size(); }
+
+
+private:
+	// Remember which entry has the ID of its name.
+	void SetSlot(value_type &entry);
+
+
+private:
+	Map values;
+	// The entry for each ID, or null if this store has no condition with that
+	// name. Map entries never move, so these stay valid until they are erased.
+	std::vector<value_type *> slots;
+};
+
+
+
+inline const int64_t *ConditionsStore::Find(uint32_t id) const
+{
+	const value_type *entry = (id < slots.size() ? slots[id] : nullptr);
+	return entry ? &entry->second : nullptr;
+}
+
+
+
+inline int64_t ConditionsStore::Get(uint32_t id) const
+{
+	const int64_t *value = Find(id);
+	return value ? *value : 0;
+}
+
+
+
+#endif
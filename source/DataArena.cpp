@@ -0,0 +1,114 @@
+/* DataArena.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "DataArena.h"
+
+using namespace std;
+
+namespace {
+	// The root of an arena that nothing has been laid out in.
+	const DataNode EMPTY;
+}
+
+
+
+// Lay out the nodes described by the given records.
+void DataArena::Link(const vector<Record> &records)
+{
+	nodes.clear();
+	nodes.resize(records.size());
+	const string *token = tokens.data();
+	for(size_t i = 0; i < records.size(); ++i)
+	{
+		const Record &record = records[i];
+		DataNode &node = nodes[i];
+		node.tokens = token;
+		node.tokenCount = record.tokenCount;
+		node.lineNumber = record.lineNumber;
+		node.descendants = nodes.data() + i + 1;
+		node.descendantCount = record.descendantCount;
+		node.parent = (record.parent == NO_PARENT ? nullptr : &nodes[record.parent]);
+		token += record.tokenCount;
+	}
+}
+
+
+
+// Copy the given node and all its descendants into this arena. The copy of
+// the node becomes the root, so it does not remember its parent.
+void DataArena::Assign(const DataNode &node)
+{
+	// The given node is either part of an arena, or is a copy that keeps the
+	// first node of its own arena in the same place as its descendants would be.
+	const DataNode *first = node.descendants - 1;
+	const DataNode *last = node.descendants + node.descendantCount - 1;
+	const string *firstToken = node.tokens;
+	tokens.assign(firstToken, last->tokens + last->tokenCount);
+
+	nodes.clear();
+	nodes.resize(node.descendantCount + 1);
+	for(size_t i = 0; i < nodes.size(); ++i)
+	{
+		const DataNode &source = (i ? first[i] : node);
+		DataNode &copy = nodes[i];
+		copy.tokens = tokens.data() + (source.tokens - firstToken);
+		copy.tokenCount = source.tokenCount;
+		copy.lineNumber = source.lineNumber;
+		copy.descendants = nodes.data() + i + 1;
+		copy.descendantCount = source.descendantCount;
+		copy.parent = (i ? nodes.data() + (source.parent - first) : nullptr);
+	}
+}
+
+
+
+// Describe the node with the given index in terms of indices.
+DataArena::Record DataArena::Describe(uint32_t index) const noexcept
+{
+	const DataNode &node = nodes[index];
+	const uint32_t parent = node.parent ? node.parent - nodes.data() : NO_PARENT;
+	return {node.tokenCount, node.descendantCount, parent, node.lineNumber};
+}
+
+
+
+// Check that the given records describe a tree, in which each node is followed
+// by its descendants, so that iterating through it stays within the arena.
+bool DataArena::IsValid(const vector<Record> &records, size_t tokenCount) noexcept
+{
+	if(records.empty() || records[0].parent != NO_PARENT || records[0].descendantCount != records.size() - 1)
+		return false;
+
+	// Keep track of the nodes that the current one is nested in.
+	vector<uint32_t> stack(1, 0);
+	size_t tokens = records[0].tokenCount;
+	for(uint32_t i = 1; i < records.size(); ++i)
+	{
+		while(i > stack.back() + records[stack.back()].descendantCount)
+			stack.pop_back();
+		const Record &record = records[i];
+		const Record &parent = records[stack.back()];
+		if(record.parent != stack.back() || record.descendantCount > stack.back() + parent.descendantCount - i)
+			return false;
+		stack.push_back(i);
+		tokens += record.tokenCount;
+	}
+	return tokens == tokenCount;
+}
+
+
+
+// Get the root node of the tree.
+const DataNode &DataArena::Root() const noexcept
+{
+	return nodes.empty() ? EMPTY : nodes.front();
+}
@@ -0,0 +1,79 @@
+/* DataArena.h
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef DATA_ARENA_H_
+#define DATA_ARENA_H_
+
+#include "DataNode.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+
+// The storage of a tree of DataNodes. Instead of allocating each node and its
+// tokens separately, all the nodes are stored in one contiguous, depth-first
+// array in which each node is followed by its descendants, and all the tokens
+// in another, so filling in an arena only needs a handful of allocations (plus
+// one for each token that is too long to be stored inside its std::string).
+// The first node is the root of the tree.
+class DataArena {
+public:
+	// A description of a node in terms of indices, which is used to lay out the
+	// nodes and to store them in the DataFileCache.
+	struct Record {
+		uint32_t tokenCount;
+		uint32_t descendantCount;
+		uint32_t parent;
+		uint32_t lineNumber;
+	};
+	static const uint32_t NO_PARENT = UINT32_MAX;
+
+
+public:
+	DataArena() noexcept = default;
+	// The nodes refer to each other and to the tokens, so an arena cannot be
+	// copied, but moving it does not move the nodes or the tokens.
+	DataArena(const DataArena &) = delete;
+	DataArena &operator=(const DataArena &) = delete;
+	DataArena(DataArena &&) noexcept = default;
+	DataArena &operator=(DataArena &&) noexcept = default;
+
+	// Lay out the nodes described by the given records, which must be in depth
+	// first order, with the tokens of each node following those of the nodes
+	// before it. The tokens must already have been filled in.
+	void Link(const std::vector<Record> &records);
+	// Copy the given node and all its descendants into this arena.
+	void Assign(const DataNode &node);
+	// Describe the node with the given index.
+	Record Describe(uint32_t index) const noexcept;
+	// Check that the given records describe a tree that can be laid out with
+	// the given number of tokens.
+	static bool IsValid(const std::vector<Record> &records, size_t tokenCount) noexcept;
+
+	// The root node of the tree, which is empty if nothing has been laid out.
+	const DataNode &Root() const noexcept;
+
+
+private:
+	std::vector<std::string> tokens;
+	std::vector<DataNode> nodes;
+
+	// Allow the parser and the cache to fill in the tokens directly.
+	friend class DataFile;
+	friend class DataFileCache;
+};
+
+
+
+#endif
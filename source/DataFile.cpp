@@ -12,6 +12,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #include "DataFile.h"
 
+#include "DataFileCache.h"
 #include "Files.h"
 #include "text/Utf8.h"
 
@@ -40,17 +41,16 @@ void DataFile::Load(const string &path)
 {
 	string data = Files::Read(path);
 	if(data.empty())
+	{
+		LoadData(data, string());
 		return;
+	}
 	
 	// As a sentinel, make sure the file always ends in a newline.
-	if(data.empty() || data.back() != '\n')
+	if(data.back() != '\n')
 		data.push_back('\n');
 	
-	// Note what file this node is in, so it will show up in error traces.
-	root.tokens.push_back("file");
-	root.tokens.push_back(path);
-	
-	LoadData(data);
+	LoadData(data, path);
 }
 
 
@@ -72,39 +72,76 @@ void DataFile::Load(istream &in)
 	if(data.empty() || data.back() != '\n')
 		data.push_back('\n');
 	
-	LoadData(data);
+	LoadData(data, string());
+}
+
+
+
+// Load from a file path, skipping the parsing if the file is in the cache.
+void DataFile::LoadCached(const string &path)
+{
+	if(DataFileCache::Read(path, *this))
+	{
+		PrintWarnings();
+		return;
+	}
+	
+	Load(path);
+	DataFileCache::Write(path, *this);
 }
 
 
 
 // Get an iterator to the start of the list of nodes in this file.
-list<DataNode>::const_iterator DataFile::begin() const
+DataNode::Iterator DataFile::begin() const
 {
-	return root.begin();
+	return arena.Root().begin();
 }
 
 
 
 // Get an iterator to the end of the list of nodes in this file.
-list<DataNode>::const_iterator DataFile::end() const
+DataNode::Iterator DataFile::end() const
 {
-	return root.end();
+	return arena.Root().end();
 }
 
 
 
 // Parse the given text.
-void DataFile::LoadData(const string &data)
+void DataFile::LoadData(const string &data, const string &path)
 {
+	vector<string> &tokens = arena.tokens;
+	tokens.clear();
+	warnings.clear();
+	
+	// Note what file this node is in, so it will show up in error traces.
+	vector<DataArena::Record> records(1, {0, 0, DataArena::NO_PARENT, 0});
+	if(!path.empty())
+	{
+		tokens.emplace_back("file");
+		tokens.push_back(path);
+		records.back().tokenCount = 2;
+	}
+	
 	// Keep track of the current stack of indentation levels and the most recent
 	// node at each level - that is, the node that will be the "parent" of any
 	// new node added at the next deeper indentation level.
-	vector<DataNode *> stack(1, &root);
+	vector<uint32_t> stack(1, 0);
 	vector<int> whiteStack(1, -1);
 	bool fileIsSpaces = false;
 	bool warned = false;
 	size_t lineNumber = 0;
 	
+	// A node's descendants have all been read once a node at the same or a lower
+	// indentation level is found, which is when it is removed from the stack.
+	auto pop = [&records, &stack, &whiteStack]() -> void
+	{
+		records[stack.back()].descendantCount = records.size() - stack.back() - 1;
+		stack.pop_back();
+		whiteStack.pop_back();
+	};
+	
 	size_t end = data.length();
 	for(size_t pos = 0; pos < end; )
 	{
@@ -122,7 +159,7 @@ void DataFile::LoadData(const string &data)
 			{
 				// If we've parsed whitespace that wasn't a space, issue a warning.
 				if(white)
-					stack.back()->PrintTrace("Mixed whitespace usage in line");
+					warnings.push_back({stack.back(), "Mixed whitespace usage in line"});
 				else
 					fileIsSpaces = true;
 				
@@ -131,7 +168,7 @@ void DataFile::LoadData(const string &data)
 			else if(fileIsSpaces && !warned && c != ' ')
 			{
 				warned = true;
-				stack.back()->PrintTrace("Mixed whitespace usage in file");
+				warnings.push_back({stack.back(), "Mixed whitespace usage in file"});
 			}
 			
 			++white;
@@ -150,19 +187,14 @@ void DataFile::LoadData(const string &data)
 		// Determine where in the node tree we are inserting this node, based on
 		// whether it has more indentation that the previous node, less, or the same.
 		while(whiteStack.back() >= white)
-		{
-			whiteStack.pop_back();
-			stack.pop_back();
-		}
+			pop();
 		
 		// Add this node as a child of the proper node.
-		list<DataNode> &children = stack.back()->children;
-		children.emplace_back(stack.back());
-		DataNode &node = children.back();
-		node.lineNumber = lineNumber;
+		const uint32_t index = records.size();
+		records.push_back({0, 0, stack.back(), static_cast<uint32_t>(lineNumber)});
 		
 		// Remember where in the tree we are.
-		stack.push_back(&node);
+		stack.push_back(index);
 		whiteStack.push_back(white);
 		
 		// Tokenize the line. Skip comments and empty lines.
@@ -191,12 +223,13 @@ void DataFile::LoadData(const string &data)
 			// range, but it appears that some libraries do not handle that case
 			// correctly. So:
 			if(tokenPos == endPos)
-				node.tokens.emplace_back();
+				tokens.emplace_back();
 			else
-				node.tokens.emplace_back(data, tokenPos, endPos - tokenPos);
+				tokens.emplace_back(data, tokenPos, endPos - tokenPos);
+			++records[index].tokenCount;
 			// This is not a fatal error, but it may indicate a format mistake:
 			if(isQuoted && c == '\n')
-				node.PrintTrace("Closing quotation mark is missing:");
+				warnings.push_back({index, "Closing quotation mark is missing:"});
 			
 			if(c != '\n')
 			{
@@ -222,7 +255,22 @@ void DataFile::LoadData(const string &data)
 				}
 			}
 		}
-		// Now that we've reached the end of the line, we know no more tokens will be added to the node.
-		node.tokens.shrink_to_fit();
 	}
+	while(!stack.empty())
+		pop();
+	
+	// Now that all the tokens have been read, they will no longer move, so the
+	// nodes can refer to them.
+	tokens.shrink_to_fit();
+	arena.Link(records);
+	PrintWarnings();
+}
+
+
+
+// Print the warnings that were found while parsing the file.
+void DataFile::PrintWarnings() const
+{
+	for(const Warning &warning : warnings)
+		arena.nodes[warning.node].PrintTrace(warning.message);
 }
@@ -13,11 +13,13 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef DATA_FILE_H_
 #define DATA_FILE_H_
 
+#include "DataArena.h"
 #include "DataNode.h"
 
+#include <cstdint>
 #include <istream>
-#include <list>
 #include <string>
+#include <vector>
 
 
 
@@ -27,6 +29,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 // it, it is a "child" of that node. Otherwise, it is a "sibling." Each node is
 // just a collection of one or more tokens that can be interpreted either as
 // strings or as floating point values; see DataNode for more information.
+// All the nodes of a file are stored in a single DataArena.
 class DataFile {
 public:
 	// A DataFile can be loaded either from a file path or an istream.
@@ -36,19 +39,37 @@ public:
 	
 	void Load(const std::string &path);
 	void Load(std::istream &in);
+	// Load from a file path, using the DataFileCache copy of the parsed file
+	// if it is up to date, and updating the cache otherwise.
+	void LoadCached(const std::string &path);
 	
 	// Functions for iterating through all DataNodes in this file.
-	std::list<DataNode>::const_iterator begin() const;
-	std::list<DataNode>::const_iterator end() const;
+	DataNode::Iterator begin() const;
+	DataNode::Iterator end() const;
 	
 	
 private:
-	void LoadData(const std::string &data);
+	void LoadData(const std::string &data, const std::string &path);
+	// Print the warnings that were found while parsing the file.
+	void PrintWarnings() const;
 	
 	
 private:
-	// This is the container for all DataNodes in this file.
-	DataNode root;
+	// A problem with the format of the file that was found while parsing it,
+	// and the node that it was found in. These are remembered so that they are
+	// printed again when the file is loaded from the cache.
+	struct Warning {
+		uint32_t node;
+		std::string message;
+	};
+	
+	// This is the container for all DataNodes in this file. The first node is
+	// the root, which holds the file name (if any) and the top level nodes.
+	DataArena arena;
+	std::vector<Warning> warnings;
+	
+	// Allow the cache to read and write the parsed file directly.
+	friend class DataFileCache;
 };
 
 
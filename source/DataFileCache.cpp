@@ -0,0 +1,338 @@
+/* DataFileCache.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "DataFileCache.h"
+
+#include "DataArena.h"
+#include "DataFile.h"
+#include "Files.h"
+
+#if !defined _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <set>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// Bump the version whenever the layout of the cached files changes.
+	const uint32_t MAGIC = 0x43445345;
+	const uint32_t VERSION = 4;
+	// Some file systems only store modification times to the nearest second or
+	// two, so a data file that is changed again right after it was cached might
+	// still look like the same file. Files that were modified this recently (in
+	// seconds) are not cached until they are loaded again later on.
+	const int64_t RACY_TIME = 2;
+
+	// The first part of every cached file. It is followed by the path of the
+	// data file, the characters of all the unique tokens, the token ranges, the
+	// node records of the arena and finally the arena's warnings, each of which
+	// is a node index and the length of the message followed by the message.
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint64_t size;
+		// The modification time of the data file, in nanoseconds.
+		int64_t timestamp;
+		uint32_t pathLength;
+		uint32_t bufferLength;
+		uint32_t tokenCount;
+		uint32_t nodeCount;
+		uint32_t warningCount;
+	};
+
+	// Where the text of a token is stored in the cached file.
+	struct TokenRange {
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	string directory;
+	// The cached files that belong to data files that were loaded in this
+	// session. Any others are for data files that no longer exist.
+	mutex usedMutex;
+	set<string> used;
+
+
+#if !defined _WIN32
+	// Get the path at which the cached copy of the given data file is stored.
+	string CachePath(const string &path)
+	{
+		return directory + Files::CacheName(path) + ".data";
+	}
+
+
+	// Remember that the cached copy of a data file is still in use.
+	void MarkUsed(const string &cachePath)
+	{
+		lock_guard<mutex> lock(usedMutex);
+		used.insert(cachePath);
+	}
+
+
+	// RAII wrapper for a read-only memory map of an entire file.
+	class MappedFile {
+	public:
+		explicit MappedFile(const string &path)
+		{
+			int fd = open(path.c_str(), O_RDONLY);
+			if(fd < 0)
+				return;
+			struct stat buf;
+			if(!fstat(fd, &buf) && buf.st_size > 0)
+			{
+				void *map = mmap(nullptr, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if(map != MAP_FAILED)
+				{
+					data = static_cast<const char *>(map);
+					size = buf.st_size;
+				}
+			}
+			close(fd);
+		}
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator=(const MappedFile &) = delete;
+		~MappedFile()
+		{
+			if(data)
+				munmap(const_cast<char *>(data), size);
+		}
+
+		const char *data = nullptr;
+		size_t size = 0;
+	};
+
+
+	// Helper for reading the sections of a cached file, with bounds checking
+	// so that a truncated or corrupt cache is rejected instead of crashing.
+	class Reader {
+	public:
+		Reader(const char *data, size_t size) : data(data), size(size) {}
+
+		// Get a pointer to the next section of the given number of bytes.
+		const char *Take(size_t bytes)
+		{
+			if(bytes > size - pos)
+				return nullptr;
+			const char *result = data + pos;
+			pos += bytes;
+			return result;
+		}
+		// Read the next number.
+		bool Read(uint32_t &value)
+		{
+			const char *section = Take(sizeof(value));
+			if(section)
+				memcpy(&value, section, sizeof(value));
+			return section;
+		}
+		// Get the number of bytes that have not been read yet.
+		size_t Remaining() const
+		{
+			return size - pos;
+		}
+
+	private:
+		const char *data;
+		size_t size;
+		size_t pos = 0;
+	};
+#endif
+}
+
+
+
+// Set the directory in which the cached files are stored.
+void DataFileCache::Init(const string &directory)
+{
+	Files::CreateNewDirectory(directory);
+	::directory = directory;
+	lock_guard<mutex> lock(usedMutex);
+	used.clear();
+}
+
+
+
+// Fill in the given file with the cached contents of the given data file.
+bool DataFileCache::Read(const string &path, DataFile &file)
+{
+#if !defined _WIN32
+	if(directory.empty())
+		return false;
+
+	uint64_t size;
+	int64_t timestamp;
+	if(!Files::Stat(path, size, timestamp))
+		return false;
+
+	const string cachePath = CachePath(path);
+	MarkUsed(cachePath);
+	MappedFile mapped(cachePath);
+	Reader reader(mapped.data, mapped.size);
+	Header header;
+	const char *section = reader.Take(sizeof(header));
+	if(!section)
+		return false;
+	memcpy(&header, section, sizeof(header));
+	if(header.magic != MAGIC || header.version != VERSION || header.size != size || header.timestamp != timestamp)
+		return false;
+	// Make sure this is not a different file with the same hash.
+	section = reader.Take(header.pathLength);
+	if(!section || path.compare(0, string::npos, section, header.pathLength))
+		return false;
+
+	const char *buffer = reader.Take(header.bufferLength);
+	const char *ranges = reader.Take(header.tokenCount * sizeof(TokenRange));
+	const char *nodes = reader.Take(header.nodeCount * sizeof(DataArena::Record));
+	if(!buffer || !ranges || !nodes || !header.nodeCount)
+		return false;
+
+	vector<DataArena::Record> records(header.nodeCount);
+	memcpy(records.data(), nodes, header.nodeCount * sizeof(DataArena::Record));
+	// Reject anything that points outside of the file or that does not describe
+	// a tree, so that a corrupt cache cannot cause out of bounds accesses.
+	if(!DataArena::IsValid(records, header.tokenCount))
+		return false;
+
+	DataFile result;
+	vector<string> &tokens = result.arena.tokens;
+	tokens.reserve(header.tokenCount);
+	for(uint32_t i = 0; i < header.tokenCount; ++i)
+	{
+		TokenRange token;
+		memcpy(&token, ranges + i * sizeof(TokenRange), sizeof(token));
+		if(token.offset > header.bufferLength || token.length > header.bufferLength - token.offset)
+			return false;
+		tokens.emplace_back(buffer + token.offset, token.length);
+	}
+
+	// Each warning takes up at least the space for its node index and length.
+	if(header.warningCount > reader.Remaining() / (2 * sizeof(uint32_t)))
+		return false;
+	result.warnings.resize(header.warningCount);
+	for(DataFile::Warning &warning : result.warnings)
+	{
+		uint32_t length = 0;
+		if(!reader.Read(warning.node) || warning.node >= header.nodeCount || !reader.Read(length))
+			return false;
+		section = reader.Take(length);
+		if(!section)
+			return false;
+		warning.message.assign(section, length);
+	}
+
+	result.arena.Link(records);
+	file = std::move(result);
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+
+// Store the parsed contents of the given data file in the cache.
+void DataFileCache::Write(const string &path, const DataFile &file)
+{
+#if !defined _WIN32
+	Header header = {};
+	header.magic = MAGIC;
+	header.version = VERSION;
+	if(directory.empty() || !Files::Stat(path, header.size, header.timestamp))
+		return;
+	const string cachePath = CachePath(path);
+	MarkUsed(cachePath);
+	// A file that was modified just now may be modified again without its
+	// timestamp changing, so it is not safe to cache it yet.
+	if(header.timestamp / 1000000000 + RACY_TIME > time(nullptr))
+		return;
+
+	// Only store the text of the tokens, rather than the whole file, and store
+	// each unique token only once.
+	const DataArena &arena = file.arena;
+	unordered_map<string_view, uint32_t> offsets;
+	string buffer;
+	vector<TokenRange> tokens;
+	tokens.reserve(arena.tokens.size());
+	for(const string &token : arena.tokens)
+	{
+		auto it = offsets.emplace(token, buffer.size()).first;
+		if(it->second == buffer.size())
+			buffer += token;
+		tokens.push_back({it->second, static_cast<uint32_t>(token.size())});
+	}
+	vector<DataArena::Record> records;
+	records.reserve(arena.nodes.size());
+	for(uint32_t i = 0; i < arena.nodes.size(); ++i)
+		records.push_back(arena.Describe(i));
+
+	header.pathLength = path.size();
+	header.bufferLength = buffer.size();
+	header.tokenCount = tokens.size();
+	header.nodeCount = records.size();
+	header.warningCount = file.warnings.size();
+
+	string data;
+	data.reserve(sizeof(header) + path.size() + buffer.size() + tokens.size() * sizeof(TokenRange)
+		+ records.size() * sizeof(DataArena::Record));
+	data.append(reinterpret_cast<const char *>(&header), sizeof(header));
+	data.append(path);
+	data.append(buffer);
+	data.append(reinterpret_cast<const char *>(tokens.data()), tokens.size() * sizeof(TokenRange));
+	data.append(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(DataArena::Record));
+	for(const DataFile::Warning &warning : file.warnings)
+	{
+		const uint32_t length = warning.message.size();
+		data.append(reinterpret_cast<const char *>(&warning.node), sizeof(warning.node));
+		data.append(reinterpret_cast<const char *>(&length), sizeof(length));
+		data.append(warning.message);
+	}
+
+	// Write to a temporary file first, so that a cached file is never seen
+	// half written (e.g. if the game is closed while it is being written).
+	Files::Write(cachePath + ".tmp", data);
+	Files::Move(cachePath + ".tmp", cachePath);
+#endif
+}
+
+
+
+// Delete the cached copies of any data files that were not loaded in this
+// session, e.g. because they or the plugins they were in have been removed.
+void DataFileCache::Prune()
+{
+#if !defined _WIN32
+	if(directory.empty())
+		return;
+
+	lock_guard<mutex> lock(usedMutex);
+	for(const string &path : Files::List(directory))
+	{
+		const bool isCache = path.size() > 5 && !path.compare(path.size() - 5, 5, ".data");
+		const bool isTemporary = path.size() > 9 && !path.compare(path.size() - 9, 9, ".data.tmp");
+		if((isCache && !used.count(path)) || isTemporary)
+			Files::Delete(path);
+	}
+#endif
+}
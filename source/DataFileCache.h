@@ -0,0 +1,47 @@
+/* DataFileCache.h
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef DATA_FILE_CACHE_H_
+#define DATA_FILE_CACHE_H_
+
+#include <string>
+
+class DataFile;
+
+
+
+// Class that stores the parsed node trees of data files on disk, in a binary
+// format that can be read back much faster than the text can be tokenized. Each
+// cached file holds the unique tokens in the file followed by the token ranges
+// and node records of its DataArena, and any warnings from parsing it, which are
+// printed again when it is read. A cached copy is only used if the size and the
+// modification time (to the nanosecond) of the data file it was made from have
+// not changed.
+class DataFileCache {
+public:
+	// Set the directory in which the cached files are stored. Nothing is
+	// cached until this has been called.
+	static void Init(const std::string &directory);
+
+	// Fill in the given file with the cached contents of the given data file.
+	// Returns false if there is no up to date copy in the cache.
+	static bool Read(const std::string &path, DataFile &file);
+	// Store the parsed contents of the given data file in the cache.
+	static void Write(const std::string &path, const DataFile &file);
+	// Delete the cached copies of any data files that have not been read or
+	// written since the cache was initialized.
+	static void Prune();
+};
+
+
+
+#endif
@@ -12,6 +12,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #include "DataNode.h"
 
+#include "DataArena.h"
 #include "Files.h"
 
 #include <algorithm>
@@ -23,69 +24,94 @@ using namespace std;
 
 
 // Construct a DataNode and remember what its parent is.
-DataNode::DataNode(const DataNode *parent) noexcept(false)
+DataNode::DataNode(const DataNode *parent) noexcept
 	: parent(parent)
 {
-	// To avoid a lot of memory reallocation, have every node start out with
-	// capacity for four tokens. This makes file loading slightly faster, at the
-	// cost of DataFiles taking up a bit more memory.
-	tokens.reserve(4);
 }
 
 
 
 // Copy constructor.
 DataNode::DataNode(const DataNode &other)
-	: children(other.children), tokens(other.tokens), lineNumber(other.lineNumber)
 {
-	Reparent();
+	*this = other;
 }
 
 
 
-// Copy assignment operator.
+// Copy assignment operator. The copy does not remember the parent of the
+// node it was copied from.
 DataNode &DataNode::operator=(const DataNode &other)
 {
-	children = other.children;
-	tokens = other.tokens;
-	lineNumber = other.lineNumber;
-	Reparent();
+	if(this == &other)
+		return *this;
+	
+	// A node that was never filled in has nothing to copy.
+	if(!other.descendants)
+	{
+		*this = DataNode();
+		return *this;
+	}
+	
+	unique_ptr<DataArena> copy(new DataArena);
+	copy->Assign(other);
+	const DataNode &root = copy->Root();
+	tokens = root.tokens;
+	tokenCount = root.tokenCount;
+	lineNumber = root.lineNumber;
+	descendants = root.descendants;
+	descendantCount = root.descendantCount;
+	parent = nullptr;
+	arena = std::move(copy);
 	return *this;
 }
 
 
 
 DataNode::DataNode(DataNode &&other) noexcept
-	: children(std::move(other.children)), tokens(std::move(other.tokens)), lineNumber(std::move(other.lineNumber))
 {
-	Reparent();
+	*this = std::move(other);
 }
 
 
 
 DataNode &DataNode::operator=(DataNode &&other) noexcept
 {
-	children.swap(other.children);
-	tokens.swap(other.tokens);
-	lineNumber = std::move(other.lineNumber);
-	Reparent();
+	if(this == &other)
+		return *this;
+	
+	tokens = other.tokens;
+	tokenCount = other.tokenCount;
+	lineNumber = other.lineNumber;
+	descendants = other.descendants;
+	descendantCount = other.descendantCount;
+	arena = std::move(other.arena);
+	other.tokens = nullptr;
+	other.tokenCount = 0;
+	other.descendants = nullptr;
+	other.descendantCount = 0;
 	return *this;
 }
 
 
 
+// The arena, if any, must be complete to be destroyed.
+DataNode::~DataNode() noexcept = default;
+
+
+
 // Get the number of tokens in this line of the data file.
 int DataNode::Size() const noexcept
 {
-	return tokens.size();
+	return tokenCount;
 }
 
 
 
 // Get all tokens.
-const vector<string> &DataNode::Tokens() const noexcept
+DataNode::TokenList DataNode::Tokens() const noexcept
 {
-	return tokens;
+	return TokenList(tokens, tokenCount);
 }
 
 
@@ -103,7 +129,7 @@ const string &DataNode::Token(int index) const
 double DataNode::Value(int index) const
 {
 	// Check for empty strings and out-of-bounds indices.
-	if(static_cast<size_t>(index) >= tokens.size() || tokens[index].empty())
+	if(static_cast<uint32_t>(index) >= tokenCount || tokens[index].empty())
 		PrintTrace("Requested token index (" + to_string(index) + ") is out of bounds:");
 	else if(!IsNumber(tokens[index]))
 		PrintTrace("Cannot convert value \"" + tokens[index] + "\" to a number:");
@@ -172,7 +198,7 @@ double DataNode::Value(const string &token)
 bool DataNode::IsNumber(int index) const
 {
 	// Make sure this token exists and is not empty.
-	if(static_cast<size_t>(index) >= tokens.size() || tokens[index].empty())
+	if(static_cast<uint32_t>(index) >= tokenCount || tokens[index].empty())
 		return false;
 	
 	return IsNumber(tokens[index]);
@@ -221,23 +247,23 @@ bool DataNode::IsNumber(const string &token)
 // Check if this node has any children.
 bool DataNode::HasChildren() const noexcept
 {
-	return !children.empty();
+	return descendantCount;
 }
 
 
 
-// Iterator to the beginning of the list of children.
-list<DataNode>::const_iterator DataNode::begin() const noexcept
+// Iterator to the first child.
+DataNode::Iterator DataNode::begin() const noexcept
 {
-	return children.begin();
+	return Iterator(descendants);
 }
 
 
 
-// Iterator to the end of the list of children.
-list<DataNode>::const_iterator DataNode::end() const noexcept
+// Iterator to the end of the children.
+DataNode::Iterator DataNode::end() const noexcept
 {
-	return children.end();
+	return Iterator(descendants + descendantCount);
 }
 
 
@@ -257,15 +283,15 @@ int DataNode::PrintTrace(const string &message) const
 	size_t indent = 0;
 	if(parent)
 		indent = parent->PrintTrace() + 2;
-	if(tokens.empty())
+	if(!tokenCount)
 		return indent;
 	
 	// Convert this node back to tokenized text, with quotes used as necessary.
 	string line = !parent ? "" : "L" + to_string(lineNumber) + ": ";
 	line.append(string(indent, ' '));
-	for(const string &token : tokens)
+	for(const string &token : Tokens())
 	{
-		if(&token != &tokens.front())
+		if(&token != tokens)
 			line += ' ';
 		bool hasSpace = any_of(token.begin(), token.end(), [](char c) { return isspace(c); });
 		bool hasQuote = any_of(token.begin(), token.end(), [](char c) { return (c == '"'); });
@@ -280,15 +306,3 @@ int DataNode::PrintTrace(const string &message) const
 	// Tell the caller what indentation level we're at now.
 	return indent;
 }
-
-
-
-// Adjust the parent pointers when a copy is made of a DataNode.
-void DataNode::Reparent() noexcept
-{
-	for(DataNode &child : children)
-	{
-		child.parent = this;
-		child.Reparent();
-	}
-}
@@ -13,9 +13,13 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef DATA_NODE_H_
 #define DATA_NODE_H_
 
-#include <list>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
 #include <string>
-#include <vector>
+
+class DataArena;
 
 
 
@@ -25,21 +29,75 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 // The tokens of a node are separated by white space, with quotation marks being
 // used to group multiple words into a single token. If the token text contains
 // quotation marks, it should be enclosed in backticks instead.
+// All the nodes of a file are stored in one DataArena, in which each node is
+// directly followed by its descendants and the tokens of all the nodes are
+// stored in order, so a node only refers to its part of the arena. A copy of a
+// node does not belong to a file, so it keeps its own arena.
 class DataNode {
+public:
+	// Iterator over the children of a node, which skips each child's descendants.
+	class Iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = DataNode;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const DataNode *;
+		using reference = const DataNode &;
+		
+		Iterator() noexcept = default;
+		
+		const DataNode &operator*() const noexcept;
+		const DataNode *operator->() const noexcept;
+		Iterator &operator++() noexcept;
+		Iterator operator++(int) noexcept;
+		bool operator==(const Iterator &other) const noexcept;
+		bool operator!=(const Iterator &other) const noexcept;
+		
+	private:
+		explicit Iterator(const DataNode *node) noexcept;
+		
+	private:
+		const DataNode *node = nullptr;
+		
+		friend class DataNode;
+	};
+	
+	// The tokens of a node, which can be iterated over and indexed like a vector.
+	class TokenList {
+	public:
+		const std::string *begin() const noexcept;
+		const std::string *end() const noexcept;
+		size_t size() const noexcept;
+		bool empty() const noexcept;
+		const std::string &operator[](size_t index) const noexcept;
+		
+	private:
+		TokenList(const std::string *first, uint32_t count) noexcept;
+		
+	private:
+		const std::string *first;
+		uint32_t count;
+		
+		friend class DataNode;
+	};
+	
+	
 public:
 	// Construct a DataNode. For the purpose of printing stack traces, each node
 	// must remember what its parent node is.
-	explicit DataNode(const DataNode *parent = nullptr) noexcept(false);
-	// Copying or moving a DataNode requires updating the parent pointers.
+	explicit DataNode(const DataNode *parent = nullptr) noexcept;
+	// Copying a DataNode copies its tokens and all its descendants into a new
+	// arena. Moving one hands over its arena, if it has one.
 	DataNode(const DataNode &other);
 	DataNode &operator=(const DataNode &other);
 	DataNode(DataNode &&) noexcept;
 	DataNode &operator=(DataNode &&) noexcept;
+	~DataNode() noexcept;
 	
 	// Get the number of tokens in this node.
 	int Size() const noexcept;
-	// Get all the tokens in this node as an iterable vector.
-	const std::vector<std::string> &Tokens() const noexcept;
+	// Get all the tokens in this node as an iterable list.
+	TokenList Tokens() const noexcept;
 	// Get the token at the given index. No bounds checking is done internally.
 	// DataFile loading guarantees index 0 always exists.
 	const std::string &Token(int index) const;
@@ -55,32 +113,129 @@ public:
 	// Check if this node has any children. If so, the iterator functions below
 	// can be used to access them.
 	bool HasChildren() const noexcept;
-	std::list<DataNode>::const_iterator begin() const noexcept;
-	std::list<DataNode>::const_iterator end() const noexcept;
+	Iterator begin() const noexcept;
+	Iterator end() const noexcept;
 	
 	// Print a message followed by a "trace" of this node and its parents.
 	int PrintTrace(const std::string &message = "") const;
 	
 	
 private:
-	// Adjust the parent pointers when a copy is made of a DataNode.
-	void Reparent() noexcept;
-	
-	
-private:
-	// These are "child" nodes found on subsequent lines with deeper indentation.
-	std::list<DataNode> children;
-	// These are the tokens found in this particular line of the data file.
-	std::vector<std::string> tokens;
+	// These are the tokens found in this particular line of the data file,
+	// followed by those of its descendants.
+	const std::string *tokens = nullptr;
+	uint32_t tokenCount = 0;
+	// The line number in the given file that produced this node.
+	uint32_t lineNumber = 0;
+	// These are the nodes found on subsequent lines with deeper indentation,
+	// and their own descendants, in the order that they appear in the file.
+	const DataNode *descendants = nullptr;
+	uint32_t descendantCount = 0;
 	// The parent pointer is used only for printing stack traces.
 	const DataNode *parent = nullptr;
-	// The line number in the given file that produced this node.
-	size_t lineNumber = 0;
+	// The arena that a copy of a node keeps its tokens and descendants in. The
+	// first node in it is a copy of this one.
+	std::unique_ptr<DataArena> arena;
 	
-	// Allow DataFile to modify the internal structure of DataNodes.
-	friend class DataFile;
+	// Allow DataArena to lay out the nodes of a file.
+	friend class DataArena;
 };
 
 
 
+inline const DataNode &DataNode::Iterator::operator*() const noexcept
+{
+	return *node;
+}
+
+
+
+inline const DataNode *DataNode::Iterator::operator->() const noexcept
+{
+	return node;
+}
+
+
+
+// Advance to the next sibling, which comes after all of this node's descendants.
+inline DataNode::Iterator &DataNode::Iterator::operator++() noexcept
+{
+	node += 1 + node->descendantCount;
+	return *this;
+}
+
+
+
+inline DataNode::Iterator DataNode::Iterator::operator++(int) noexcept
+{
+	Iterator result = *this;
+	++*this;
+	return result;
+}
+
+
+
+inline bool DataNode::Iterator::operator==(const Iterator &other) const noexcept
+{
+	return node == other.node;
+}
+
+
+
+inline bool DataNode::Iterator::operator!=(const Iterator &other) const noexcept
+{
+	return node != other.node;
+}
+
+
+
+inline DataNode::Iterator::Iterator(const DataNode *node) noexcept
+	: node(node)
+{
+}
+
+
+
+inline const std::string *DataNode::TokenList::begin() const noexcept
+{
+	return first;
+}
+
+
+
+inline const std::string *DataNode::TokenList::end() const noexcept
+{
+	return first + count;
+}
+
+
+
+inline size_t DataNode::TokenList::size() const noexcept
+{
+	return count;
+}
+
+
+
+inline bool DataNode::TokenList::empty() const noexcept
+{
+	return !count;
+}
+
+
+
+inline const std::string &DataNode::TokenList::operator[](size_t index) const noexcept
+{
+	return first[index];
+}
+
+
+
+inline DataNode::TokenList::TokenList(const std::string *first, uint32_t count) noexcept
+	: first(first), count(count)
+{
+}
+
+
+
 #endif
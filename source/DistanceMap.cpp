@@ -63,7 +63,7 @@ DistanceMap::DistanceMap(const PlayerInfo &player, const System *center)
 // ship will use a jump drive or hyperdrive depending on what it has. The
 // pathfinding will stop once a path to the destination is found.
 DistanceMap::DistanceMap(const Ship &ship, const System *destination)
-	: source(ship.GetSystem()), center(destination)
+	: source(ship.GetSystem()), center(destination), toCenter(true)
 {
 	if(!source || !destination)
 		return;
@@ -73,6 +73,16 @@ DistanceMap::DistanceMap(const Ship &ship, const System *destination)
 
 
 
+// Find the paths from every system to the given destination for the given
+// ship, without stopping once the ship's own system is reached.
+DistanceMap::DistanceMap(const System *destination, const Ship &ship)
+	: center(destination), toCenter(true)
+{
+	Init(&ship);
+}
+
+
+
 // Find out if the given system is reachable.
 bool DistanceMap::HasRoute(const System *system) const
 {
@@ -219,9 +229,9 @@ void DistanceMap::Init(const Ship *ship)
 			for(const StellarObject &object : top.next->Objects())
 				if(object.HasSprite() && object.HasValidPlanet() && object.GetPlanet()->IsWormhole())
 				{
-					// If we're seeking a path toward a "source," travel through
-					// wormholes in the reverse of the normal direction.
-					const System &link = source ?
+					// If we're seeking paths that end at the center, travel
+					// through wormholes in the reverse of the normal direction.
+					const System &link = toCenter ?
 						*object.GetPlanet()->WormholeSource(top.next) :
 						*object.GetPlanet()->WormholeDestination(top.next);
 					if(HasBetter(link, top))
@@ -232,8 +242,13 @@ void DistanceMap::Init(const Ship *ship)
 					// the wormhole and both endpoint systems. (If this is a
 					// multi-stop wormhole, you may know about some paths that
 					// it takes but not others.)
-					if(ship && !object.GetPlanet()->IsAccessible(ship))
-						continue;
+					if(ship)
+					{
+						bool isAccessible = object.GetPlanet()->IsAccessible(ship);
+						wormholes.emplace_back(object.GetPlanet(), isAccessible);
+						if(!isAccessible)
+							continue;
+					}
 					if(player && !player->HasVisited(*object.GetPlanet()))
 						continue;
 					if(player && !(player->HasVisited(*top.next) && player->HasVisited(link)))
@@ -17,7 +17,9 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <queue>
 #include <set>
 #include <utility>
+#include <vector>
 
+class Planet;
 class PlayerInfo;
 class Ship;
 class System;
@@ -59,6 +61,15 @@ public:
 	int RequiredFuel(const System *system1, const System *system2) const;
 	
 	
+private:
+	// Find the paths from every system to the given destination for the given
+	// ship, without stopping once the ship's own system is reached. The route
+	// cache stores these so that other ships with the same drives can use them.
+	DistanceMap(const System *destination, const Ship &ship);
+	
+	friend class RouteCache;
+	
+	
 private:
 	// For each system, track how much fuel it will take to get there, how many
 	// days, how much danger you will pass through, and where you will go next.
@@ -97,12 +108,18 @@ private:
 	
 private:
 	std::map<const System *, Edge> route;
+	// Each wormhole whose accessibility to the ship affected the routes, and
+	// whether the ship was able to use it.
+	std::vector<std::pair<const Planet *, bool>> wormholes;
 	
 	// Variables only used during construction:
 	std::priority_queue<Edge> edges;
 	const PlayerInfo *player = nullptr;
 	const System *source = nullptr;
 	const System *center = nullptr;
+	// If true, the center is where the routes end rather than where they begin,
+	// so wormholes must be traveled through in the reverse direction.
+	bool toCenter = false;
 	int maxCount = -1;
 	int maxDistance = -1;
 	// How much fuel is used for travel. If either value is zero, it means that
@@ -94,13 +94,7 @@ bool DrawList::AddSwizzled(const Body &body, int swizzle)
 // Draw all the items in this list.
 void DrawList::Draw() const
 {
-	SpriteShader::Bind();
-	
-	bool withBlur = Preferences::Has("Render motion blur");
-	for(const SpriteShader::Item &item : items)
-		SpriteShader::Add(item, withBlur);
-	
-	SpriteShader::Unbind();
+	SpriteShader::Draw(items, Preferences::Has("Render motion blur"));
 }
 
 
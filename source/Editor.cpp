@@ -47,6 +47,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <cassert>
 #include <cstdint>
 #include <map>
+#include <unordered_set>
 
 using namespace std;
 
@@ -100,139 +101,117 @@ void Editor::WriteAll()
 	if(!HasPlugin())
 		return;
 
-	const auto &effects = effectEditor.Changes();
-	const auto &fleets = fleetEditor.Changes();
-	const auto &galaxies = galaxyEditor.Changes();
-	const auto &hazards = hazardEditor.Changes();
-	const auto &governments = governmentEditor.Changes();
-	const auto &outfits = outfitEditor.Changes();
-	const auto &outfitters = outfitterEditor.Changes();
-	const auto &planets = planetEditor.Changes();
-	const auto &ships = shipEditor.Changes();
-	const auto &shipyards = shipyardEditor.Changes();
-	const auto &systems = systemEditor.Changes();
-
-	// Save every change made to this plugin.
-	for(auto &&file : pluginPaths)
+	// Only rewrite the files that contain objects that changed since they were
+	// last written.
+	for(const string &path : dirtyFiles)
 	{
-		DataWriter writer(file.first);
+		auto file = pluginPaths.find(path);
+		if(file == pluginPaths.end())
+			continue;
 
-		for(auto &&pair : file.second)
+		// Write to a temporary file first, so that an interrupted save never
+		// leaves a half written file behind.
+		const string temporary = path + ".tmp";
 		{
-			const string &type = pair.first;
-			const string &toSearch = pair.second;
-			if(type == "planet")
-			{
-				auto it = find_if(planets.begin(), planets.end(),
-						[&toSearch](const Planet &p) { return p.TrueName() == toSearch; });
-				if(it != planets.end())
-					planetEditor.WriteToFile(writer, &*it);
-				else
-					continue;
-			}
-			else if(type == "ship")
-			{
-				auto it = find_if(ships.begin(), ships.end(),
-						[&toSearch](const Ship &s) { return s.TrueName() == toSearch; });
-				if(it != ships.end())
-					shipEditor.WriteToFile(writer, &*it);
-				else
-					continue;
-			}
-			else if(type == "system")
-			{
-				auto it = find_if(systems.begin(), systems.end(),
-						[&toSearch](const System &sys) { return sys.Name() == toSearch; });
-				if(it != systems.end())
-					systemEditor.WriteToFile(writer, &*it);
-				else
-					continue;
-			}
-			else if(type == "outfit")
-			{
-				auto it = find_if(outfits.begin(), outfits.end(),
-						[&toSearch](const Outfit &o) { return o.Name() == toSearch; });
-				if(it != outfits.end())
-					outfitEditor.WriteToFile(writer, &*it);
-				else
-					continue;
-			}
-			else if(type == "hazard")
-			{
-				auto it = find_if(hazards.begin(), hazards.end(),
-						[&toSearch](const Hazard &h) { return h.Name() == toSearch; });
-				if(it != hazards.end())
-					hazardEditor.WriteToFile(writer, &*it);
-				else
-					continue;
-			}
-			else if(type == "government")
-			{
-				auto it = find_if(governments.begin(), governments.end(),
-						[&toSearch](const Government &g) { return g.TrueName() == toSearch; });
-				if(it != governments.end())
-					governmentEditor.WriteToFile(writer, &*it);
-				else
-					continue;
-			}
-			else if(type == "fleet")
-			{
-				auto it = find_if(fleets.begin(), fleets.end(),
-						[&toSearch](const Fleet &f) { return f.Name() == toSearch; });
-				if(it != fleets.end())
-					fleetEditor.WriteToFile(writer, &*it);
-				else
-					continue;
-			}
-			else if(type == "outfitter")
-			{
-				auto it = find_if(outfitters.begin(), outfitters.end(),
-						[&toSearch](const Sale<Outfit> &o) { return o.Name() == toSearch; });
-				if(it != outfitters.end())
-					outfitterEditor.WriteToFile(writer, &*it);
-				else
-					continue;
-			}
-			else if(type == "shipyard")
-			{
-				auto it = find_if(shipyards.begin(), shipyards.end(),
-						[&toSearch](const Sale<Ship> &s) { return s.Name() == toSearch; });
-				if(it != shipyards.end())
-					shipyardEditor.WriteToFile(writer, &*it);
-				else
-					continue;
-			}
-			else if(type == "effect")
-			{
-				auto it = find_if(effects.begin(), effects.end(),
-						[&toSearch](const Effect &e) { return e.Name() == toSearch; });
-				if(it != effects.end())
-					effectEditor.WriteToFile(writer, &*it);
-				else
-					continue;
-			}
-			else if(type == "galaxy")
+			DataWriter writer(temporary);
+
+			for(auto &&pair : file->second)
 			{
-				auto it = find_if(galaxies.begin(), galaxies.end(),
-						[&toSearch](const Galaxy &g) { return g.Name() == toSearch; });
-				if(it != galaxies.end())
-					galaxyEditor.WriteToFile(writer, &*it);
+				const string &type = pair.first;
+				const string &toSearch = pair.second;
+				if(type == "planet")
+				{
+					if(const auto *it = planetEditor.FindChange(toSearch))
+						planetEditor.WriteToFile(writer, it);
+					else
+						continue;
+				}
+				else if(type == "ship")
+				{
+					if(const auto *it = shipEditor.FindChange(toSearch))
+						shipEditor.WriteToFile(writer, it);
+					else
+						continue;
+				}
+				else if(type == "system")
+				{
+					if(const auto *it = systemEditor.FindChange(toSearch))
+						systemEditor.WriteToFile(writer, it);
+					else
+						continue;
+				}
+				else if(type == "outfit")
+				{
+					if(const auto *it = outfitEditor.FindChange(toSearch))
+						outfitEditor.WriteToFile(writer, it);
+					else
+						continue;
+				}
+				else if(type == "hazard")
+				{
+					if(const auto *it = hazardEditor.FindChange(toSearch))
+						hazardEditor.WriteToFile(writer, it);
+					else
+						continue;
+				}
+				else if(type == "government")
+				{
+					if(const auto *it = governmentEditor.FindChange(toSearch))
+						governmentEditor.WriteToFile(writer, it);
+					else
+						continue;
+				}
+				else if(type == "fleet")
+				{
+					if(const auto *it = fleetEditor.FindChange(toSearch))
+						fleetEditor.WriteToFile(writer, it);
+					else
+						continue;
+				}
+				else if(type == "outfitter")
+				{
+					if(const auto *it = outfitterEditor.FindChange(toSearch))
+						outfitterEditor.WriteToFile(writer, it);
+					else
+						continue;
+				}
+				else if(type == "shipyard")
+				{
+					if(const auto *it = shipyardEditor.FindChange(toSearch))
+						shipyardEditor.WriteToFile(writer, it);
+					else
+						continue;
+				}
+				else if(type == "effect")
+				{
+					if(const auto *it = effectEditor.FindChange(toSearch))
+						effectEditor.WriteToFile(writer, it);
+					else
+						continue;
+				}
+				else if(type == "galaxy")
+				{
+					if(const auto *it = galaxyEditor.FindChange(toSearch))
+						galaxyEditor.WriteToFile(writer, it);
+					else
+						continue;
+				}
 				else
-					continue;
-			}
-			else
-			{
-				// If we are here then we encountered an object to save that we don't support yet.
-				// In that case, we save the version in the game memory.
-				auto it= unimplementedNodes.find(pair);
-				assert(it != unimplementedNodes.end());
-				writer.Write(it->second);
-			}
+				{
+					// If we are here then we encountered an object to save that we don't support yet.
+					// In that case, we save the version in the game memory.
+					auto it= unimplementedNodes.find(pair);
+					assert(it != unimplementedNodes.end());
+					writer.Write(*it->second);
+				}
 
-			// Add an empty newline between nodes.
-			writer.Write();
+				// Add an empty newline between nodes.
+				writer.Write();
+			}
 		}
+		Files::Move(temporary, path);
 	}
+	dirtyFiles.clear();
 }
 
 
@@ -292,13 +271,20 @@ UI &Editor::GetMenu()
 
 void Editor::RenameObject(const std::string &type, const std::string &oldName, const std::string &newName)
 {
-	for(auto &&file : pluginPaths)
-		for(auto &&object : file.second)
-			if(object.first == type && object.second == oldName)
-			{
-				object.second = newName;
-				break;
-			}
+	auto it = nodeFiles.find(make_pair(type, oldName));
+	if(it == nodeFiles.end())
+		return;
+
+	const string file = std::move(it->second);
+	nodeFiles.erase(it);
+	for(auto &&object : pluginPaths[file])
+		if(object.first == type && object.second == oldName)
+		{
+			object.second = newName;
+			break;
+		}
+	nodeFiles.emplace(make_pair(type, newName), file);
+	dirtyFiles.insert(file);
 }
 
 
@@ -655,7 +641,19 @@ void Editor::ReloadPluginResources()
 
 void AddNode(Editor &editor, const std::string &file, const std::string &key, const std::string &name)
 {
-	editor.pluginPaths[editor.currentPlugin + "data/" + file].emplace_back(std::make_pair(key, name));
+	const string path = editor.currentPlugin + "data/" + file;
+	editor.pluginPaths[path].emplace_back(std::make_pair(key, name));
+	editor.nodeFiles.emplace(std::make_pair(key, name), path);
+	editor.dirtyFiles.insert(path);
+}
+
+
+
+void MarkChanged(Editor &editor, const std::string &key, const std::string &name)
+{
+	auto it = editor.nodeFiles.find(std::make_pair(key, name));
+	if(it != editor.nodeFiles.end())
+		editor.dirtyFiles.insert(it->second);
 }
 
 
@@ -683,7 +681,9 @@ void Editor::OpenPlugin(const string &plugin)
 		return;
 
 	pluginPaths.clear();
+	nodeFiles.clear();
 	unimplementedNodes.clear();
+	pluginData.reset();
 
 	// Special case: If we didn't load a plugin yet don't discard changes.
 	if(!currentPlugin.empty())
@@ -704,25 +704,19 @@ void Editor::OpenPlugin(const string &plugin)
 	currentPlugin = path;
 	currentPluginName = plugin;
 
-	GameData::baseEffects.clear();
-	GameData::baseFleets.clear();
-	GameData::baseGalaxies.clear();
-	GameData::baseHazards.clear();
-	GameData::baseGovernments.clear();
-	GameData::baseOutfits.clear();
-	GameData::baseOutfitSales.clear();
-	GameData::baseShips.clear();
-	GameData::baseShipSales.clear();
-	GameData::baseSystems.clear();
-	GameData::basePlanets.clear();
+	// This only reloads the other plugins, on top of the base game data.
 	GameData::LoadData(&currentPlugin);
 	player.PartialLoad();
 
 	// We need to save everything the specified plugin loads.
-	auto files = Files::RecursiveList(path + "data/");
-	for(const auto &file : files)
+	auto files = GameData::PluginFiles(path);
+	pluginData = std::move(files.second);
+	// Every node that has been seen so far, to find any duplicates.
+	unordered_set<pair<string, string>, HashPairOfStrings> seen;
+	for(size_t i = 0; i < files.first.size(); ++i)
 	{
-		DataFile data(file);
+		const string &file = files.first[i];
+		const DataFile &data = (*pluginData)[i];
 		for(const auto &node : data)
 		{
 			const string &key = node.Token(0);
@@ -737,8 +731,11 @@ void Editor::OpenPlugin(const string &plugin)
 				// We might have a variant instead of a normal ship definition.
 				if(node.Size() >= 3)
 				{
-					shipEditor.WriteToPlugin(GameData::Ships().Get(node.Token(2)), false);
-					pluginPaths[file].emplace_back(key, node.Token(2));
+					const string &variant = node.Token(2);
+					shipEditor.WriteToPlugin(GameData::Ships().Get(variant), false);
+					pluginPaths[file].emplace_back(key, variant);
+					nodeFiles.emplace(make_pair(key, variant), file);
+					seen.emplace(key, variant);
 					continue;
 				}
 				else
@@ -763,26 +760,20 @@ void Editor::OpenPlugin(const string &plugin)
 			else if(key == "galaxy")
 				galaxyEditor.WriteToPlugin(GameData::Galaxies().Get(value), false);
 			else
-				unimplementedNodes.emplace(std::make_pair(key, value), node);
+				unimplementedNodes.emplace(std::make_pair(key, value), &node);
 
-			bool alreadyExists = false;
-			for(const auto &file : pluginPaths)
-			{
-				for(const auto &pair : file.second)
-					if(key != "phrase" && pair.first == key && pair.second == value)
-					{
-						alreadyExists = true;
-						break;
-					}
-				if(alreadyExists)
-					break;
-			}
+			const bool alreadyExists = !seen.emplace(key, value).second && key != "phrase";
 			if(alreadyExists)
 				node.PrintTrace("Duplicate node found. This is only partially supported by the game (and by this editor) so it is recommended to avoid duplicating nodes.");
 			else
+			{
 				pluginPaths[file].emplace_back(key, value);
+				nodeFiles.emplace(make_pair(key, value), file);
+			}
 		}
 	}
+	// Nothing has changed yet, so there is nothing to write.
+	dirtyFiles.clear();
 }
 
 
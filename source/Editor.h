@@ -13,6 +13,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef EDITOR_H_
 #define EDITOR_H_
 
+#include "DataFile.h"
 #include "EffectEditor.h"
 #include "FleetEditor.h"
 #include "GalaxyEditor.h"
@@ -30,6 +31,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class Body;
@@ -62,7 +64,7 @@ public:
 
 	// Saves every unsaved changes to the current plugin if any.
 	void SaveAll();
-	// Writes the plugin to a file.
+	// Writes the files of the plugin that have changed since they were last written.
 	void WriteAll();
 
 	void RenderMain();
@@ -122,9 +124,17 @@ private:
 	bool showPlanetMenu = false;
 
 	std::unordered_map<std::string, std::vector<std::pair<std::string, std::string>>> pluginPaths;
-	std::unordered_map<std::pair<std::string, std::string>, DataNode, HashPairOfStrings> unimplementedNodes;
+	// The parsed files of the current plugin, which the nodes that the editor
+	// doesn't support yet refer to.
+	std::shared_ptr<const std::vector<DataFile>> pluginData;
+	std::unordered_map<std::pair<std::string, std::string>, const DataNode *, HashPairOfStrings> unimplementedNodes;
+	// The file that each node of the plugin is written to, and the files that
+	// contain nodes that have changed since they were last written.
+	std::unordered_map<std::pair<std::string, std::string>, std::string, HashPairOfStrings> nodeFiles;
+	std::unordered_set<std::string> dirtyFiles;
 
 	friend void AddNode(Editor &editor, const std::string &file, const std::string &key, const std::string &name);
+	friend void MarkChanged(Editor &editor, const std::string &key, const std::string &name);
 };
 
 
@@ -189,13 +189,27 @@ namespace {
 		}
 	}
 	
+	// Begin loading the landscapes of the systems next to the given one, in
+	// case the player travels to one of them next.
+	void PreloadNeighbors(const System &system)
+	{
+		for(const System *neighbor : system.Links())
+			for(const StellarObject &object : neighbor->Objects())
+				if(object.HasValidPlanet())
+					GameData::Preload(object.GetPlanet()->Landscape(), true);
+	}
+	
 	const double RADAR_SCALE = .025;
+	
+	// Split the collision checks into this many batches per thread, so that a
+	// thread that is done with its batch early can help with the others.
+	const size_t COLLISION_BATCHES = 4;
 }
 
 
 
 Engine::Engine(PlayerInfo &player)
-	: player(player), ai(ships, asteroids.Minables(), flotsam),
+	: player(player), ai(ships, asteroids.Minables(), flotsam, workers),
 	shipCollisions(256u, 32u)
 {
 	zoom = Preferences::ViewZoom();
@@ -212,6 +226,7 @@ Engine::Engine(PlayerInfo &player)
 	for(const StellarObject &object : player.GetSystem()->Objects())
 		if(object.HasSprite() && object.HasValidPlanet())
 			GameData::Preload(object.GetPlanet()->Landscape());
+	PreloadNeighbors(*player.GetSystem());
 	
 	// Figure out what planet the player is landed on, if any.
 	const StellarObject *object = player.GetStellarObject();
@@ -1213,6 +1228,7 @@ void Engine::EnterSystem()
 					&& flagship->Position().Distance(object.Position()) < 1.)
 				usedWormhole = &object;
 		}
+	PreloadNeighbors(*system);
 	
 	// Advance the positions of every StellarObject and update politics.
 	// Remove expired bribes, clearance, and grace periods from past fines.
@@ -1461,8 +1477,7 @@ void Engine::CalculateStep()
 	FillCollisionSets();
 	
 	// Perform collision detection.
-	for(Projectile &projectile : projectiles)
-		DoCollisions(projectile);
+	DoCollisions();
 	// Now that collision detection is done, clear the cache of ships with anti-
 	// missile systems ready to fire.
 	hasAntiMissile.clear();
@@ -1658,7 +1673,9 @@ void Engine::MoveShip(const shared_ptr<Ship> &ship)
 // Populate the ship collision detection set for projectile & flotsam computations.
 void Engine::FillCollisionSets()
 {
-	shipCollisions.Clear(step);
+	// Ships that were in the set last step only need to be moved to different
+	// grid cells if they have moved far enough to reach them.
+	shipCollisions.Update(step);
 	for(const shared_ptr<Ship> &it : ships)
 		if(it->GetSystem() == player.GetSystem() && it->Zoom() == 1.)
 			shipCollisions.Add(*it);
@@ -1983,22 +2000,59 @@ void Engine::HandleMouseClicks()
 
 
 
-// Perform collision detection. Note that unlike the preceding functions, this
-// one adds any visuals that are created directly to the main visuals list. If
-// this is multi-threaded in the future, that will need to change.
-void Engine::DoCollisions(Projectile &projectile)
+// Perform collision detection. Figuring out what each projectile hits does not
+// change anything, so that is done for all of them at once. Then, the hits are
+// applied one projectile at a time, in the same order as always.
+void Engine::DoCollisions()
+{
+	// Objects update their animation frame the first time their collision mask
+	// is needed in each step. The collision sets take care of that for all the
+	// objects in them, but the target of a phasing projectile may not be in any.
+	for(const Projectile &projectile : projectiles)
+		if(projectile.GetWeapon().IsPhasing())
+		{
+			shared_ptr<Ship> target = projectile.TargetPtr();
+			if(target)
+				target->GetFrame(step);
+		}
+	
+	collisions.resize(projectiles.size());
+	collisionBuffers.resize(COLLISION_BATCHES * workers.Concurrency());
+	const size_t batches = min(projectiles.size(), collisionBuffers.size());
+	if(batches)
+	{
+		const size_t batchSize = (projectiles.size() + batches - 1) / batches;
+		workers.ForEach(batches, [this, batchSize](size_t batch)
+		{
+			CollisionBuffers &buffers = collisionBuffers[batch];
+			const size_t end = min(projectiles.size(), (batch + 1) * batchSize);
+			for(size_t i = batch * batchSize; i < end; ++i)
+				FindCollision(projectiles[i], collisions[i], buffers);
+		});
+	}
+	
+	for(size_t i = 0; i < projectiles.size(); ++i)
+		DoCollisions(projectiles[i], collisions[i]);
+}
+
+
+
+// Find what the given projectile hits during this step. This only reads the
+// state of the game, so it may be called from several threads at once.
+void Engine::FindCollision(const Projectile &projectile, Collision &collision, CollisionBuffers &buffers) const
 {
 	// The asteroids can collide with projectiles, the same as any other
 	// object. If the asteroid turns out to be closer than the ship, it
 	// shields the ship (unless the projectile has a blast radius).
-	Point hitVelocity;
-	double closestHit = 1.;
-	shared_ptr<Ship> hit;
+	collision.closestHit = 1.;
+	collision.hitVelocity = Point();
+	collision.hit = nullptr;
+	collision.minable = nullptr;
 	const Government *gov = projectile.GetGovernment();
 	
 	// If this "projectile" is a ship explosion, it always explodes.
 	if(!gov)
-		closestHit = 0.;
+		collision.closestHit = 0.;
 	else if(projectile.GetWeapon().IsPhasing() && projectile.Target())
 	{
 		// "Phasing" projectiles that have a target will never hit any other ship.
@@ -2006,11 +2060,11 @@ void Engine::DoCollisions(Projectile &projectile)
 		if(target)
 		{
 			Point offset = projectile.Position() - target->Position();
-			double range = target->GetMask(step).Collide(offset, projectile.Velocity(), target->Facing());
+			double range = target->GetMask().Collide(offset, projectile.Velocity(), target->Facing());
 			if(range < 1.)
 			{
-				closestHit = range;
-				hit = target;
+				collision.closestHit = range;
+				collision.hit = target.get();
 			}
 		}
 	}
@@ -2019,22 +2073,25 @@ void Engine::DoCollisions(Projectile &projectile)
 		// For weapons with a trigger radius, check if any detectable object will set it off.
 		double triggerRadius = projectile.GetWeapon().TriggerRadius();
 		if(triggerRadius)
-			for(const Body *body : shipCollisions.Circle(projectile.Position(), triggerRadius))
+		{
+			shipCollisions.Circle(projectile.Position(), triggerRadius, buffers.nearby);
+			for(const Body *body : buffers.nearby)
 				if(body == projectile.Target() || (gov->IsEnemy(body->GetGovernment())
 						&& reinterpret_cast<const Ship *>(body)->Cloaking() < 1.))
 				{
-					closestHit = 0.;
+					collision.closestHit = 0.;
 					break;
 				}
+		}
 		
 		// If nothing triggered the projectile, check for collisions with ships.
-		if(closestHit > 0.)
+		if(collision.closestHit > 0.)
 		{
-			Ship *ship = reinterpret_cast<Ship *>(shipCollisions.Line(projectile, &closestHit));
+			Ship *ship = reinterpret_cast<Ship *>(shipCollisions.Line(projectile, buffers.seen, &collision.closestHit));
 			if(ship)
 			{
-				hit = ship->shared_from_this();
-				hitVelocity = ship->Velocity();
+				collision.hit = ship;
+				collision.hitVelocity = ship->Velocity();
 			}
 		}
 		// "Phasing" projectiles can pass through asteroids. For all other
@@ -2042,21 +2099,35 @@ void Engine::DoCollisions(Projectile &projectile)
 		// ship that they have hit.
 		if(!projectile.GetWeapon().IsPhasing())
 		{
-			Body *asteroid = asteroids.Collide(projectile, &closestHit);
+			Body *asteroid = asteroids.Collide(projectile, &collision.closestHit, buffers.seen, &collision.minable);
 			if(asteroid)
 			{
-				hitVelocity = asteroid->Velocity();
-				hit.reset();
+				collision.hitVelocity = asteroid->Velocity();
+				collision.hit = nullptr;
 			}
 		}
 	}
+}
+
+
+
+// Apply what the given projectile hit. Note that unlike the preceding functions,
+// this one adds any visuals that are created directly to the main visuals list.
+void Engine::DoCollisions(Projectile &projectile, const Collision &collision)
+{
+	const double closestHit = collision.closestHit;
+	shared_ptr<Ship> hit = collision.hit ? collision.hit->shared_from_this() : nullptr;
+	const Government *gov = projectile.GetGovernment();
+	
+	if(collision.minable)
+		collision.minable->TakeDamage(projectile);
 	
 	// Check if the projectile hit something.
 	if(closestHit < 1.)
 	{
 		// Create the explosion the given distance along the projectile's
 		// motion path for this step.
-		projectile.Explode(visuals, closestHit, hitVelocity);
+		projectile.Explode(visuals, closestHit, collision.hitVelocity);
 		
 		// If this projectile has a blast radius, find all ships within its
 		// radius. Otherwise, only one is damaged.
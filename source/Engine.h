@@ -24,6 +24,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Point.h"
 #include "Radar.h"
 #include "Rectangle.h"
+#include "ThreadPool.h"
 
 #include <condition_variable>
 #include <list>
@@ -35,8 +36,10 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <utility>
 #include <vector>
 
+class Body;
 class Flotsam;
 class Government;
+class Minable;
 class NPC;
 class Outfit;
 class PlanetLabel;
@@ -115,7 +118,7 @@ private:
 	
 	void FillCollisionSets();
 	
-	void DoCollisions(Projectile &projectile);
+	void DoCollisions();
 	void DoWeather(Weather &weather);
 	void DoCollection(Flotsam &flotsam);
 	void DoScanning(const std::shared_ptr<Ship> &ship);
@@ -150,6 +153,28 @@ private:
 		double angle;
 	};
 	
+	// What a projectile hits during this step.
+	class Collision {
+	public:
+		double closestHit;
+		Point hitVelocity;
+		Ship *hit;
+		Minable *minable;
+	};
+	
+	// Vectors that the collision queries can reuse, so they only need to
+	// allocate memory the first few times they are used.
+	class CollisionBuffers {
+	public:
+		std::vector<Body *> nearby;
+		std::vector<const Body *> seen;
+	};
+	
+	
+private:
+	void FindCollision(const Projectile &projectile, Collision &collision, CollisionBuffers &buffers) const;
+	void DoCollisions(Projectile &projectile, const Collision &collision);
+	
 	
 private:
 	PlayerInfo &player;
@@ -169,7 +194,14 @@ private:
 	
 	// Track which ships currently have anti-missiles ready to fire.
 	std::vector<Ship *> hasAntiMissile;
-	
+	// What each projectile hits during this step. The collision checks are
+	// split into batches, each with its own buffers, so they can be done in
+	// parallel.
+	std::vector<Collision> collisions;
+	std::vector<CollisionBuffers> collisionBuffers;
+	
+	// Worker threads that the calculation thread can spread its work over.
+	ThreadPool workers;
 	AI ai;
 	
 #ifndef ES_NO_THREADS
@@ -429,6 +429,31 @@ time_t Files::Timestamp(const string &filePath)
 
 
 
+// Get the size and the modification time of the given file.
+bool Files::Stat(const string &filePath, uint64_t &size, int64_t &timestamp)
+{
+#if defined _WIN32
+	struct _stat64 buf;
+	if(_wstat64(Utf8::ToUTF16(filePath).c_str(), &buf))
+		return false;
+	timestamp = buf.st_mtime * INT64_C(1000000000);
+#else
+	struct stat buf;
+	if(stat(filePath.c_str(), &buf))
+		return false;
+#ifdef __APPLE__
+	const timespec &modified = buf.st_mtimespec;
+#else
+	const timespec &modified = buf.st_mtim;
+#endif
+	timestamp = modified.tv_sec * INT64_C(1000000000) + modified.tv_nsec;
+#endif
+	size = buf.st_size;
+	return true;
+}
+
+
+
 void Files::Copy(const string &from, const string &to)
 {
 #if defined _WIN32
@@ -472,6 +497,27 @@ string Files::Name(const string &path)
 
 
 
+// Get the name under which something made from the file at the given path is
+// stored in a cache. This uses its own hash (64-bit FNV-1a) rather than
+// std::hash, so that the name is the same no matter how the game was built.
+string Files::CacheName(const string &path)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for(char c : path)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+	
+	static const char HEX[] = "0123456789abcdef";
+	string name(16, '0');
+	for(int i = 15; i >= 0; --i, hash >>= 4)
+		name[i] = HEX[hash & 15];
+	return name;
+}
+
+
+
 void Files::CreateNewDirectory(const string &path)
 {
 #if defined _WIN32
@@ -547,6 +593,24 @@ void Files::Write(FILE *file, const string &data)
 
 
 
+// Write data to a file exactly as given. Files opened for writing are otherwise
+// in text mode on Windows, which would turn every '\n' byte into "\r\n".
+void Files::WriteBinary(const string &path, const string &data)
+{
+#if defined _WIN32
+	FILE *file = _wfopen(Utf8::ToUTF16(path).c_str(), L"wb");
+#else
+	FILE *file = fopen(path.c_str(), "wb");
+#endif
+	if(!file)
+		return;
+	
+	Write(file, data);
+	fclose(file);
+}
+
+
+
 void Files::LogError(const string &message)
 {
 	lock_guard<mutex> lock(errorMutex);
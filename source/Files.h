@@ -13,6 +13,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef FILES_H_
 #define FILES_H_
 
+#include <cstdint>
 #include <cstdio>
 #include <ctime>
 #include <string>
@@ -50,12 +51,20 @@ public:
 	
 	static bool Exists(const std::string &filePath);
 	static std::time_t Timestamp(const std::string &filePath);
+	// Get the size and the modification time of the given file, in nanoseconds
+	// if the file system records it that precisely. Returns false if the file
+	// does not exist.
+	static bool Stat(const std::string &filePath, uint64_t &size, int64_t &timestamp);
 	static void Copy(const std::string &from, const std::string &to);
 	static void Move(const std::string &from, const std::string &to);
 	static void Delete(const std::string &filePath);
 	
 	// Get the filename from a path.
 	static std::string Name(const std::string &path);
+	// Get the name under which something made from the file at the given path
+	// is stored in a cache. The name is a hash of the path, so different paths
+	// may share a name; the cached file should record the full path as well.
+	static std::string CacheName(const std::string &path);
 	
 	// File IO.
 	static void CreateNewDirectory(const std::string &path);
@@ -64,6 +73,8 @@ public:
 	static std::string Read(FILE *file);
 	static void Write(const std::string &path, const std::string &data);
 	static void Write(FILE *file, const std::string &data);
+	// Write data to a file exactly as given, without converting line endings.
+	static void WriteBinary(const std::string &path, const std::string &data);
 	
 	static void LogError(const std::string &message);
 };
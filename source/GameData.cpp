@@ -18,6 +18,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Command.h"
 #include "Conversation.h"
 #include "DataFile.h"
+#include "DataFileCache.h"
 #include "DataNode.h"
 #include "DataWriter.h"
 #include "Effect.h"
@@ -33,6 +34,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "ImageSet.h"
 #include "Interface.h"
 #include "LineShader.h"
+#include "MaskCache.h"
 #include "MaskManager.h"
 #include "Minable.h"
 #include "Mission.h"
@@ -45,23 +47,30 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Planet.h"
 #include "PointerShader.h"
 #include "Politics.h"
+#include "Preferences.h"
 #include "Random.h"
+#include "RouteCache.h"
 #include "RingShader.h"
 #include "Ship.h"
 #include "Sprite.h"
+#include "SpriteBudget.h"
 #include "SpriteQueue.h"
 #include "SpriteSet.h"
 #include "SpriteShader.h"
 #include "StarField.h"
 #include "StartConditions.h"
 #include "System.h"
+#include "SystemIndex.h"
 #include "Test.h"
 #include "TestData.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -90,6 +99,11 @@ namespace {
 	Set<Test> tests;
 	Set<TestData> testDataSets;
 	set<double> neighborDistances;
+	// The positions of all the systems, for finding their neighbors.
+	SystemIndex systemIndex;
+	// The largest jump range of any system, which may be larger than any of
+	// the neighbor distances.
+	double maxJumpRange = 0.;
 	
 	Set<Sale<Ship>> shipSales;
 	Set<Sale<Outfit>> outfitSales;
@@ -104,6 +118,22 @@ namespace {
 	Set<System> defaultSystems;
 	Set<Planet> defaultPlanets;
 	
+	// The state of the sets that the editor reloads, as it was after loading
+	// every source except the plugins in the config folder. It is captured once
+	// during the initial load, so that opening a plugin in the editor does not
+	// need to parse the game data again.
+	Set<Effect> snapshotEffects;
+	Set<Fleet> snapshotFleets;
+	Set<Galaxy> snapshotGalaxies;
+	Set<Hazard> snapshotHazards;
+	Set<Government> snapshotGovernments;
+	Set<Outfit> snapshotOutfits;
+	Set<Sale<Outfit>> snapshotOutfitSales;
+	Set<Ship> snapshotShips;
+	Set<Sale<Ship>> snapshotShipSales;
+	Set<System> snapshotSystems;
+	Set<Planet> snapshotPlanets;
+	
 	Politics politics;
 	vector<StartConditions> startConditions;
 
@@ -134,7 +164,7 @@ namespace {
 	
 	vector<string> sources;
 	map<const Sprite *, shared_ptr<ImageSet>> deferred;
-	map<const Sprite *, int> preloaded;
+	SpriteBudget preloaded;
 	
 	MaskManager maskManager;
 	
@@ -164,6 +194,93 @@ namespace {
 		it.second.SetName(it.first);
 		Warn(noun, it.first);
 	}
+	
+	// Parse all the given data files. Tokenizing is independent for each file,
+	// so it is spread over a pool of worker threads (like the SpriteQueue's).
+	// The parsed files are returned in the same order as the given paths, so
+	// that applying them to the game data keeps the same override semantics.
+	vector<DataFile> ParseFiles(const vector<string> &paths)
+	{
+		vector<DataFile> files(paths.size());
+#ifndef ES_NO_THREADS
+		atomic<size_t> next(0);
+		auto parse = [&paths, &files, &next]() noexcept -> void
+		{
+			for(size_t i = next++; i < paths.size(); i = next++)
+				files[i].LoadCached(paths[i]);
+		};
+		vector<thread> threads(min<size_t>(paths.size(), max(4u, thread::hardware_concurrency())));
+		for(thread &t : threads)
+			t = thread(parse);
+		for(thread &t : threads)
+			t.join();
+#else
+		for(size_t i = 0; i < paths.size(); ++i)
+			files[i].LoadCached(paths[i]);
+#endif // ES_NO_THREADS
+		return files;
+	}
+	
+	// Get the paths of all the data files in the given source.
+	vector<string> ListDataFiles(const string &source)
+	{
+		vector<string> dataFiles = Files::RecursiveList(source + "data/");
+		dataFiles.erase(remove_if(dataFiles.begin(), dataFiles.end(),
+				[](const string &path) noexcept -> bool
+				{
+					return path.length() < 4 || path.compare(path.length() - 4, 4, ".txt");
+				}),
+			dataFiles.end()
+		);
+		return dataFiles;
+	}
+	
+	// Check whether the given source is a plugin that the editor can open.
+	bool IsEditable(const string &source)
+	{
+		const string pluginsPath = Files::Config() + "plugins/";
+		return !source.compare(0, pluginsPath.length(), pluginsPath);
+	}
+	
+	// Get the size and modification time of each of the given files.
+	vector<pair<uint64_t, int64_t>> StatFiles(const vector<string> &paths)
+	{
+		vector<pair<uint64_t, int64_t>> stamps(paths.size());
+		for(size_t i = 0; i < paths.size(); ++i)
+			Files::Stat(paths[i], stamps[i].first, stamps[i].second);
+		return stamps;
+	}
+	
+	// The parsed data files of each plugin that the editor can open. They are
+	// kept for the whole session, so that opening a plugin does not parse all
+	// the other plugins (and the opened one) again. A plugin is only parsed
+	// again if its files have changed since, e.g. because the editor saved it.
+	class ParsedPlugin {
+	public:
+		vector<string> paths;
+		// The size and modification time of each file when it was parsed.
+		vector<pair<uint64_t, int64_t>> stamps;
+		shared_ptr<const vector<DataFile>> files;
+	};
+	map<string, ParsedPlugin> parsedPlugins;
+	
+	// Get the parsed data files of the given plugin, parsing them again if any
+	// of them have changed on disk.
+	const ParsedPlugin &ParsePlugin(const string &source)
+	{
+		ParsedPlugin &plugin = parsedPlugins[source];
+		vector<string> paths = ListDataFiles(source);
+		// Check the files before parsing them, so that if one is changed while
+		// it is being parsed, it will be parsed again next time.
+		vector<pair<uint64_t, int64_t>> stamps = StatFiles(paths);
+		if(!plugin.files || paths != plugin.paths || stamps != plugin.stamps)
+		{
+			plugin.files = make_shared<const vector<DataFile>>(ParseFiles(paths));
+			plugin.paths = std::move(paths);
+			plugin.stamps = std::move(stamps);
+		}
+		return plugin;
+	}
 }
 
 
@@ -207,6 +324,7 @@ bool GameData::BeginLoad(const char * const *argv)
 		}
 	}
 	Files::Init(argv);
+	DataFileCache::Init(Files::Config() + "cache/");
 	
 	// Initialize the list of "source" folders based on any active plugins.
 	LoadSources();
@@ -299,17 +417,11 @@ void GameData::LoadData(const string *ignore, bool debugMode)
 	auto &systems = ignore ? baseSystems : ::systems;
 	auto &planets = ignore ? basePlanets : ::planets;
 
-	for(const string &source : sources)
+	auto loadFiles = [&](const vector<string> &paths, const vector<DataFile> &files, size_t begin, size_t end) -> void
 	{
-		if(ignore && source == *ignore)
-			continue;
-
-		// Iterate through the paths starting with the last directory given. That
-		// is, things in folders near the start of the path have the ability to
-		// override things in folders later in the path.
-		vector<string> dataFiles = Files::RecursiveList(source + "data/");
-		for(const string &path : dataFiles)
-			LoadFile(path,
+		for(size_t i = begin; i < end; ++i)
+			LoadFile(paths[i],
+					files[i],
 					debugMode,
 					effects,
 					fleets,
@@ -322,6 +434,87 @@ void GameData::LoadData(const string *ignore, bool debugMode)
 					shipSales,
 					systems,
 					planets);
+	};
+	
+	if(!ignore)
+	{
+		// Iterate through the paths starting with the last directory given. That
+		// is, things in folders near the start of the path have the ability to
+		// override things in folders later in the path.
+		vector<string> dataFiles;
+		vector<size_t> sourceEnd;
+		for(const string &source : sources)
+		{
+			vector<string> sourceFiles = ListDataFiles(source);
+			move(sourceFiles.begin(), sourceFiles.end(), back_inserter(dataFiles));
+			sourceEnd.push_back(dataFiles.size());
+		}
+		
+		// Parse every file first, then apply them in their original order. The
+		// plugins that the editor can open are always loaded last, so everything
+		// before them is the state the editor starts from when opening one.
+		size_t firstPlugin = find_if(sources.begin(), sources.end(), IsEditable) - sources.begin();
+		size_t snapshotEnd = firstPlugin ? sourceEnd[firstPlugin - 1] : 0;
+		const vector<pair<uint64_t, int64_t>> stamps = StatFiles(
+			vector<string>(dataFiles.begin() + snapshotEnd, dataFiles.end()));
+		vector<DataFile> parsed = ParseFiles(dataFiles);
+		// Every data file has now been looked up in the cache, so any other
+		// cached files are for data files that no longer exist.
+		DataFileCache::Prune();
+		// Each of the game's own data files is freed as soon as it has been
+		// applied, but the plugins' files are kept for the editor.
+		for(size_t i = 0; i < snapshotEnd; ++i)
+		{
+			loadFiles(dataFiles, parsed, i, i + 1);
+			parsed[i] = DataFile();
+		}
+		snapshotEffects = effects;
+		snapshotFleets = fleets;
+		snapshotGalaxies = galaxies;
+		snapshotHazards = hazards;
+		snapshotGovernments = governments;
+		snapshotOutfits = outfits;
+		snapshotOutfitSales = outfitSales;
+		snapshotShips = ships;
+		snapshotShipSales = shipSales;
+		snapshotSystems = systems;
+		snapshotPlanets = planets;
+		loadFiles(dataFiles, parsed, snapshotEnd, dataFiles.size());
+		parsedPlugins.clear();
+		for(size_t i = firstPlugin; i < sources.size(); ++i)
+		{
+			if(!IsEditable(sources[i]))
+				continue;
+			const size_t begin = i ? sourceEnd[i - 1] : 0;
+			const size_t end = sourceEnd[i];
+			ParsedPlugin &plugin = parsedPlugins[sources[i]];
+			plugin.paths.assign(dataFiles.begin() + begin, dataFiles.begin() + end);
+			plugin.stamps.assign(stamps.begin() + (begin - snapshotEnd), stamps.begin() + (end - snapshotEnd));
+			plugin.files = make_shared<const vector<DataFile>>(make_move_iterator(parsed.begin() + begin),
+				make_move_iterator(parsed.begin() + end));
+		}
+	}
+	else
+	{
+		// Start from the state of the game without any of the editable plugins,
+		// and only apply the plugins other than the ignored one on top of it.
+		effects = snapshotEffects;
+		fleets = snapshotFleets;
+		galaxies = snapshotGalaxies;
+		hazards = snapshotHazards;
+		governments = snapshotGovernments;
+		outfits = snapshotOutfits;
+		outfitSales = snapshotOutfitSales;
+		ships = snapshotShips;
+		shipSales = snapshotShipSales;
+		systems = snapshotSystems;
+		planets = snapshotPlanets;
+		for(const string &source : sources)
+			if(source != *ignore && IsEditable(source))
+			{
+				const ParsedPlugin &plugin = ParsePlugin(source);
+				loadFiles(plugin.paths, *plugin.files, 0, plugin.paths.size());
+			}
 	}
 	
 	// Now that all data is loaded, update the neighbor lists and other
@@ -337,6 +530,15 @@ void GameData::LoadData(const string *ignore, bool debugMode)
 
 
 
+// Get the paths and parsed contents of the data files of the given plugin.
+pair<vector<string>, shared_ptr<const vector<DataFile>>> GameData::PluginFiles(const string &source)
+{
+	const ParsedPlugin &plugin = ParsePlugin(source);
+	return make_pair(plugin.paths, plugin.files);
+}
+
+
+
 // Check for objects that are referred to but never defined. Some elements, like
 // fleets, don't need to be given a name if undefined. Others (like outfits and
 // planets) are written to the player's save and need a name to prevent data loss.
@@ -439,7 +641,7 @@ void GameData::CheckReferences()
 
 
 
-void GameData::LoadShaders(bool useShaderSwizzle)
+void GameData::LoadShaders(bool useShaderSwizzle, bool useInstancing)
 {
 	FontSet::Add(Files::Images() + "font/ubuntu14r.png", 14);
 	FontSet::Add(Files::Images() + "font/ubuntu18r.png", 18);
@@ -454,7 +656,7 @@ void GameData::LoadShaders(bool useShaderSwizzle)
 	OutlineShader::Init();
 	PointerShader::Init();
 	RingShader::Init();
-	SpriteShader::Init(useShaderSwizzle);
+	SpriteShader::Init(useShaderSwizzle, useInstancing);
 	BatchShader::Init();
 	
 	background.Init(16384, 4096);
@@ -502,6 +704,9 @@ double GameData::Progress()
 			// All sprites with collision masks should also have their 1x scaled versions, so create
 			// any additional scaled masks from the default one.
 			maskManager.ScaleMasks();
+			// Every image with a collision mask has now been loaded, so any
+			// other saved masks are for images that no longer exist.
+			MaskCache::Prune();
 			initiallyLoaded = true;
 		}
 	}
@@ -519,7 +724,7 @@ bool GameData::IsLoaded()
 
 // Begin loading a sprite that was previously deferred. Currently this is
 // done with all landscapes to speed up the program's startup.
-void GameData::Preload(const Sprite *sprite)
+void GameData::Preload(const Sprite *sprite, bool isNearby)
 {
 	// Make sure this sprite actually is one that uses deferred loading.
 	auto dit = deferred.find(sprite);
@@ -529,37 +734,27 @@ void GameData::Preload(const Sprite *sprite)
 	// If this sprite is one of the currently loaded ones, there is no need to
 	// load it again. But, make note of the fact that it is the most recently
 	// asked-for sprite.
-	map<const Sprite *, int>::iterator pit = preloaded.find(sprite);
-	if(pit != preloaded.end())
-	{
-		for(pair<const Sprite * const, int> &it : preloaded)
-			if(it.second < pit->second)
-				++it.second;
-		
-		pit->second = 0;
+	if(!preloaded.Use(sprite, isNearby))
 		return;
-	}
 	
-	// This sprite is not currently preloaded. Check to see whether we already
-	// have the maximum number of sprites loaded, in which case the oldest one
-	// must be unloaded to make room for this one.
-	const string &name = sprite->Name();
-	pit = preloaded.begin();
-	while(pit != preloaded.end())
+	// Now, load all the files for this sprite. Nearby sprites are not needed
+	// yet, so they can wait until any others have been read.
+	spriteQueue.Add(dit->second, isNearby);
+	
+	// Check whether the loaded sprites now take up more memory than they are
+	// allowed to, in which case the least needed ones must be unloaded to make
+	// room. Sprites that are still being loaded do not count towards this yet.
+	for(const Sprite *loaded : preloaded.Sprites())
 	{
-		++pit->second;
-		if(pit->second >= 20)
-		{
-			spriteQueue.Unload(name);
-			pit = preloaded.erase(pit);
-		}
-		else
-			++pit;
+		// Each frame is stored as 32-bit RGBA, and @2x frames are 4 times larger.
+		size_t memory = static_cast<size_t>(loaded->Width() * loaded->Height()) * loaded->Frames() * 4;
+		if(loaded->Texture(true) != loaded->Texture(false))
+			memory *= 5;
+		preloaded.SetMemory(loaded, memory);
 	}
-	
-	// Now, load all the files for this sprite.
-	preloaded[sprite] = 0;
-	spriteQueue.Add(dit->second);
+	preloaded.SetLimit(static_cast<size_t>(Preferences::ImageMemory()) << 20);
+	for(const Sprite *unused : preloaded.Unload())
+		spriteQueue.Unload(unused->Name());
 }
 
 
@@ -586,6 +781,9 @@ void GameData::Revert()
 	governments.Revert(defaultGovernments);
 	planets.Revert(defaultPlanets);
 	systems.Revert(defaultSystems);
+	// Reverting may have removed some systems.
+	systemIndex.Build(systems);
+	RouteCache::Clear();
 	galaxies.Revert(defaultGalaxies);
 	shipSales.Revert(defaultShipSales);
 	outfitSales.Revert(defaultOutfitSales);
@@ -781,6 +979,11 @@ void GameData::Change(const DataNode &node, bool initialLoad)
 	}
 	else if(initialLoad)
 		node.PrintTrace("Invalid \"event\" data:");
+	
+	// Planets may be wormholes, so any change to them or to the systems may
+	// change the routes between systems.
+	if(node.Token(0) == "planet" || node.Token(0) == "system" || node.Token(0) == "link" || node.Token(0) == "unlink")
+		RouteCache::Clear();
 }
 
 
@@ -791,20 +994,43 @@ void GameData::UpdateSystems(bool initialLoad)
 {
 	auto &systems = initialLoad ? ::systems : baseSystems;
 
+	systemIndex.Build(::systems);
+	RouteCache::Clear();
+	maxJumpRange = 0.;
+	for(const auto &it : ::systems)
+		maxJumpRange = max(maxJumpRange, it.second.JumpRange());
 	for(auto &it : systems)
 	{
 		// Skip systems that have no name.
 		if(it.first.empty() || it.second.Name().empty())
 			continue;
-		it.second.UpdateSystem(::systems, neighborDistances);
+		it.second.UpdateSystem(systemIndex, neighborDistances);
 	}
 }
 
 
 
+// Update the given system, which may have been created, moved, renamed or
+// (un)linked, and patch the neighbor lists of all the systems it was or now is
+// a neighbor of. This is much faster than recalculating every system.
 void GameData::UpdateSystem(System *system)
 {
-	system->UpdateSystem(systems, neighborDistances);
+	// Find every system that may have had this one as a neighbor before, or
+	// may have it as one now, i.e. those within range of its old or new position.
+	double range = max(maxJumpRange, neighborDistances.empty() ? 0. : *neighborDistances.rbegin());
+	vector<const System *> affected;
+	if(const Point *oldPosition = systemIndex.Position(system))
+		systemIndex.Within(*oldPosition, range, affected, system);
+	systemIndex.Update(system);
+	systemIndex.Within(system->Position(), range, affected, system);
+	sort(affected.begin(), affected.end());
+	affected.erase(unique(affected.begin(), affected.end()), affected.end());
+	for(const System *other : affected)
+		const_cast<System *>(other)->UpdateNeighbor(*system);
+	
+	maxJumpRange = max(maxJumpRange, system->JumpRange());
+	system->UpdateSystem(systemIndex, neighborDistances);
+	RouteCache::Clear();
 }
 
 
@@ -1194,6 +1420,7 @@ void GameData::LoadSources()
 
 void GameData::LoadFile(
 		const string &path,
+		const DataFile &data,
 		bool debugMode,
 		Set<Effect> &effects,
 		Set<Fleet> &fleets,
@@ -1207,12 +1434,7 @@ void GameData::LoadFile(
 		Set<System> &systems,
 		Set<Planet> &planets)
 {
-	// This is an ordinary file. Check to see if it is an image.
-	if(path.length() < 4 || path.compare(path.length() - 4, 4, ".txt"))
-		return;
-	
 	const bool initialLoad = &effects == &::effects;
-	DataFile data(path);
 	if(debugMode)
 		Files::LogError("Parsing: " + path);
 	
@@ -22,10 +22,12 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 class Color;
 class Conversation;
+class DataFile;
 class DataNode;
 class DataWriter;
 class Date;
@@ -68,14 +70,16 @@ public:
 	static void LoadData(const std::string *ignore = nullptr, bool debugMode = false);
 	// Check for objects that are referred to but never defined.
 	static void CheckReferences();
-	static void LoadShaders(bool useShaderSwizzle);
+	static void LoadShaders(bool useShaderSwizzle, bool useInstancing);
 	// TODO: make Progress() a simple accessor.
 	static double Progress();
 	// Whether initial game loading is complete (sprites and audio are loaded).
 	static bool IsLoaded();
 	// Begin loading a sprite that was previously deferred. Currently this is
-	// done with all landscapes to speed up the program's startup.
-	static void Preload(const Sprite *sprite);
+	// done with all landscapes to speed up the program's startup. Sprites that
+	// are only nearby (e.g. in a neighboring system) are loaded last, and are
+	// the first to be unloaded if too much memory is in use.
+	static void Preload(const Sprite *sprite, bool isNearby = false);
 	static void FinishLoading();
 	
 	// Get the list of resource sources (i.e. plugin folders).
@@ -164,8 +168,12 @@ public:
 	
 private:
 	static void LoadSources();
+	// Get the parsed data files of the given plugin, for the editor to open.
+	static std::pair<std::vector<std::string>, std::shared_ptr<const std::vector<DataFile>>> PluginFiles(
+		const std::string &source);
 	static void LoadFile(
 			const std::string &path,
+			const DataFile &data,
 			bool debugMode,
 			Set<Effect> &effects,
 			Set<Fleet> &fleets,
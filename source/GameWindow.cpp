@@ -34,6 +34,7 @@ namespace {
 	int width = 0;
 	int height = 0;
 	bool hasSwizzle = false;
+	bool hasInstancing = false;
 	bool supportsAdaptiveVSync = false;
 	
 	// Logs SDL errors and returns true if found
@@ -212,6 +213,12 @@ bool GameWindow::Init()
 	
 	// Check for support of various graphical features.
 	hasSwizzle = HasOpenGLExtension("_texture_swizzle");
+	// Instanced drawing is part of OpenGL ES 3.0, but only of OpenGL 3.3 and up.
+#if defined(ES_GLES) || defined(__APPLE__)
+	hasInstancing = true;
+#else
+	hasInstancing = GLEW_VERSION_3_3;
+#endif
 	supportsAdaptiveVSync = HasOpenGLExtension("_swap_control_tear");
 	
 	// Enable the user's preferred VSync state, otherwise update to an available
@@ -426,6 +433,13 @@ bool GameWindow::HasSwizzle()
 
 
 
+bool GameWindow::HasInstancing()
+{
+	return hasInstancing;
+}
+
+
+
 void GameWindow::ExitWithError(const string& message, bool doPopUp)
 {
 	// Print the error message in the terminal and the error file.
@@ -46,6 +46,8 @@ public:
 	
 	// Check if the initialized window system supports OpenGL texture_swizzle.
 	static bool HasSwizzle();
+	// Check if it supports drawing many copies of the same vertices at once.
+	static bool HasInstancing();
 	
 	// Print the error message in the terminal, error file, and message box.
 	// Checks for video system errors and records those as well.
@@ -15,6 +15,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Files.h"
 #include "GameData.h"
 #include "Mask.h"
+#include "MaskCache.h"
 #include "MaskManager.h"
 #include "Sprite.h"
 
@@ -153,7 +154,10 @@ string ImageSet::Name(const string &path)
 
 
 // Determine whether the given path or name is for a sprite whose loading
-// should be deferred until needed.
+// should be deferred until needed. Only landscapes are, because they are only
+// ever drawn. The sizes of other sprites (e.g. of ships, planets and stars) are
+// used by the game itself, for collisions and to lay out systems, so those are
+// only known once the sprites have been loaded.
 bool ImageSet::IsDeferred(const string &path)
 {
 	if(path.length() >= 5 && !path.compare(0, 5, "land/"))
@@ -236,11 +240,15 @@ void ImageSet::Load() noexcept(false)
 	{
 		if(!buffer[0].Read(paths[0][i], i))
 			Files::LogError("Failed to read image data for \"" + name + "\" frame #" + to_string(i));
-		else if(makeMasks)
+		else if(makeMasks && !MaskCache::Load(paths[0][i], masks[i]))
 		{
+			// Tracing the outline of an image is slow, so save the mask to be
+			// reused the next time this image is loaded.
 			masks[i].Create(buffer[0], i);
 			if(!masks[i].IsLoaded())
 				Files::LogError("Failed to create collision mask for \"" + name + "\" frame #" + to_string(i));
+			else
+				MaskCache::Save(paths[0][i], masks[i]);
 		}
 	}
 	// Now, load the 2x sprites, if they exist. Because the number of 1x frames
@@ -384,19 +384,8 @@ bool MapEditorPanel::Scroll(double dx, double dy)
 bool MapEditorPanel::Release(int x, int y)
 {
 	isDragging = false;
-	if(moveSystems)
-	{
-		moveSystems = false;
-		for(auto &&system : selectedSystems)
-		{
-			auto oldNeighbors = system->VisibleNeighbors();
-			for(auto &&link : oldNeighbors)
-				GameData::UpdateSystem(const_cast<System *>(link));
-			GameData::UpdateSystem(const_cast<System *>(system));
-			for(auto &&link : system->VisibleNeighbors())
-				GameData::UpdateSystem(const_cast<System *>(link));
-		}
-	}
+	// The neighbors of the moved systems were already updated while dragging.
+	moveSystems = false;
 	if(selectSystems)
 	{
 		selectSystems = false;
@@ -19,6 +19,10 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <cmath>
 #include <limits>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 
 namespace {
@@ -271,6 +275,101 @@ namespace {
 			radius = max(radius, p.LengthSquared());
 		return sqrt(radius);
 	}
+	
+	
+	// Find the closest point along the vector vA, starting from sA, where it
+	// enters the polygon through one of the edges from begin to end. If there is
+	// none closer than the given distance, that distance is returned.
+	double Enter(const double *x0, const double *y0, const double *x1, const double *y1,
+		size_t begin, size_t end, Point sA, Point vA, double closest)
+	{
+		size_t i = begin;
+#ifdef __SSE2__
+		// Check two edges at a time, doing the same math as the loop below.
+		const __m128d sx = _mm_set1_pd(sA.X());
+		const __m128d sy = _mm_set1_pd(sA.Y());
+		const __m128d vx = _mm_set1_pd(vA.X());
+		const __m128d vy = _mm_set1_pd(vA.Y());
+		const __m128d zero = _mm_setzero_pd();
+		__m128d best = _mm_set1_pd(closest);
+		for( ; i + 2 <= end; i += 2)
+		{
+			const __m128d px = _mm_loadu_pd(x0 + i);
+			const __m128d py = _mm_loadu_pd(y0 + i);
+			const __m128d bx = _mm_sub_pd(_mm_loadu_pd(x1 + i), px);
+			const __m128d by = _mm_sub_pd(_mm_loadu_pd(y1 + i), py);
+			const __m128d cross = _mm_sub_pd(_mm_mul_pd(bx, vy), _mm_mul_pd(by, vx));
+			const __m128d dx = _mm_sub_pd(px, sx);
+			const __m128d dy = _mm_sub_pd(py, sy);
+			const __m128d uB = _mm_sub_pd(_mm_mul_pd(vx, dy), _mm_mul_pd(vy, dx));
+			const __m128d uA = _mm_sub_pd(_mm_mul_pd(bx, dy), _mm_mul_pd(by, dx));
+			const __m128d hit = _mm_and_pd(_mm_and_pd(_mm_cmpgt_pd(cross, zero), _mm_cmpge_pd(uB, zero)),
+				_mm_and_pd(_mm_cmplt_pd(uB, cross), _mm_cmpge_pd(uA, zero)));
+			const __m128d range = _mm_div_pd(uA, cross);
+			best = _mm_min_pd(best, _mm_or_pd(_mm_and_pd(hit, range), _mm_andnot_pd(hit, best)));
+		}
+		double lanes[2];
+		_mm_storeu_pd(lanes, best);
+		closest = min(lanes[0], lanes[1]);
+#endif
+		for( ; i < end; ++i)
+		{
+			// Check if there is an intersection. (If not, the cross would be 0.) If
+			// there is, handle it only if it is a point where the segment is
+			// entering the polygon rather than exiting it (i.e. cross > 0).
+			Point vB = Point(x1[i], y1[i]) - Point(x0[i], y0[i]);
+			double cross = vB.Cross(vA);
+			if(cross > 0.)
+			{
+				Point vS = Point(x0[i], y0[i]) - sA;
+				double uB = vA.Cross(vS);
+				double uA = vB.Cross(vS);
+				// If the intersection occurs somewhere within this segment of the
+				// outline, find out how far along the query vector it occurs and
+				// remember it if it is the closest so far.
+				if((uB >= 0.) & (uB < cross) & (uA >= 0.))
+					closest = min(closest, uA / cross);
+			}
+		}
+		return closest;
+	}
+	
+	
+	// Count how many of the edges from begin to end are crossed by a ray going
+	// straight down (toward positive y) from the given point.
+	int Crossings(const double *x0, const double *y0, const double *x1, const double *y1,
+		size_t begin, size_t end, Point point)
+	{
+		int crossings = 0;
+		size_t i = begin;
+#ifdef __SSE2__
+		const __m128d x = _mm_set1_pd(point.X());
+		const __m128d y = _mm_set1_pd(point.Y());
+		for( ; i + 2 <= end; i += 2)
+		{
+			const __m128d px = _mm_loadu_pd(x0 + i);
+			const __m128d py = _mm_loadu_pd(y0 + i);
+			const __m128d nx = _mm_loadu_pd(x1 + i);
+			const __m128d ny = _mm_loadu_pd(y1 + i);
+			// The edge spans the point's x coordinate if exactly one of these
+			// is false, counting it as closed at the start and open at the end.
+			const __m128d spans = _mm_and_pd(_mm_cmpneq_pd(px, nx),
+				_mm_xor_pd(_mm_cmple_pd(px, x), _mm_cmpge_pd(x, nx)));
+			const __m128d edgeY = _mm_add_pd(py,
+				_mm_div_pd(_mm_mul_pd(_mm_sub_pd(ny, py), _mm_sub_pd(x, px)), _mm_sub_pd(nx, px)));
+			const int below = _mm_movemask_pd(_mm_and_pd(spans, _mm_cmpge_pd(edgeY, y)));
+			crossings += (below & 1) + (below >> 1);
+		}
+#endif
+		for( ; i < end; ++i)
+			if(x0[i] != x1[i])
+				if((x0[i] <= point.X()) == (point.X() < x1[i]))
+				{
+					double edgeY = y0[i] + (y1[i] - y0[i]) * (point.X() - x0[i]) / (x1[i] - x0[i]);
+					crossings += (edgeY >= point.Y());
+				}
+		return crossings;
+	}
 }
 
 
@@ -301,6 +400,19 @@ void Mask::Create(const ImageBuffer &image, int frame)
 		outlines.back().shrink_to_fit();
 	}
 	outlines.shrink_to_fit();
+	PackEdges();
+}
+
+
+
+// Construct a mask from outlines that were made by Create() before.
+void Mask::SetOutlines(vector<vector<Point>> outlines)
+{
+	this->outlines = move(outlines);
+	radius = 0.;
+	for(const vector<Point> &outline : this->outlines)
+		radius = max(radius, ComputeRadius(outline));
+	PackEdges();
 }
 
 
@@ -426,6 +538,7 @@ Mask Mask::operator*(double scale) const
 		for(Point &p : outline)
 			p *= scale;
 	newMask.radius *= scale;
+	newMask.PackEdges();
 	return newMask;
 }
 
@@ -443,30 +556,17 @@ double Mask::Intersection(Point sA, Point vA) const
 	// Keep track of the closest intersection point found.
 	double closest = 1.;
 	
-	for(auto &&outline : outlines)
+	// Any point where the segment crosses an outline must be within both the
+	// segment's bounding box and the outline's.
+	const Point end = sA + vA;
+	const Point low(min(sA.X(), end.X()), min(sA.Y(), end.Y()));
+	const Point high(max(sA.X(), end.X()), max(sA.Y(), end.Y()));
+	for(const Span &span : spans)
 	{
-		Point prev = outline.back();
-		for(auto &&next : outline)
-		{
-			// Check if there is an intersection. (If not, the cross would be 0.) If
-			// there is, handle it only if it is a point where the segment is
-			// entering the polygon rather than exiting it (i.e. cross > 0).
-			Point vB = next - prev;
-			double cross = vB.Cross(vA);
-			if(cross > 0.)
-			{
-				Point vS = prev - sA;
-				double uB = vA.Cross(vS);
-				double uA = vB.Cross(vS);
-				// If the intersection occurs somewhere within this segment of the
-				// outline, find out how far along the query vector it occurs and
-				// remember it if it is the closest so far.
-				if((uB >= 0.) & (uB < cross) & (uA >= 0.))
-					closest = min(closest, uA / cross);
-			}
-			
-			prev = next;
-		}
+		if(low.X() > span.max.X() || high.X() < span.min.X() || low.Y() > span.max.Y() || high.Y() < span.min.Y())
+			continue;
+		
+		closest = Enter(startX.data(), startY.data(), endX.data(), endY.data(), span.begin, span.end, sA, vA, closest);
 	}
 	return closest;
 }
@@ -488,21 +588,58 @@ bool Mask::Contains(Point point) const
 	// Compute the number of intersections across all outlines, not just one, as the
 	// outlines may be nested (i.e. holes) or discontinuous (multiple separate shapes).
 	int intersections = 0;
-	for(auto &&outline : outlines)
+	for(const Span &span : spans)
 	{
+		// No edge of an outline can span the point's x coordinate if the point
+		// is to the left or right of the whole outline.
+		if(point.X() < span.min.X() || point.X() > span.max.X())
+			continue;
+		
+		intersections += Crossings(startX.data(), startY.data(), endX.data(), endY.data(),
+			span.begin, span.end, point);
+	}
+	// If the number of intersections is odd, the point is within the mask.
+	return (intersections & 1);
+}
+
+
+
+// Copy the edges of the outlines into the arrays used for collision checks.
+void Mask::PackEdges()
+{
+	size_t count = 0;
+	for(const vector<Point> &outline : outlines)
+		count += outline.size();
+	
+	startX.clear();
+	startY.clear();
+	endX.clear();
+	endY.clear();
+	spans.clear();
+	startX.reserve(count);
+	startY.reserve(count);
+	endX.reserve(count);
+	endY.reserve(count);
+	spans.reserve(outlines.size());
+	for(const vector<Point> &outline : outlines)
+	{
+		Span span;
+		span.begin = startX.size();
+		span.min = outline.front();
+		span.max = outline.front();
+		
 		Point prev = outline.back();
-		for(auto &&next : outline)
+		for(const Point &next : outline)
 		{
-			if(prev.X() != next.X())
-				if((prev.X() <= point.X()) == (point.X() < next.X()))
-				{
-					double y = prev.Y() + (next.Y() - prev.Y()) *
-						(point.X() - prev.X()) / (next.X() - prev.X());
-					intersections += (y >= point.Y());
-				}
+			startX.push_back(prev.X());
+			startY.push_back(prev.Y());
+			endX.push_back(next.X());
+			endY.push_back(next.Y());
+			span.min = Point(min(span.min.X(), next.X()), min(span.min.Y(), next.Y()));
+			span.max = Point(max(span.max.X(), next.X()), max(span.max.Y(), next.Y()));
 			prev = next;
 		}
+		span.end = startX.size();
+		spans.push_back(span);
 	}
-	// If the number of intersections is odd, the point is within the mask.
-	return (intersections & 1);
 }
@@ -16,6 +16,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Angle.h"
 #include "Point.h"
 
+#include <cstddef>
 #include <vector>
 
 class ImageBuffer;
@@ -31,6 +32,8 @@ class Mask {
 public:
 	// Construct a mask from the alpha channel of an RGBA-formatted image.
 	void Create(const ImageBuffer &image, int frame = 0);
+	// Construct a mask from outlines that were made by Create() before.
+	void SetOutlines(std::vector<std::vector<Point>> outlines);
 	
 	// Check whether a mask was successfully generated from the image.
 	bool IsLoaded() const;
@@ -62,14 +65,35 @@ public:
 	friend Mask operator*(double scale, const Mask &mask);
 	
 	
+private:
+	// The edges of one outline, and the box that all of them fit in.
+	class Span {
+	public:
+		size_t begin;
+		size_t end;
+		Point min;
+		Point max;
+	};
+	
+	
 private:
 	double Intersection(Point sA, Point vA) const;
 	bool Contains(Point point) const;
+	// Copy the edges of the outlines into the arrays used for collision checks.
+	void PackEdges();
 	
 	
 private:
 	std::vector<std::vector<Point>> outlines;
 	double radius = 0.;
+	
+	// The start and end points of every edge of every outline, with each
+	// coordinate in its own array, so that several edges can be checked at once.
+	std::vector<double> startX;
+	std::vector<double> startY;
+	std::vector<double> endX;
+	std::vector<double> endY;
+	std::vector<Span> spans;
 };
 
 
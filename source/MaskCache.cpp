@@ -0,0 +1,230 @@
+/* MaskCache.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "MaskCache.h"
+
+#include "Files.h"
+#include "Mask.h"
+#include "Point.h"
+
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <set>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// The first bytes of every file, which also tell whether it was written by
+	// a computer with the same byte order.
+	const uint32_t MAGIC = 0x4B534D45;
+	// Change this whenever the format, or the way masks are created, changes.
+	const uint32_t VERSION = 2;
+	// Some file systems only store modification times to the nearest second or
+	// two, so an image that is changed again right after its mask was saved
+	// might still look like the same image. Masks of images that were modified
+	// this recently (in seconds) are not saved until they are loaded again.
+	const int64_t RACY_TIME = 2;
+
+	// The saved masks that belong to images that were loaded in this session.
+	// Any others are for images that no longer exist.
+	mutex usedMutex;
+	set<string> used;
+
+	// Get the folder that the masks are saved in, creating it if necessary.
+	// Returns an empty string if there is nowhere to save them.
+	const string &Folder()
+	{
+		static const string folder = []() -> string
+		{
+			if(Files::Config().empty())
+				return "";
+
+			const string cache = Files::Config() + "cache/";
+			if(!Files::Exists(cache))
+				Files::CreateNewDirectory(cache);
+			const string masks = cache + "masks/";
+			if(!Files::Exists(masks))
+				Files::CreateNewDirectory(masks);
+			return Files::Exists(masks) ? masks : "";
+		}();
+		return folder;
+	}
+
+	// Get the path of the file that the mask for the given image is saved in,
+	// and remember that it is still in use. The full image path is saved in
+	// the file, in case another image has the same name in the cache.
+	string CachePath(const string &imagePath)
+	{
+		string path = Folder() + Files::CacheName(imagePath) + ".mask";
+		lock_guard<mutex> lock(usedMutex);
+		used.insert(path);
+		return path;
+	}
+
+	// Get the key that identifies this version of the given image: its path,
+	// its size and its modification time (to the nanosecond, if possible).
+	bool Key(const string &imagePath, string &key, int64_t &timestamp)
+	{
+		uint64_t size = 0;
+		if(!Files::Stat(imagePath, size, timestamp))
+			return false;
+		key = imagePath + '\n' + to_string(size) + '\n' + to_string(timestamp);
+		return true;
+	}
+
+	template <class Type>
+	void Append(string &data, const Type &value)
+	{
+		data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+
+	template <class Type>
+	bool Extract(const string &data, size_t &pos, Type &value)
+	{
+		if(data.size() - pos < sizeof(value))
+			return false;
+		memcpy(&value, data.data() + pos, sizeof(value));
+		pos += sizeof(value);
+		return true;
+	}
+}
+
+
+
+// Load the saved mask for the given image, if there is one that is up to date.
+bool MaskCache::Load(const string &imagePath, Mask &mask)
+{
+	if(Folder().empty())
+		return false;
+
+	string key;
+	int64_t timestamp = 0;
+	if(!Key(imagePath, key, timestamp))
+		return false;
+	const string path = CachePath(imagePath);
+	return Files::Exists(path) && Decode(Files::Read(path), key, mask);
+}
+
+
+
+// Save the given mask, which was created from the given image.
+void MaskCache::Save(const string &imagePath, const Mask &mask)
+{
+	if(Folder().empty() || !mask.IsLoaded())
+		return;
+
+	string key;
+	int64_t timestamp = 0;
+	if(!Key(imagePath, key, timestamp))
+		return;
+	const string path = CachePath(imagePath);
+	// An image that was modified just now may be modified again without its
+	// timestamp changing, so it is not safe to save its mask yet.
+	if(timestamp / 1000000000 + RACY_TIME > time(nullptr))
+		return;
+
+	// Write to a temporary file first, so that a file is never half written if
+	// the game is closed while saving it.
+	Files::WriteBinary(path + ".tmp", Encode(key, mask));
+	Files::Move(path + ".tmp", path);
+}
+
+
+
+// Delete the saved masks of any images that were not loaded in this session.
+void MaskCache::Prune()
+{
+	if(Folder().empty())
+		return;
+
+	lock_guard<mutex> lock(usedMutex);
+	for(const string &path : Files::List(Folder()))
+	{
+		const bool isMask = path.size() > 5 && !path.compare(path.size() - 5, 5, ".mask");
+		const bool isTemporary = path.size() > 9 && !path.compare(path.size() - 9, 9, ".mask.tmp");
+		if((isMask && !used.count(path)) || isTemporary)
+			Files::Delete(path);
+	}
+}
+
+
+
+// Convert a mask to the binary format that is saved.
+string MaskCache::Encode(const string &key, const Mask &mask)
+{
+	string data;
+	Append(data, MAGIC);
+	Append(data, VERSION);
+	Append(data, static_cast<uint32_t>(key.size()));
+	data += key;
+
+	const vector<vector<Point>> &outlines = mask.Outlines();
+	Append(data, static_cast<uint32_t>(outlines.size()));
+	for(const vector<Point> &outline : outlines)
+	{
+		Append(data, static_cast<uint32_t>(outline.size()));
+		for(const Point &point : outline)
+		{
+			Append(data, point.X());
+			Append(data, point.Y());
+		}
+	}
+	return data;
+}
+
+
+
+// Read a mask from the binary format that is saved.
+bool MaskCache::Decode(const string &data, const string &key, Mask &mask)
+{
+	size_t pos = 0;
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t keySize = 0;
+	if(!Extract(data, pos, magic) || magic != MAGIC || !Extract(data, pos, version) || version != VERSION)
+		return false;
+	if(!Extract(data, pos, keySize) || keySize != key.size() || data.compare(pos, keySize, key))
+		return false;
+	pos += keySize;
+
+	// Each outline takes at least the space for its size, so make sure the
+	// count is possible before allocating space for it, too.
+	uint32_t count = 0;
+	if(!Extract(data, pos, count) || count > (data.size() - pos) / sizeof(uint32_t))
+		return false;
+	vector<vector<Point>> outlines(count);
+	for(vector<Point> &outline : outlines)
+	{
+		uint32_t size = 0;
+		// Make sure the size is possible before allocating space for it.
+		if(!Extract(data, pos, size) || size > (data.size() - pos) / (2 * sizeof(double)))
+			return false;
+
+		outline.reserve(size);
+		for(uint32_t i = 0; i < size; ++i)
+		{
+			double x = 0.;
+			double y = 0.;
+			Extract(data, pos, x);
+			Extract(data, pos, y);
+			outline.emplace_back(x, y);
+		}
+	}
+	if(pos != data.size() || outlines.empty())
+		return false;
+
+	mask.SetOutlines(move(outlines));
+	return true;
+}
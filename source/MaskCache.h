@@ -0,0 +1,48 @@
+/* MaskCache.h
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef MASK_CACHE_H_
+#define MASK_CACHE_H_
+
+#include <string>
+
+class Mask;
+
+
+
+// Class that saves the collision masks traced from images in the config
+// directory, so that they do not need to be traced again the next time the
+// same image is loaded. Each image frame has its own file, which also records
+// the image's path, size and modification time (to the nanosecond, where the
+// file system allows it) so that outdated masks are ignored. Loading and saving
+// may be done from several image loading threads at once.
+class MaskCache {
+public:
+	// Load the saved mask for the given image, if there is one that is up to
+	// date. If not, return false, and the mask must be created from the image.
+	static bool Load(const std::string &imagePath, Mask &mask);
+	// Save the given mask, which was created from the given image.
+	static void Save(const std::string &imagePath, const Mask &mask);
+	// Delete the saved masks of any images that have not been loaded or saved
+	// in this session, once all the images have been loaded.
+	static void Prune();
+
+	// Convert a mask to and from the binary format that is saved. The key
+	// identifies the image that the mask was created from, and decoding fails
+	// if the data is for a different key or is not valid.
+	static std::string Encode(const std::string &key, const Mask &mask);
+	static bool Decode(const std::string &data, const std::string &key, Mask &mask);
+};
+
+
+
+#endif
@@ -15,11 +15,15 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Files.h"
 #include "Sprite.h"
 
+#include <mutex>
+
 using namespace std;
 
 namespace {
 	constexpr double DEFAULT = 1.;
 	map<const Sprite *, bool> warned;
+	// Masks may be looked up from several threads at once.
+	mutex warnMutex;
 	
 	string PrintScale(double s) {
 		return to_string(100. * s) + "%";
@@ -92,6 +96,7 @@ const std::vector<Mask> &MaskManager::GetMasks(const Sprite *sprite, double scal
 	const auto scalesIt = spriteMasks.find(sprite);
 	if(scalesIt == spriteMasks.end())
 	{
+		lock_guard<mutex> lock(warnMutex);
 		if(warned.insert(make_pair(sprite, true)).second)
 			Files::LogError("Warning: sprite \"" + sprite->Name() + "\": no collision masks found.");
 		return EMPTY;
@@ -103,6 +108,7 @@ const std::vector<Mask> &MaskManager::GetMasks(const Sprite *sprite, double scal
 		return maskIt->second;
 	
 	// Shouldn't happen, but just in case, print some details about the scales for this sprite (once).
+	lock_guard<mutex> lock(warnMutex);
 	if(warned.insert(make_pair(sprite, true)).second)
 	{
 		string warning = "Warning: sprite \"" + sprite->Name() + "\": collision mask not found.";
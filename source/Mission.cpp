@@ -24,6 +24,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Planet.h"
 #include "PlayerInfo.h"
 #include "Random.h"
+#include "RouteCache.h"
 #include "Ship.h"
 #include "ShipEvent.h"
 #include "System.h"
@@ -1221,19 +1222,18 @@ Mission Mission::Instantiate(const PlayerInfo &player, const shared_ptr<Ship> &b
 	while(!destinations.empty())
 	{
 		// Find the closest destination to this location.
-		DistanceMap distance(path);
+		const shared_ptr<const DistanceMap> distance = RouteCache::Get(path);
 		auto it = destinations.begin();
 		auto bestIt = it;
 		for(++it; it != destinations.end(); ++it)
-			if(distance.Days(*it) < distance.Days(*bestIt))
+			if(distance->Days(*it) < distance->Days(*bestIt))
 				bestIt = it;
 		
 		path = *bestIt;
-		jumps += distance.Days(*bestIt);
+		jumps += distance->Days(*bestIt);
 		destinations.erase(bestIt);
 	}
-	DistanceMap distance(path);
-	jumps += distance.Days(result.destination->GetSystem());
+	jumps += RouteCache::Get(path)->Days(result.destination->GetSystem());
 	int64_t payload = static_cast<int64_t>(result.cargoSize) + 10 * static_cast<int64_t>(result.passengers);
 	
 	// Set the deadline, if requested.
@@ -0,0 +1,213 @@
+/* NameIndex.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "NameIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
+using namespace std;
+
+namespace {
+	// Characters are compared without regard to case.
+	unsigned char Lower(char c)
+	{
+		return tolower(static_cast<unsigned char>(c));
+	}
+}
+
+
+
+// Add the given name, if it is not already in the index.
+void NameIndex::Add(const string &name)
+{
+	auto it = ids.find(name);
+	if(it != ids.end())
+	{
+		Entry &entry = entries[it->second];
+		if(entry.removed)
+		{
+			entry.removed = false;
+			isSorted = false;
+		}
+		return;
+	}
+
+	const uint32_t id = entries.size();
+	entries.push_back({name});
+	ids.emplace(name, id);
+	for(size_t i = 0; i < name.size(); ++i)
+	{
+		const char next = i + 1 < name.size() ? name[i + 1] : '\0';
+		postings[PairKey(i, name[i], next)].push_back(id);
+		postings[CharKey(i, name[i])].push_back(id);
+	}
+	isSorted = false;
+}
+
+
+
+// Remove the given name from the index.
+void NameIndex::Remove(const string &name)
+{
+	// The postings of a removed name are kept, so that adding the name back
+	// later is free. Searches skip over removed names.
+	auto it = ids.find(name);
+	if(it != ids.end() && !entries[it->second].removed)
+	{
+		entries[it->second].removed = true;
+		isSorted = false;
+	}
+}
+
+
+
+bool NameIndex::Has(const string &name) const
+{
+	auto it = ids.find(name);
+	return it != ids.end() && !entries[it->second].removed;
+}
+
+
+
+// Add and remove names so that the index contains exactly the given names.
+void NameIndex::Assign(const vector<const string *> &names)
+{
+	vector<bool> present(entries.size());
+	for(const string *name : names)
+	{
+		Add(*name);
+		const uint32_t id = ids.find(*name)->second;
+		if(id >= present.size())
+			present.resize(id + 1);
+		present[id] = true;
+	}
+	for(uint32_t id = 0; id < entries.size(); ++id)
+		if(!present[id] && !entries[id].removed)
+		{
+			entries[id].removed = true;
+			isSorted = false;
+		}
+}
+
+
+
+void NameIndex::Clear()
+{
+	entries.clear();
+	ids.clear();
+	postings.clear();
+	sorted.clear();
+	isSorted = true;
+}
+
+
+
+// Get the names that best match the given text, best match first.
+void NameIndex::Search(const string &text, size_t limit, vector<pair<double, const string *>> &result,
+	const function<bool(const string &)> &filter) const
+{
+	result.clear();
+	if(!limit)
+		return;
+
+	// Count how many pairs of characters of each name match those of the text.
+	// Every pair of the text but the last has to match exactly. The last
+	// character of the text has no character following it, so it matches any
+	// name that has the same character at that position.
+	counts.resize(entries.size());
+	touched.clear();
+	const auto count = [this](const vector<uint32_t> &matches)
+	{
+		for(uint32_t id : matches)
+		{
+			if(!counts[id])
+				touched.push_back(id);
+			if(counts[id] < numeric_limits<uint16_t>::max())
+				++counts[id];
+		}
+	};
+	for(size_t i = 0; i < text.size(); ++i)
+	{
+		auto it = postings.find(i + 1 < text.size() ? PairKey(i, text[i], text[i + 1]) : CharKey(i, text[i]));
+		if(it != postings.end())
+			count(it->second);
+	}
+
+	for(uint32_t id : touched)
+	{
+		const Entry &entry = entries[id];
+		if(!entry.removed && (!filter || filter(entry.name)))
+			result.emplace_back((2. * counts[id]) / (text.size() + entry.name.size()), &entry.name);
+		counts[id] = 0;
+	}
+
+	if(result.empty())
+	{
+		// Nothing matches, so fall back to listing the names in order.
+		for(uint32_t id : Sorted())
+		{
+			if(result.size() == limit)
+				break;
+			if(!filter || filter(entries[id].name))
+				result.emplace_back(0., &entries[id].name);
+		}
+		return;
+	}
+
+	const auto compare = [](const pair<double, const string *> &lhs, const pair<double, const string *> &rhs)
+	{
+		return lhs.first != rhs.first ? lhs.first > rhs.first : *lhs.second < *rhs.second;
+	};
+	if(result.size() > limit)
+	{
+		partial_sort(result.begin(), result.begin() + limit, result.end(), compare);
+		result.resize(limit);
+	}
+	else
+		sort(result.begin(), result.end(), compare);
+}
+
+
+
+uint64_t NameIndex::PairKey(size_t position, char first, char second)
+{
+	return (static_cast<uint64_t>(position) << 17) | (Lower(first) << 9) | (Lower(second) << 1);
+}
+
+
+
+uint64_t NameIndex::CharKey(size_t position, char first)
+{
+	return (static_cast<uint64_t>(position) << 17) | (Lower(first) << 9) | 1;
+}
+
+
+
+// Get the names that are in the index, in alphabetical order.
+const vector<uint32_t> &NameIndex::Sorted() const
+{
+	if(!isSorted)
+	{
+		sorted.clear();
+		for(uint32_t id = 0; id < entries.size(); ++id)
+			if(!entries[id].removed)
+				sorted.push_back(id);
+		sort(sorted.begin(), sorted.end(), [this](uint32_t lhs, uint32_t rhs)
+			{
+				return entries[lhs].name < entries[rhs].name;
+			});
+		isSorted = true;
+	}
+	return sorted;
+}
@@ -0,0 +1,83 @@
+/* NameIndex.h
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef NAME_INDEX_H_
+#define NAME_INDEX_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+
+// An index for fuzzy searches through a list of names, such as the names of the
+// objects in a Set. A name matches the search text in proportion to how many
+// pairs of characters are the same, and at the same position, in both of them
+// (ignoring case). Every pair of characters of every name is indexed by its
+// position, so a search only looks at the names that share at least one pair
+// with the search text instead of comparing the text to every name.
+class NameIndex {
+public:
+	// Add the given name, if it is not already in the index.
+	void Add(const std::string &name);
+	// Remove the given name from the index.
+	void Remove(const std::string &name);
+	bool Has(const std::string &name) const;
+	// Add and remove names so that the index contains exactly the given names.
+	// Names that were already in the index do not need to be indexed again.
+	void Assign(const std::vector<const std::string *> &names);
+	void Clear();
+
+	// Get the names that best match the given text, best match first, along with
+	// their score in the range [0, 1]. Names with the same score are sorted by
+	// name. Only names for which the given filter returns true are considered,
+	// and at most the given number of names are returned. If no name matches the
+	// text at all, the first names in alphabetical order are returned instead,
+	// with a score of zero.
+	void Search(const std::string &text, size_t limit, std::vector<std::pair<double, const std::string *>> &result,
+		const std::function<bool(const std::string &)> &filter = {}) const;
+
+
+private:
+	// Get the key of the given pair of characters at the given position. The
+	// last character of the search text only has to match the first character
+	// of the pair, so single characters are indexed too.
+	static uint64_t PairKey(size_t position, char first, char second);
+	static uint64_t CharKey(size_t position, char first);
+	// Get the names that are in the index, in alphabetical order.
+	const std::vector<uint32_t> &Sorted() const;
+
+
+private:
+	struct Entry {
+		std::string name;
+		bool removed = false;
+	};
+	std::vector<Entry> entries;
+	std::unordered_map<std::string, uint32_t> ids;
+	std::unordered_map<uint64_t, std::vector<uint32_t>> postings;
+
+	// The alphabetical list of names, which is only rebuilt when names have
+	// been added or removed since it was last needed.
+	mutable std::vector<uint32_t> sorted;
+	mutable bool isSorted = true;
+	// Scratch space for the searches, kept to avoid allocating it every time.
+	mutable std::vector<uint16_t> counts;
+	mutable std::vector<uint32_t> touched;
+};
+
+
+
+#endif
@@ -27,6 +27,102 @@ using namespace std;
 namespace {
 	const double EPS = 0.0000000001;
 	
+	// The names of the attributes that are looked up often, in the same order
+	// as the Attribute identifiers.
+	const char *const HOT_ATTRIBUTES[] = {
+		"active cooling",
+		"afterburner energy",
+		"afterburner fuel",
+		"afterburner heat",
+		"afterburner thrust",
+		"atmosphere scan",
+		"automaton",
+		"bunks",
+		"burn resistance",
+		"burn resistance energy",
+		"burn resistance fuel",
+		"burn resistance heat",
+		"cargo scan power",
+		"cloak",
+		"cloaking energy",
+		"cloaking fuel",
+		"cloaking heat",
+		"cooling",
+		"cooling energy",
+		"cooling inefficiency",
+		"corrosion resistance",
+		"corrosion resistance energy",
+		"corrosion resistance fuel",
+		"corrosion resistance heat",
+		"discharge resistance",
+		"discharge resistance energy",
+		"discharge resistance fuel",
+		"discharge resistance heat",
+		"disruption resistance",
+		"disruption resistance energy",
+		"disruption resistance fuel",
+		"disruption resistance heat",
+		"drag",
+		"energy capacity",
+		"energy consumption",
+		"energy generation",
+		"fuel capacity",
+		"fuel consumption",
+		"fuel energy",
+		"fuel generation",
+		"fuel heat",
+		"heat dissipation",
+		"heat generation",
+		"hull",
+		"hull energy",
+		"hull energy multiplier",
+		"hull fuel",
+		"hull fuel multiplier",
+		"hull heat",
+		"hull heat multiplier",
+		"hull repair multiplier",
+		"hull repair rate",
+		"hyperdrive",
+		"ion resistance",
+		"ion resistance energy",
+		"ion resistance fuel",
+		"ion resistance heat",
+		"jump drive",
+		"jump range",
+		"jump speed",
+		"leak resistance",
+		"leak resistance energy",
+		"leak resistance fuel",
+		"leak resistance heat",
+		"outfit scan power",
+		"ramscoop",
+		"required crew",
+		"reverse thrust",
+		"scram drive",
+		"self destruct",
+		"shield energy",
+		"shield energy multiplier",
+		"shield fuel",
+		"shield fuel multiplier",
+		"shield generation",
+		"shield generation multiplier",
+		"shield heat",
+		"shield heat multiplier",
+		"shields",
+		"slowing resistance",
+		"slowing resistance energy",
+		"slowing resistance fuel",
+		"slowing resistance heat",
+		"solar collection",
+		"solar heat",
+		"thrust",
+		"turn",
+		"turning energy",
+		"turning heat",
+	};
+	static_assert(sizeof(HOT_ATTRIBUTES) / sizeof(*HOT_ATTRIBUTES) == static_cast<size_t>(Attribute::COUNT),
+		"Every hot attribute must have a name.");
+	
 	// A mapping of attribute names to specifically-allowed minimum values. Based on the
 	// specific usage of the attribute, the allowed minimum value is chosen to avoid
 	// disallowed or undesirable behaviors (such as dividing by zero).
@@ -186,7 +282,7 @@ void Outfit::Load(const DataNode &node)
 			// Add any new licenses that were specified "inline".
 			if(child.Size() >= 2)
 			{
-				for(auto it = ++begin(child.Tokens()); it != end(child.Tokens()); ++it)
+				for(auto it = next(begin(child.Tokens())); it != end(child.Tokens()); ++it)
 					if(isNewLicense(licenses, *it))
 						licenses.push_back(*it);
 			}
@@ -240,6 +336,8 @@ void Outfit::Load(const DataNode &node)
 	};
 	convertScan("outfit");
 	convertScan("cargo");
+	
+	UpdateHotAttributes();
 }
 
 
@@ -368,6 +466,7 @@ void Outfit::Add(const Outfit &other, int count)
 		if(fabs(attributes[at.first]) < EPS)
 			attributes[at.first] = 0.;
 	}
+	UpdateHotAttributes();
 	
 	for(const auto &it : other.flareSprites)
 		AddFlareSprites(flareSprites, it, count);
@@ -394,6 +493,7 @@ void Outfit::Add(const Outfit &other, int count)
 void Outfit::Set(const char *attribute, double value)
 {
 	attributes[attribute] = value;
+	UpdateHotAttributes();
 }
 
 
@@ -504,3 +604,12 @@ const Sprite *Outfit::FlotsamSprite() const
 {
 	return flotsamSprite;
 }
+
+
+
+// Update the copies of the attributes that are looked up often.
+void Outfit::UpdateHotAttributes()
+{
+	for(int i = 0; i < static_cast<int>(Attribute::COUNT); ++i)
+		hotAttributes[i] = attributes.Get(HOT_ATTRIBUTES[i]);
+}
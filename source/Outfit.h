@@ -15,6 +15,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #include "Weapon.h"
 
+#include "Attribute.h"
 #include "Dictionary.h"
 
 #include <map>
@@ -61,6 +62,8 @@ public:
 	
 	double Get(const char *attribute) const;
 	double Get(const std::string &attribute) const;
+	// Get one of the attributes that are looked up often, without a search.
+	double Get(Attribute attribute) const;
 	const Dictionary &Attributes() const;
 	
 	// Determine whether the given number of instances of the given outfit can
@@ -95,6 +98,11 @@ public:
 	const Sprite *FlotsamSprite() const;
 	
 	
+private:
+	// Update the copies of the attributes that are looked up often.
+	void UpdateHotAttributes();
+	
+	
 private:
 	bool isDefined = false;
 	std::string name;
@@ -127,6 +135,10 @@ private:
 	std::map<const Sound *, int> jumpOutSounds;
 	const Sprite *flotsamSprite = nullptr;
 
+	// A copy of the values of the attributes that the engine looks up often.
+	// This must be updated whenever the attributes are changed.
+	double hotAttributes[static_cast<int>(Attribute::COUNT)] = {};
+
 	friend class ShipEditor;
 	friend class OutfitEditor;
 };
@@ -136,6 +148,7 @@ private:
 // These get called a lot, so inline them for speed.
 inline int64_t Outfit::Cost() const { return cost; }
 inline double Outfit::Mass() const { return mass; }
+inline double Outfit::Get(Attribute attribute) const { return hotAttributes[static_cast<int>(attribute)]; }
 
 
 
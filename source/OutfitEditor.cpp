@@ -300,7 +300,10 @@ void OutfitEditor::RenderOutfit()
 		{
 			for(auto &ship : editor.Player().Ships())
 				if(auto count = ship->OutfitCount(object))
+				{
 					ship->attributes.attributes.Update(attr, diff * count);
+					ship->attributes.UpdateHotAttributes();
+				}
 		};
 		for(auto &it : object->attributes)
 		{
@@ -313,6 +316,7 @@ void OutfitEditor::RenderOutfit()
 			if(!it.second && !ImGui::IsInputFocused(it.first))
 				object->attributes.Remove(it.first);
 		}
+		object->UpdateHotAttributes();
 
 		ImGui::Spacing();
 		static string addAttribute;
@@ -1802,7 +1802,7 @@ int64_t PlayerInfo::GetCondition(const string &name) const
 
 
 // Get mutable access to the player's list of conditions.
-map<string, int64_t> &PlayerInfo::Conditions()
+ConditionsStore &PlayerInfo::Conditions()
 {
 	return conditions;
 }
@@ -1810,7 +1810,7 @@ map<string, int64_t> &PlayerInfo::Conditions()
 
 
 // Access the player's list of conditions.
-const map<string, int64_t> &PlayerInfo::Conditions() const
+const ConditionsStore &PlayerInfo::Conditions() const
 {
 	return conditions;
 }
@@ -2536,7 +2536,7 @@ void PlayerInfo::UpdateAutoConditions(bool isBoarding)
 	// Serialize the current reputation with other governments.
 	SetReputationConditions();
 	// Helper lambda function to clear a range
-	auto clearRange = [](map<string, int64_t> &conditionsMap, string firstStr, string lastStr)
+	auto clearRange = [](ConditionsStore &conditionsMap, string firstStr, string lastStr)
 	{
 		auto first = conditionsMap.lower_bound(firstStr);
 		auto last = conditionsMap.lower_bound(lastStr);
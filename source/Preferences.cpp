@@ -28,6 +28,8 @@ using namespace std;
 namespace {
 	map<string, bool> settings;
 	int scrollSpeed = 60;
+	// The memory, in megabytes, that images loaded on demand may take up.
+	int imageMemory = 128;
 	
 	// Strings for ammo expenditure:
 	const string EXPEND_AMMO = "Escorts expend ammo";
@@ -76,6 +78,8 @@ void Preferences::Load()
 			Audio::SetVolume(node.Value(1) * VOLUME_SCALE);
 		else if(node.Token(0) == "scroll speed" && node.Size() >= 2)
 			scrollSpeed = node.Value(1);
+		else if(node.Token(0) == "image memory" && node.Size() >= 2)
+			imageMemory = max<int>(0, node.Value(1));
 		else if(node.Token(0) == "view zoom")
 			zoomIndex = max<int>(0, min<int>(node.Value(1), ZOOMS.size() - 1));
 		else if(node.Token(0) == "vsync")
@@ -95,6 +99,7 @@ void Preferences::Save()
 	out.Write("window size", Screen::RawWidth(), Screen::RawHeight());
 	out.Write("zoom", Screen::UserZoom());
 	out.Write("scroll speed", scrollSpeed);
+	out.Write("image memory", imageMemory);
 	out.Write("view zoom", zoomIndex);
 	out.Write("vsync", vsyncIndex);
 	
@@ -151,6 +156,14 @@ void Preferences::SetScrollSpeed(int speed)
 
 
 
+// Memory budget for images that are loaded on demand, in megabytes.
+int Preferences::ImageMemory()
+{
+	return imageMemory;
+}
+
+
+
 // View zoom.
 double Preferences::ViewZoom()
 {
@@ -42,6 +42,9 @@ public:
 	static int ScrollSpeed();
 	static void SetScrollSpeed(int speed);
 	
+	// Memory budget for images that are loaded on demand, in megabytes.
+	static int ImageMemory();
+	
 	// View zoom.
 	static double ViewZoom();
 	static bool ZoomViewIn();
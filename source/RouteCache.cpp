@@ -0,0 +1,121 @@
+/* RouteCache.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "RouteCache.h"
+
+#include "DistanceMap.h"
+#include "Planet.h"
+#include "Ship.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// Once this many maps are cached, start over, so that the cache cannot
+	// grow without bound over a long play session.
+	const size_t MAX_SIZE = 256;
+
+	// The maps are identified by where they end and what drives are used,
+	// i.e. the fuel used per hyperdrive jump and per jump drive jump, the jump
+	// range, and whether wormholes can be used.
+	using Key = tuple<const System *, int, int, double, bool>;
+
+	mutex cacheMutex;
+	map<Key, vector<shared_ptr<const DistanceMap>>> cache;
+	size_t cacheSize = 0;
+
+	// Cache the given map, which has the given key. The cache mutex must be held.
+	shared_ptr<const DistanceMap> Add(const Key &key, shared_ptr<const DistanceMap> distance)
+	{
+		if(cacheSize >= MAX_SIZE)
+		{
+			cache.clear();
+			cacheSize = 0;
+		}
+		cache[key].push_back(distance);
+		++cacheSize;
+		return distance;
+	}
+}
+
+
+
+// Get the paths from every system to the given destination for the given ship.
+shared_ptr<const DistanceMap> RouteCache::Get(const Ship &ship, const System *destination)
+{
+	// Ships with no drives can only use the wormholes in their own system, so
+	// their routes depend on where they are. Those are not worth caching.
+	int hyperspaceFuel = ship.HyperdriveFuel();
+	int jumpFuel = ship.JumpDriveFuel();
+	if(!ship.GetSystem() || !destination || (!hyperspaceFuel && !jumpFuel))
+		return make_shared<const DistanceMap>(ship, destination);
+
+	// This must match how DistanceMap::Init() decides which drives to use.
+	if(hyperspaceFuel == jumpFuel)
+		hyperspaceFuel = 0;
+	const Key key(destination, hyperspaceFuel, jumpFuel, jumpFuel ? ship.JumpRange() : 0., true);
+
+	lock_guard<mutex> lock(cacheMutex);
+	auto it = cache.find(key);
+	if(it != cache.end())
+		for(const shared_ptr<const DistanceMap> &distance : it->second)
+		{
+			// The map was found for some ship with the same drives as this one,
+			// but it only applies to this ship if it has access to the same
+			// wormholes that the paths depended on.
+			bool matches = true;
+			for(const auto &wormhole : distance->wormholes)
+				matches &= (wormhole.first->IsAccessible(&ship) == wormhole.second);
+			if(matches)
+				return distance;
+		}
+
+	return Add(key, shared_ptr<const DistanceMap>(new DistanceMap(destination, ship)));
+}
+
+
+
+// Get the number of hyperspace jumps to every system from the given one.
+shared_ptr<const DistanceMap> RouteCache::Get(const System *center)
+{
+	const Key key(center, 100, 0, 0., false);
+
+	lock_guard<mutex> lock(cacheMutex);
+	auto it = cache.find(key);
+	if(it != cache.end())
+		return it->second.front();
+
+	return Add(key, make_shared<const DistanceMap>(center));
+}
+
+
+
+// Forget all the cached maps, because the systems have changed.
+void RouteCache::Clear()
+{
+	lock_guard<mutex> lock(cacheMutex);
+	cache.clear();
+	cacheSize = 0;
+}
+
+
+
+// Get the number of maps that are currently cached.
+size_t RouteCache::Size()
+{
+	lock_guard<mutex> lock(cacheMutex);
+	return cacheSize;
+}
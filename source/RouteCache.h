@@ -0,0 +1,49 @@
+/* RouteCache.h
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef ROUTE_CACHE_H_
+#define ROUTE_CACHE_H_
+
+#include <memory>
+
+class DistanceMap;
+class Ship;
+class System;
+
+
+
+// Class that remembers the distance maps that have been calculated, so that
+// routes to the same system only need to be found once for all the ships that
+// have the same drives, instead of every time a ship decides where to go next.
+// The cached maps stay valid until the systems, the links between them or the
+// wormholes change, at which point Clear() must be called. Maps that depend on
+// what the player knows are never cached. All functions may be called from the
+// main thread and the game's calculation thread at once.
+class RouteCache {
+public:
+	// Get the paths from every system to the given destination for the given
+	// ship. The route for its own system is the same as DistanceMap(ship,
+	// destination) would find.
+	static std::shared_ptr<const DistanceMap> Get(const Ship &ship, const System *destination);
+	// Get the number of hyperspace jumps to every system from the given one,
+	// i.e. the same as DistanceMap(center) without any limits.
+	static std::shared_ptr<const DistanceMap> Get(const System *center);
+
+	// Forget all the cached maps, because the systems have changed.
+	static void Clear();
+	// Get the number of maps that are currently cached.
+	static size_t Size();
+};
+
+
+
+#endif
@@ -13,21 +13,103 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #ifndef SET_H_
 #define SET_H_
 
-#include <map>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 
 // Template representing a set of named objects of a given type, where you can
 // query it for a pointer to any object and it will return one, whether or not that
-// object has been loaded yet. (This allows cyclic pointers.)
+// object has been loaded yet. (This allows cyclic pointers.) Lookups by name are
+// hashed. Iterating visits the objects in order of their names, using a sorted
+// list of the objects that is kept up to date as they are added, renamed or
+// removed, so a set that is not being changed can be iterated by any number of
+// threads at once. Pointers to the objects stay valid until they are removed
+// from the set.
 template<class Type>
 class Set {
+private:
+	using Data = std::unordered_map<std::string, Type>;
+	using Entry = typename Data::value_type;
+	
+	// Iterator over the objects in order of their names. Like a std::map
+	// iterator, it stays valid if objects are added while iterating. It then
+	// continues after the object it points to, so objects added after that one
+	// will be visited and those added before it will not.
+	template <bool IsConst>
+	class Iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Entry;
+		using difference_type = std::ptrdiff_t;
+		using pointer = typename std::conditional<IsConst, const value_type *, value_type *>::type;
+		using reference = typename std::conditional<IsConst, const value_type &, value_type &>::type;
+		
+		Iterator() noexcept = default;
+		Iterator(const Set *set, size_t index) noexcept
+			: set(set), entry(index < set->sorted.size() ? set->sorted[index] : nullptr),
+			index(index), revision(set->revision) {}
+		// A non-const iterator can be converted to a const one.
+		operator Iterator<true>() const noexcept { return Iterator<true>(set, entry, index, revision); }
+		
+		reference operator*() const noexcept { return *entry; }
+		pointer operator->() const noexcept { return entry; }
+		Iterator &operator++() noexcept
+		{
+			// If objects have been added or renamed since this iterator was last
+			// moved, the object it points to may have moved in the sorted list.
+			if(revision != set->revision)
+			{
+				index = set->LowerBound(entry->first) - set->sorted.begin();
+				revision = set->revision;
+			}
+			++index;
+			entry = (index < set->sorted.size() ? set->sorted[index] : nullptr);
+			return *this;
+		}
+		Iterator operator++(int) noexcept { Iterator it = *this; ++*this; return it; }
+		bool operator==(const Iterator &other) const noexcept { return entry == other.entry; }
+		bool operator!=(const Iterator &other) const noexcept { return entry != other.entry; }
+		
+	private:
+		Iterator(const Set *set, Entry *entry, size_t index, size_t revision) noexcept
+			: set(set), entry(entry), index(index), revision(revision) {}
+		
+	private:
+		const Set *set = nullptr;
+		// The object this iterator points to, or null if it is past the end.
+		Entry *entry = nullptr;
+		// Where that object was in the sorted list when the set had the given
+		// revision. If the set has changed since then, it must be found again.
+		size_t index = 0;
+		size_t revision = 0;
+		
+		friend class Iterator<!IsConst>;
+	};
+	
+	
 public:
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+	
+	Set() = default;
+	// The sorted list refers to the objects of a particular set, so it has to
+	// be made again for a copy.
+	Set(const Set &other) : data(other.data) { Sort(); }
+	Set &operator=(const Set &other) { data = other.data; Sort(); ++revision; return *this; }
+	Set(Set &&other) noexcept : data(std::move(other.data)), sorted(std::move(other.sorted)) { other.clear(); }
+	Set &operator=(Set &&other) noexcept;
+	
 	// Allow non-const access to the owner of this set; it can hand off only
 	// const references to avoid anyone else modifying the objects.
-	Type *Get(const std::string &name) { return &data[name]; }
-	const Type *Get(const std::string &name) const { return &data[name]; }
+	Type *Get(const std::string &name) { return &Insert(name); }
+	const Type *Get(const std::string &name) const { return &Insert(name); }
 	// If an item already exists in this set, get it. Otherwise, return a null
 	// pointer rather than creating the item.
 	Type *Find(const std::string &name);
@@ -35,26 +117,55 @@ public:
 	
 	bool Has(const std::string &name) const { return data.count(name); }
 	void Rename(const std::string &name, const std::string &newName) const;
-	void Erase(const std::string &name) const { data[name] = {}; }
+	void Erase(const std::string &name) const { Insert(name) = {}; }
 	
-	typename std::map<std::string, Type>::iterator begin() { return data.begin(); }
-	typename std::map<std::string, Type>::const_iterator begin() const { return data.begin(); }
-	typename std::map<std::string, Type>::iterator end() { return data.end(); }
-	typename std::map<std::string, Type>::const_iterator end() const { return data.end(); }
+	iterator begin() { return iterator(this, 0); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	iterator end() { return iterator(); }
+	const_iterator end() const { return const_iterator(); }
 	
 	int size() const { return data.size(); }
-	void clear() const { data.clear(); }
+	void clear() const { data.clear(); sorted.clear(); ++revision; }
+	// Get a number that changes whenever objects are added to, removed from or
+	// renamed in this set, so that anything derived from the names of the
+	// objects knows when it has to be updated.
+	size_t Revision() const { return revision; }
 	// Remove any objects in this set that are not in the given set, and for
 	// those that are in the given set, revert to their contents.
 	void Revert(const Set<Type> &other);
 	
 	
 private:
-	mutable std::map<std::string, Type> data;
+	// Get the object with the given name, creating it if necessary.
+	Type &Insert(const std::string &name) const;
+	// Get the place in the sorted list where the object with the given name is,
+	// or where it would be if it was added.
+	typename std::vector<Entry *>::iterator LowerBound(const std::string &name) const;
+	// Make the sorted list from scratch.
+	void Sort() const;
+	
+	
+private:
+	mutable Data data;
+	// Pointers to all the objects in the set, sorted by name.
+	mutable std::vector<Entry *> sorted;
+	mutable size_t revision = 0;
 };
 
 
 
+template <class Type>
+Set<Type> &Set<Type>::operator=(Set &&other) noexcept
+{
+	data = std::move(other.data);
+	sorted = std::move(other.sorted);
+	++revision;
+	other.clear();
+	return *this;
+}
+
+
+
 template <class Type>
 const Type *Set<Type>::Find(const std::string &name) const
 {
@@ -75,9 +186,16 @@ Type *Set<Type>::Find(const std::string &name)
 template <typename T>
 void Set<T>::Rename(const std::string &name, const std::string &newName) const
 {
+	auto it = LowerBound(name);
+	if(it != sorted.end() && (*it)->first == name)
+		sorted.erase(it);
+	
 	auto node = data.extract(name);
 	node.key() = newName;
-	data.insert(std::move(node));
+	auto result = data.insert(std::move(node));
+	if(result.inserted)
+		sorted.insert(LowerBound(newName), &*result.position);
+	++revision;
 }
 
 
@@ -85,25 +203,76 @@ void Set<T>::Rename(const std::string &name, const std::string &newName) const
 template <class Type>
 void Set<Type>::Revert(const Set<Type> &other)
 {
-	auto it = data.begin();
-	auto oit = other.data.begin();
+	// Take the objects that are about to be removed out of the sorted list.
+	auto removed = std::remove_if(sorted.begin(), sorted.end(),
+		[&other](const Entry *entry) noexcept -> bool
+		{
+			return !other.data.count(entry->first);
+		});
+	if(removed != sorted.end())
+	{
+		sorted.erase(removed, sorted.end());
+		++revision;
+	}
 	
-	while(it != data.end())
+	for(auto it = data.begin(); it != data.end(); )
 	{
-		if(oit == other.data.end() || it->first < oit->first)
+		auto oit = other.data.find(it->first);
+		if(oit == other.data.end())
 			it = data.erase(it);
-		else if(it->first == oit->first)
+		else
 		{
 			// If this is an entry that is in the set we are reverting to, copy
 			// the state we are reverting to.
 			it->second = oit->second;
 			++it;
-			++oit;
 		}
-		
-		// There should never be a case when an entry in the set we are
-		// reverting to has a name that is not also in this set.
 	}
+	
+	// There should never be a case when an entry in the set we are
+	// reverting to has a name that is not also in this set.
+}
+
+
+
+template <class Type>
+Type &Set<Type>::Insert(const std::string &name) const
+{
+	auto result = data.try_emplace(name);
+	if(result.second)
+	{
+		sorted.insert(LowerBound(name), &*result.first);
+		++revision;
+	}
+	return result.first->second;
+}
+
+
+
+template <class Type>
+typename std::vector<typename Set<Type>::Entry *>::iterator Set<Type>::LowerBound(const std::string &name) const
+{
+	return std::lower_bound(sorted.begin(), sorted.end(), name,
+		[](const Entry *entry, const std::string &name) noexcept -> bool
+		{
+			return entry->first < name;
+		});
+}
+
+
+
+template <class Type>
+void Set<Type>::Sort() const
+{
+	sorted.clear();
+	sorted.reserve(data.size());
+	for(auto &it : data)
+		sorted.push_back(&it);
+	std::sort(sorted.begin(), sorted.end(),
+		[](const Entry *a, const Entry *b) noexcept -> bool
+		{
+			return a->first < b->first;
+		});
 }
 
 
@@ -588,7 +588,7 @@ void Ship::FinishLoading(bool isNewInstance, const Set<Ship> *ships, const Set<E
 	
 	// Mark any drone that has no "automaton" value as an automaton, to
 	// grandfather in the drones from before that attribute existed.
-	if(baseAttributes.Category() == "Drone" && !baseAttributes.Get("automaton"))
+	if(baseAttributes.Category() == "Drone" && !baseAttributes.Get(Attribute::AUTOMATON))
 		baseAttributes.Set("automaton", 1.);
 	
 	baseAttributes.Set("gun ports", armament.GunCount());
@@ -712,9 +712,9 @@ void Ship::FinishLoading(bool isNewInstance, const Set<Ship> *ships, const Set<E
 		if(val < 0)
 			warning += attr + ": " + Format::Number(val) + "\n";
 	}
-	if(attributes.Get("drag") <= 0.)
+	if(attributes.Get(Attribute::DRAG) <= 0.)
 	{
-		warning += "Defaulting " + string(attributes.Get("drag") ? "invalid" : "missing") + " \"drag\" attribute to 100.0\n";
+		warning += "Defaulting " + string(attributes.Get(Attribute::DRAG) ? "invalid" : "missing") + " \"drag\" attribute to 100.0\n";
 		attributes.Set("drag", 100.);
 	}
 	if(!warning.empty())
@@ -1080,22 +1080,22 @@ vector<string> Ship::FlightCheck() const
 {
 	auto checks = vector<string>{};
 	
-	double generation = attributes.Get("energy generation") - attributes.Get("energy consumption");
-	double consuming = attributes.Get("fuel energy");
-	double solar = attributes.Get("solar collection");
-	double battery = attributes.Get("energy capacity");
+	double generation = attributes.Get(Attribute::ENERGY_GENERATION) - attributes.Get(Attribute::ENERGY_CONSUMPTION);
+	double consuming = attributes.Get(Attribute::FUEL_ENERGY);
+	double solar = attributes.Get(Attribute::SOLAR_COLLECTION);
+	double battery = attributes.Get(Attribute::ENERGY_CAPACITY);
 	double energy = generation + consuming + solar + battery;
-	double fuelChange = attributes.Get("fuel generation") - attributes.Get("fuel consumption");
-	double fuelCapacity = attributes.Get("fuel capacity");
+	double fuelChange = attributes.Get(Attribute::FUEL_GENERATION) - attributes.Get(Attribute::FUEL_CONSUMPTION);
+	double fuelCapacity = attributes.Get(Attribute::FUEL_CAPACITY);
 	double fuel = fuelCapacity + fuelChange;
-	double thrust = attributes.Get("thrust");
-	double reverseThrust = attributes.Get("reverse thrust");
-	double afterburner = attributes.Get("afterburner thrust");
+	double thrust = attributes.Get(Attribute::THRUST);
+	double reverseThrust = attributes.Get(Attribute::REVERSE_THRUST);
+	double afterburner = attributes.Get(Attribute::AFTERBURNER_THRUST);
 	double thrustEnergy = attributes.Get("thrusting energy");
-	double turn = attributes.Get("turn");
-	double turnEnergy = attributes.Get("turning energy");
-	double hyperDrive = attributes.Get("hyperdrive");
-	double jumpDrive = attributes.Get("jump drive");
+	double turn = attributes.Get(Attribute::TURN);
+	double turnEnergy = attributes.Get(Attribute::TURNING_ENERGY);
+	double hyperDrive = attributes.Get(Attribute::HYPERDRIVE);
+	double jumpDrive = attributes.Get(Attribute::JUMP_DRIVE);
 	
 	// Report the first error condition that will prevent takeoff:
 	if(IdleHeat() >= MaximumHeat())
@@ -1366,7 +1366,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 		return;
 	}
 	isInSystem = false;
-	if(!fuel || !(attributes.Get("hyperdrive") || attributes.Get("jump drive")))
+	if(!fuel || !(attributes.Get(Attribute::HYPERDRIVE) || attributes.Get(Attribute::JUMP_DRIVE)))
 		hyperspaceSystem = nullptr;
 	
 	// Adjust the error in the pilot's targeting.
@@ -1410,16 +1410,16 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 		if(!cloak)
 			cloakDisruption = max(0., cloakDisruption - 1.);
 		
-		double cloakingSpeed = attributes.Get("cloak");
+		double cloakingSpeed = attributes.Get(Attribute::CLOAK);
 		bool canCloak = (!isDisabled && cloakingSpeed > 0. && !cloakDisruption
-			&& fuel >= attributes.Get("cloaking fuel")
-			&& energy >= attributes.Get("cloaking energy"));
+			&& fuel >= attributes.Get(Attribute::CLOAKING_FUEL)
+			&& energy >= attributes.Get(Attribute::CLOAKING_ENERGY));
 		if(commands.Has(Command::CLOAK) && canCloak)
 		{
 			cloak = min(1., cloak + cloakingSpeed);
-			fuel -= attributes.Get("cloaking fuel");
-			energy -= attributes.Get("cloaking energy");
-			heat += attributes.Get("cloaking heat");
+			fuel -= attributes.Get(Attribute::CLOAKING_FUEL);
+			energy -= attributes.Get(Attribute::CLOAKING_ENERGY);
+			heat += attributes.Get(Attribute::CLOAKING_HEAT);
 		}
 		else if(cloakingSpeed)
 		{
@@ -1700,7 +1700,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 			}
 		}
 		// Only refuel if this planet has a spaceport.
-		else if(fuel >= attributes.Get("fuel capacity")
+		else if(fuel >= attributes.Get(Attribute::FUEL_CAPACITY)
 				|| !landingPlanet || !landingPlanet->HasSpaceport())
 		{
 			zoom = min(1.f, zoom + .02f);
@@ -1708,7 +1708,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 			landingPlanet = nullptr;
 		}
 		else
-			fuel = min(fuel + 1., attributes.Get("fuel capacity"));
+			fuel = min(fuel + 1., attributes.Get(Attribute::FUEL_CAPACITY));
 		
 		// Move the ship at the velocity it had when it began landing, but
 		// scaled based on how small it is now.
@@ -1726,7 +1726,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 	else if(commands.Has(Command::JUMP) && IsReadyToJump())
 	{
 		hyperspaceSystem = GetTargetSystem();
-		isUsingJumpDrive = !attributes.Get("hyperdrive") || !currentSystem->Links().count(hyperspaceSystem);
+		isUsingJumpDrive = !attributes.Get(Attribute::HYPERDRIVE) || !currentSystem->Links().count(hyperspaceSystem);
 		hyperspaceFuelCost = JumpFuel(hyperspaceSystem);
 	}
 	
@@ -1756,13 +1756,13 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 	double mass = Mass();
 	bool isUsingAfterburner = false;
 	if(isDisabled)
-		velocity *= 1. - attributes.Get("drag") / mass;
+		velocity *= 1. - attributes.Get(Attribute::DRAG) / mass;
 	else if(!pilotError)
 	{
 		if(commands.Turn())
 		{
 			// Check if we are able to turn.
-			double cost = attributes.Get("turning energy");
+			double cost = attributes.Get(Attribute::TURNING_ENERGY);
 			if(energy < cost * fabs(commands.Turn()))
 				commands.SetTurn(commands.Turn() * energy / (cost * fabs(commands.Turn())));
 			
@@ -1775,7 +1775,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				// of the turning energy and produce a fraction of the heat.
 				double scale = fabs(commands.Turn());
 				energy -= scale * cost;
-				heat += scale * attributes.Get("turning heat");
+				heat += scale * attributes.Get(Attribute::TURNING_HEAT);
 				angle += commands.Turn() * TurnRate() * slowMultiplier;
 			}
 		}
@@ -1794,7 +1794,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				// If a reverse thrust is commanded and the capability does not
 				// exist, ignore it (do not even slow under drag).
 				isThrusting = (thrustCommand > 0.);
-				isReversing = !isThrusting && attributes.Get("reverse thrust");
+				isReversing = !isThrusting && attributes.Get(Attribute::REVERSE_THRUST);
 				thrust = attributes.Get(isThrusting ? "thrust" : "reverse thrust");
 				if(thrust)
 				{
@@ -1809,12 +1809,12 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				&& !CannotAct();
 		if(applyAfterburner)
 		{
-			thrust = attributes.Get("afterburner thrust");
-			double fuelCost = attributes.Get("afterburner fuel");
-			double energyCost = attributes.Get("afterburner energy");
+			thrust = attributes.Get(Attribute::AFTERBURNER_THRUST);
+			double fuelCost = attributes.Get(Attribute::AFTERBURNER_FUEL);
+			double energyCost = attributes.Get(Attribute::AFTERBURNER_ENERGY);
 			if(thrust && fuel >= fuelCost && energy >= energyCost)
 			{
-				heat += attributes.Get("afterburner heat");
+				heat += attributes.Get(Attribute::AFTERBURNER_HEAT);
 				fuel -= fuelCost;
 				energy -= energyCost;
 				acceleration += angle.Unit() * thrust / mass;
@@ -1827,7 +1827,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 	if(acceleration)
 	{
 		acceleration *= slowMultiplier;
-		Point dragAcceleration = acceleration - velocity * (attributes.Get("drag") / mass);
+		Point dragAcceleration = acceleration - velocity * (attributes.Get(Attribute::DRAG) / mass);
 		// Make sure dragAcceleration has nonzero length, to avoid divide by zero.
 		if(dragAcceleration)
 		{
@@ -1908,7 +1908,7 @@ void Ship::Move(vector<Visual> &visuals, list<shared_ptr<Flotsam>> &flotsam)
 				{
 					isBoarding = false;
 					bool isEnemy = government->IsEnemy(target->government);
-					if(isEnemy && Random::Real() < target->Attributes().Get("self destruct"))
+					if(isEnemy && Random::Real() < target->Attributes().Get(Attribute::SELF_DESTRUCT))
 					{
 						Messages::Add("The " + target->ModelName() + " \"" + target->Name()
 							+ "\" has activated its self-destruct mechanism.", Messages::Importance::High);
@@ -1962,21 +1962,21 @@ void Ship::DoGeneration()
 		// 4. Shields of carried fighters
 		// 5. Transfer of excess energy and fuel to carried fighters.
 		
-		const double hullAvailable = attributes.Get("hull repair rate") * (1. + attributes.Get("hull repair multiplier"));
-		const double hullEnergy = (attributes.Get("hull energy") * (1. + attributes.Get("hull energy multiplier"))) / hullAvailable;
-		const double hullFuel = (attributes.Get("hull fuel") * (1. + attributes.Get("hull fuel multiplier"))) / hullAvailable;
-		const double hullHeat = (attributes.Get("hull heat") * (1. + attributes.Get("hull heat multiplier"))) / hullAvailable;
+		const double hullAvailable = attributes.Get(Attribute::HULL_REPAIR_RATE) * (1. + attributes.Get(Attribute::HULL_REPAIR_MULTIPLIER));
+		const double hullEnergy = (attributes.Get(Attribute::HULL_ENERGY) * (1. + attributes.Get(Attribute::HULL_ENERGY_MULTIPLIER))) / hullAvailable;
+		const double hullFuel = (attributes.Get(Attribute::HULL_FUEL) * (1. + attributes.Get(Attribute::HULL_FUEL_MULTIPLIER))) / hullAvailable;
+		const double hullHeat = (attributes.Get(Attribute::HULL_HEAT) * (1. + attributes.Get(Attribute::HULL_HEAT_MULTIPLIER))) / hullAvailable;
 		double hullRemaining = hullAvailable;
 		if(!hullDelay)
-			DoRepair(hull, hullRemaining, attributes.Get("hull"), energy, hullEnergy, fuel, hullFuel, heat, hullHeat);
+			DoRepair(hull, hullRemaining, attributes.Get(Attribute::HULL), energy, hullEnergy, fuel, hullFuel, heat, hullHeat);
 		
-		const double shieldsAvailable = attributes.Get("shield generation") * (1. + attributes.Get("shield generation multiplier"));
-		const double shieldsEnergy = (attributes.Get("shield energy") * (1. + attributes.Get("shield energy multiplier"))) / shieldsAvailable;
-		const double shieldsFuel = (attributes.Get("shield fuel") * (1. + attributes.Get("shield fuel multiplier"))) / shieldsAvailable;
-		const double shieldsHeat = (attributes.Get("shield heat") * (1. + attributes.Get("shield heat multiplier"))) / shieldsAvailable;
+		const double shieldsAvailable = attributes.Get(Attribute::SHIELD_GENERATION) * (1. + attributes.Get(Attribute::SHIELD_GENERATION_MULTIPLIER));
+		const double shieldsEnergy = (attributes.Get(Attribute::SHIELD_ENERGY) * (1. + attributes.Get(Attribute::SHIELD_ENERGY_MULTIPLIER))) / shieldsAvailable;
+		const double shieldsFuel = (attributes.Get(Attribute::SHIELD_FUEL) * (1. + attributes.Get(Attribute::SHIELD_FUEL_MULTIPLIER))) / shieldsAvailable;
+		const double shieldsHeat = (attributes.Get(Attribute::SHIELD_HEAT) * (1. + attributes.Get(Attribute::SHIELD_HEAT_MULTIPLIER))) / shieldsAvailable;
 		double shieldsRemaining = shieldsAvailable;
 		if(!shieldDelay)
-			DoRepair(shields, shieldsRemaining, attributes.Get("shields"), energy, shieldsEnergy, fuel, shieldsFuel, heat, shieldsHeat);
+			DoRepair(shields, shieldsRemaining, attributes.Get(Attribute::SHIELDS), energy, shieldsEnergy, fuel, shieldsFuel, heat, shieldsHeat);
 		
 		if(!bays.empty())
 		{
@@ -2000,22 +2000,22 @@ void Ship::DoGeneration()
 			{
 				Ship &ship = *it.second;
 				if(!hullDelay)
-					DoRepair(ship.hull, hullRemaining, ship.attributes.Get("hull"), energy, hullEnergy, heat, hullHeat, fuel, hullFuel);
+					DoRepair(ship.hull, hullRemaining, ship.attributes.Get(Attribute::HULL), energy, hullEnergy, heat, hullHeat, fuel, hullFuel);
 				if(!shieldDelay)
-					DoRepair(ship.shields, shieldsRemaining, ship.attributes.Get("shields"), energy, shieldsEnergy, heat, shieldsHeat, fuel, shieldsFuel);
+					DoRepair(ship.shields, shieldsRemaining, ship.attributes.Get(Attribute::SHIELDS), energy, shieldsEnergy, heat, shieldsHeat, fuel, shieldsFuel);
 			}
 			
 			// Now that there is no more need to use energy for hull and shield
 			// repair, if there is still excess energy, transfer it.
-			double energyRemaining = energy - attributes.Get("energy capacity");
-			double fuelRemaining = fuel - attributes.Get("fuel capacity");
+			double energyRemaining = energy - attributes.Get(Attribute::ENERGY_CAPACITY);
+			double fuelRemaining = fuel - attributes.Get(Attribute::FUEL_CAPACITY);
 			for(const pair<double, Ship *> &it : carried)
 			{
 				Ship &ship = *it.second;
 				if(energyRemaining > 0.)	
-					DoRepair(ship.energy, energyRemaining, ship.attributes.Get("energy capacity"));	
+					DoRepair(ship.energy, energyRemaining, ship.attributes.Get(Attribute::ENERGY_CAPACITY));	
 				if(fuelRemaining > 0.)	
-					DoRepair(ship.fuel, fuelRemaining, ship.attributes.Get("fuel capacity"));
+					DoRepair(ship.fuel, fuelRemaining, ship.attributes.Get(Attribute::FUEL_CAPACITY));
 			}
 		}
 		// Decrease the shield and hull delays by 1 now that shield generation
@@ -2033,64 +2033,64 @@ void Ship::DoGeneration()
 	// TODO: Mothership gives status resistance to carried ships?
 	if(ionization)
 	{
-		double ionResistance = attributes.Get("ion resistance");
-		double ionEnergy = attributes.Get("ion resistance energy") / ionResistance;
-		double ionFuel = attributes.Get("ion resistance fuel") / ionResistance;
-		double ionHeat = attributes.Get("ion resistance heat") / ionResistance;
+		double ionResistance = attributes.Get(Attribute::ION_RESISTANCE);
+		double ionEnergy = attributes.Get(Attribute::ION_RESISTANCE_ENERGY) / ionResistance;
+		double ionFuel = attributes.Get(Attribute::ION_RESISTANCE_FUEL) / ionResistance;
+		double ionHeat = attributes.Get(Attribute::ION_RESISTANCE_HEAT) / ionResistance;
 		DoStatusEffect(isDisabled, ionization, ionResistance, energy, ionEnergy, fuel, ionFuel, heat, ionHeat);
 	}
 	
 	if(disruption)
 	{
-		double disruptionResistance = attributes.Get("disruption resistance");
-		double disruptionEnergy = attributes.Get("disruption resistance energy") / disruptionResistance;
-		double disruptionFuel = attributes.Get("disruption resistance fuel") / disruptionResistance;
-		double disruptionHeat = attributes.Get("disruption resistance heat") / disruptionResistance;
+		double disruptionResistance = attributes.Get(Attribute::DISRUPTION_RESISTANCE);
+		double disruptionEnergy = attributes.Get(Attribute::DISRUPTION_RESISTANCE_ENERGY) / disruptionResistance;
+		double disruptionFuel = attributes.Get(Attribute::DISRUPTION_RESISTANCE_FUEL) / disruptionResistance;
+		double disruptionHeat = attributes.Get(Attribute::DISRUPTION_RESISTANCE_HEAT) / disruptionResistance;
 		DoStatusEffect(isDisabled, disruption, disruptionResistance, energy, disruptionEnergy, fuel, disruptionFuel, heat, disruptionHeat);
 	}
 	
 	if(slowness)
 	{
-		double slowingResistance = attributes.Get("slowing resistance");
-		double slowingEnergy = attributes.Get("slowing resistance energy") / slowingResistance;
-		double slowingFuel = attributes.Get("slowing resistance fuel") / slowingResistance;
-		double slowingHeat = attributes.Get("slowing resistance heat") / slowingResistance;
+		double slowingResistance = attributes.Get(Attribute::SLOWING_RESISTANCE);
+		double slowingEnergy = attributes.Get(Attribute::SLOWING_RESISTANCE_ENERGY) / slowingResistance;
+		double slowingFuel = attributes.Get(Attribute::SLOWING_RESISTANCE_FUEL) / slowingResistance;
+		double slowingHeat = attributes.Get(Attribute::SLOWING_RESISTANCE_HEAT) / slowingResistance;
 		DoStatusEffect(isDisabled, slowness, slowingResistance, energy, slowingEnergy, fuel, slowingFuel, heat, slowingHeat);
 	}
 	
 	if(discharge)
 	{
-		double dischargeResistance = attributes.Get("discharge resistance");
-		double dischargeEnergy = attributes.Get("discharge resistance energy") / dischargeResistance;
-		double dischargeFuel = attributes.Get("discharge resistance fuel") / dischargeResistance;
-		double dischargeHeat = attributes.Get("discharge resistance heat") / dischargeResistance;
+		double dischargeResistance = attributes.Get(Attribute::DISCHARGE_RESISTANCE);
+		double dischargeEnergy = attributes.Get(Attribute::DISCHARGE_RESISTANCE_ENERGY) / dischargeResistance;
+		double dischargeFuel = attributes.Get(Attribute::DISCHARGE_RESISTANCE_FUEL) / dischargeResistance;
+		double dischargeHeat = attributes.Get(Attribute::DISCHARGE_RESISTANCE_HEAT) / dischargeResistance;
 		DoStatusEffect(isDisabled, discharge, dischargeResistance, energy, dischargeEnergy, fuel, dischargeFuel, heat, dischargeHeat);
 	}
 	
 	if(corrosion)
 	{
-		double corrosionResistance = attributes.Get("corrosion resistance");
-		double corrosionEnergy = attributes.Get("corrosion resistance energy") / corrosionResistance;
-		double corrosionFuel = attributes.Get("corrosion resistance fuel") / corrosionResistance;
-		double corrosionHeat = attributes.Get("corrosion resistance heat") / corrosionResistance;
+		double corrosionResistance = attributes.Get(Attribute::CORROSION_RESISTANCE);
+		double corrosionEnergy = attributes.Get(Attribute::CORROSION_RESISTANCE_ENERGY) / corrosionResistance;
+		double corrosionFuel = attributes.Get(Attribute::CORROSION_RESISTANCE_FUEL) / corrosionResistance;
+		double corrosionHeat = attributes.Get(Attribute::CORROSION_RESISTANCE_HEAT) / corrosionResistance;
 		DoStatusEffect(isDisabled, corrosion, corrosionResistance, energy, corrosionEnergy, fuel, corrosionFuel, heat, corrosionHeat);
 	}
 	
 	if(leakage)
 	{
-		double leakResistance = attributes.Get("leak resistance");
-		double leakEnergy = attributes.Get("leak resistance energy") / leakResistance;
-		double leakFuel = attributes.Get("leak resistance fuel") / leakResistance;
-		double leakHeat = attributes.Get("leak resistance heat") / leakResistance;
+		double leakResistance = attributes.Get(Attribute::LEAK_RESISTANCE);
+		double leakEnergy = attributes.Get(Attribute::LEAK_RESISTANCE_ENERGY) / leakResistance;
+		double leakFuel = attributes.Get(Attribute::LEAK_RESISTANCE_FUEL) / leakResistance;
+		double leakHeat = attributes.Get(Attribute::LEAK_RESISTANCE_HEAT) / leakResistance;
 		DoStatusEffect(isDisabled, leakage, leakResistance, energy, leakEnergy, fuel, leakFuel, heat, leakHeat);
 	}
 	
 	if(burning)
 	{
-		double burnResistance = attributes.Get("burn resistance");
-		double burnEnergy = attributes.Get("burn resistance energy") / burnResistance;
-		double burnFuel = attributes.Get("burn resistance fuel") / burnResistance;
-		double burnHeat = attributes.Get("burn resistance heat") / burnResistance;
+		double burnResistance = attributes.Get(Attribute::BURN_RESISTANCE);
+		double burnEnergy = attributes.Get(Attribute::BURN_RESISTANCE_ENERGY) / burnResistance;
+		double burnFuel = attributes.Get(Attribute::BURN_RESISTANCE_FUEL) / burnResistance;
+		double burnHeat = attributes.Get(Attribute::BURN_RESISTANCE_HEAT) / burnResistance;
 		DoStatusEffect(isDisabled, burning, burnResistance, energy, burnEnergy, fuel, burnFuel, heat, burnHeat);
 	}
 	
@@ -2098,8 +2098,8 @@ void Ship::DoGeneration()
 	// maximum capacity for the rest of the turn, but must be clamped to the
 	// maximum here before they gain more. This is so that, for example, a ship
 	// with no batteries but a good generator can still move.
-	energy = min(energy, attributes.Get("energy capacity"));
-	fuel = min(fuel, attributes.Get("fuel capacity"));
+	energy = min(energy, attributes.Get(Attribute::ENERGY_CAPACITY));
+	fuel = min(fuel, attributes.Get(Attribute::FUEL_CAPACITY));
 	
 	heat -= heat * HeatDissipation();
 	if(heat > MaximumHeat())
@@ -2107,9 +2107,9 @@ void Ship::DoGeneration()
 	else if(heat < .9 * MaximumHeat())
 		isOverheated = false;
 	
-	double maxShields = attributes.Get("shields");
+	double maxShields = attributes.Get(Attribute::SHIELDS);
 	shields = min(shields, maxShields);
-	double maxHull = attributes.Get("hull");
+	double maxHull = attributes.Get(Attribute::HULL);
 	hull = min(hull, maxHull);
 	
 	isDisabled = isOverheated || hull < MinimumHull() || (!crew && RequiredCrew());
@@ -2134,35 +2134,35 @@ void Ship::DoGeneration()
 		if(currentSystem)
 		{
 			double scale = .2 + 1.8 / (.001 * position.Length() + 1);
-			fuel += currentSystem->SolarWind() * .03 * scale * (sqrt(attributes.Get("ramscoop")) + .05 * scale);
+			fuel += currentSystem->SolarWind() * .03 * scale * (sqrt(attributes.Get(Attribute::RAMSCOOP)) + .05 * scale);
 			
 			double solarScaling = currentSystem->SolarPower() * scale;
-			energy += solarScaling * attributes.Get("solar collection");
-			heat += solarScaling * attributes.Get("solar heat");
+			energy += solarScaling * attributes.Get(Attribute::SOLAR_COLLECTION);
+			heat += solarScaling * attributes.Get(Attribute::SOLAR_HEAT);
 		}
 		
 		double coolingEfficiency = CoolingEfficiency();
-		energy += attributes.Get("energy generation") - attributes.Get("energy consumption");
-		fuel += attributes.Get("fuel generation");
-		heat += attributes.Get("heat generation");
-		heat -= coolingEfficiency * attributes.Get("cooling");
+		energy += attributes.Get(Attribute::ENERGY_GENERATION) - attributes.Get(Attribute::ENERGY_CONSUMPTION);
+		fuel += attributes.Get(Attribute::FUEL_GENERATION);
+		heat += attributes.Get(Attribute::HEAT_GENERATION);
+		heat -= coolingEfficiency * attributes.Get(Attribute::COOLING);
 		
 		// Convert fuel into energy and heat only when the required amount of fuel is available.
-		if(attributes.Get("fuel consumption") <= fuel)
+		if(attributes.Get(Attribute::FUEL_CONSUMPTION) <= fuel)
 		{	
-			fuel -= attributes.Get("fuel consumption");
-			energy += attributes.Get("fuel energy");
-			heat += attributes.Get("fuel heat");
+			fuel -= attributes.Get(Attribute::FUEL_CONSUMPTION);
+			energy += attributes.Get(Attribute::FUEL_ENERGY);
+			heat += attributes.Get(Attribute::FUEL_HEAT);
 		}
 		
 		// Apply active cooling. The fraction of full cooling to apply equals
 		// your ship's current fraction of its maximum temperature.
-		double activeCooling = coolingEfficiency * attributes.Get("active cooling");
+		double activeCooling = coolingEfficiency * attributes.Get(Attribute::ACTIVE_COOLING);
 		if(activeCooling > 0. && heat > 0. && energy >= 0.)
 		{
 			// Although it's a misuse of this feature, handle the case where
 			// "active cooling" does not require any energy.
-			double coolingEnergy = attributes.Get("cooling energy");
+			double coolingEnergy = attributes.Get(Attribute::COOLING_ENERGY);
 			if(coolingEnergy)
 			{
 				double spentEnergy = min(energy, coolingEnergy * min(1., Heat()));
@@ -2193,7 +2193,7 @@ void Ship::Launch(list<shared_ptr<Ship>> &ships, vector<Visual> &visuals)
 		return;
 	
 	for(Bay &bay : bays)
-		if(bay.ship && ((bay.ship->Commands().Has(Command::DEPLOY) && !Random::Int(40 + 20 * !bay.ship->attributes.Get("automaton")))
+		if(bay.ship && ((bay.ship->Commands().Has(Command::DEPLOY) && !Random::Int(40 + 20 * !bay.ship->attributes.Get(Attribute::AUTOMATON)))
 				|| (ejecting && !Random::Int(6))))
 		{
 			// Resupply any ships launching of their own accord.
@@ -2203,7 +2203,7 @@ void Ship::Launch(list<shared_ptr<Ship>> &ships, vector<Visual> &visuals)
 				
 				// This ship will refuel naturally based on the carrier's fuel
 				// collection, but the carrier may have some reserves to spare.
-				double maxFuel = bay.ship->attributes.Get("fuel capacity");
+				double maxFuel = bay.ship->attributes.Get(Attribute::FUEL_CAPACITY);
 				if(maxFuel)
 				{
 					double spareFuel = fuel - JumpFuel();
@@ -2269,7 +2269,7 @@ shared_ptr<Ship> Ship::Board(bool autoPlunder)
 		SetShipToAssist(shared_ptr<Ship>());
 		SetTargetShip(shared_ptr<Ship>());
 		bool helped = victim->isDisabled;
-		victim->hull = min(max(victim->hull, victim->MinimumHull() * 1.5), victim->attributes.Get("hull"));
+		victim->hull = min(max(victim->hull, victim->MinimumHull() * 1.5), victim->attributes.Get(Attribute::HULL));
 		victim->isDisabled = false;
 		// Transfer some fuel if needed.
 		if(!victim->JumpsRemaining() && CanRefuel(*victim))
@@ -2319,8 +2319,8 @@ int Ship::Scan()
 		return 0;
 	
 	// The range of a scanner is proportional to the square root of its power.
-	double cargoDistance = 100. * sqrt(attributes.Get("cargo scan power"));
-	double outfitDistance = 100. * sqrt(attributes.Get("outfit scan power"));
+	double cargoDistance = 100. * sqrt(attributes.Get(Attribute::CARGO_SCAN_POWER));
+	double outfitDistance = 100. * sqrt(attributes.Get(Attribute::OUTFIT_SCAN_POWER));
 	
 	// Bail out if this ship has no scanners.
 	if(!cargoDistance && !outfitDistance)
@@ -2593,8 +2593,8 @@ bool Ship::IsReadyToJump(bool waitingIsReady) const
 		return false;
 	
 	Point direction = targetSystem->Position() - currentSystem->Position();
-	bool isJump = !attributes.Get("hyperdrive") || !currentSystem->Links().count(targetSystem);
-	double scramThreshold = attributes.Get("scram drive");
+	bool isJump = !attributes.Get(Attribute::HYPERDRIVE) || !currentSystem->Links().count(targetSystem);
+	double scramThreshold = attributes.Get(Attribute::SCRAM_DRIVE);
 	
 	// The ship can only enter hyperspace if it is traveling slowly enough
 	// and pointed in the right direction.
@@ -2604,7 +2604,7 @@ bool Ship::IsReadyToJump(bool waitingIsReady) const
 		if(deviation > scramThreshold)
 			return false;
 	}
-	else if(velocity.Length() > attributes.Get("jump speed"))
+	else if(velocity.Length() > attributes.Get(Attribute::JUMP_SPEED))
 		return false;
 	
 	if(!isJump)
@@ -2736,18 +2736,18 @@ void Ship::Recharge(bool atSpaceport)
 	
 	if(atSpaceport)
 	{
-		crew = min<int>(max(crew, RequiredCrew()), attributes.Get("bunks"));
-		fuel = attributes.Get("fuel capacity");
+		crew = min<int>(max(crew, RequiredCrew()), attributes.Get(Attribute::BUNKS));
+		fuel = attributes.Get(Attribute::FUEL_CAPACITY);
 	}
 	pilotError = 0;
 	pilotOkay = 0;
 	
-	if(atSpaceport || attributes.Get("shield generation"))
-		shields = attributes.Get("shields");
-	if(atSpaceport || attributes.Get("hull repair rate"))
-		hull = attributes.Get("hull");
-	if(atSpaceport || attributes.Get("energy generation"))
-		energy = attributes.Get("energy capacity");
+	if(atSpaceport || attributes.Get(Attribute::SHIELD_GENERATION))
+		shields = attributes.Get(Attribute::SHIELDS);
+	if(atSpaceport || attributes.Get(Attribute::HULL_REPAIR_RATE))
+		hull = attributes.Get(Attribute::HULL);
+	if(atSpaceport || attributes.Get(Attribute::ENERGY_GENERATION))
+		energy = attributes.Get(Attribute::ENERGY_CAPACITY);
 	
 	heat = IdleHeat();
 	ionization = 0.;
@@ -2772,10 +2772,10 @@ bool Ship::CanRefuel(const Ship &other) const
 
 double Ship::TransferFuel(double amount, Ship *to)
 {
-	amount = max(fuel - attributes.Get("fuel capacity"), amount);
+	amount = max(fuel - attributes.Get(Attribute::FUEL_CAPACITY), amount);
 	if(to)
 	{
-		amount = min(to->attributes.Get("fuel capacity") - to->fuel, amount);
+		amount = min(to->attributes.Get(Attribute::FUEL_CAPACITY) - to->fuel, amount);
 		to->fuel += amount;
 	}
 	fuel -= amount;
@@ -2789,7 +2789,7 @@ double Ship::TransferFuel(double amount, Ship *to)
 void Ship::WasCaptured(const shared_ptr<Ship> &capturer)
 {
 	// Repair up to the point where this ship is just barely not disabled.
-	hull = min(max(hull, MinimumHull() * 1.5), attributes.Get("hull"));
+	hull = min(max(hull, MinimumHull() * 1.5), attributes.Get(Attribute::HULL));
 	isDisabled = false;
 	
 	// Set the new government.
@@ -2846,7 +2846,7 @@ void Ship::WasCaptured(const shared_ptr<Ship> &capturer)
 // Get characteristics of this ship, as a fraction between 0 and 1.
 double Ship::Shields() const
 {
-	double maximum = attributes.Get("shields");
+	double maximum = attributes.Get(Attribute::SHIELDS);
 	return maximum ? min(1., shields / maximum) : 0.;
 }
 
@@ -2854,7 +2854,7 @@ double Ship::Shields() const
 
 double Ship::Hull() const
 {
-	double maximum = attributes.Get("hull");
+	double maximum = attributes.Get(Attribute::HULL);
 	return maximum ? min(1., hull / maximum) : 1.;
 }
 
@@ -2862,7 +2862,7 @@ double Ship::Hull() const
 
 double Ship::Fuel() const
 {
-	double maximum = attributes.Get("fuel capacity");
+	double maximum = attributes.Get(Attribute::FUEL_CAPACITY);
 	return maximum ? min(1., fuel / maximum) : 0.;
 }
 
@@ -2870,7 +2870,7 @@ double Ship::Fuel() const
 
 double Ship::Energy() const
 {
-	double maximum = attributes.Get("energy capacity");
+	double maximum = attributes.Get(Attribute::ENERGY_CAPACITY);
 	return maximum ? min(1., energy / maximum) : (hull > 0.) ? 1. : 0.;
 }
 
@@ -2890,8 +2890,8 @@ double Ship::Heat() const
 double Ship::Health() const
 {
 	double minimumHull = MinimumHull();
-	double hullDivisor = attributes.Get("hull") - minimumHull;
-	double divisor = attributes.Get("shields") + hullDivisor;
+	double hullDivisor = attributes.Get(Attribute::HULL) - minimumHull;
+	double divisor = attributes.Get(Attribute::SHIELDS) + hullDivisor;
 	// This should not happen, but just in case.
 	if(divisor <= 0. || hullDivisor <= 0.)
 		return 0.;
@@ -2906,7 +2906,7 @@ double Ship::Health() const
 // Get the hull fraction at which this ship is disabled.
 double Ship::DisabledHull() const
 {
-	double hull = attributes.Get("hull");
+	double hull = attributes.Get(Attribute::HULL);
 	double minimumHull = MinimumHull();
 	
 	return (hull > 0. ? minimumHull / hull : 0.);
@@ -2946,10 +2946,10 @@ double Ship::JumpFuel(const System *destination) const
 	
 	bool linked = currentSystem->Links().count(destination);
 	// Figure out what sort of jump we're making.
-	if(attributes.Get("hyperdrive") && linked)
+	if(attributes.Get(Attribute::HYPERDRIVE) && linked)
 		return HyperdriveFuel();
 	
-	if(attributes.Get("jump drive") && currentSystem->JumpNeighbors(JumpRange()).count(destination))
+	if(attributes.Get(Attribute::JUMP_DRIVE) && currentSystem->JumpNeighbors(JumpRange()).count(destination))
 		return JumpDriveFuel((linked || currentSystem->JumpRange()) ? 0. : currentSystem->Position().Distance(destination->Position()));
 	
 	// If the given system is not a possible destination, return 0.
@@ -2964,15 +2964,15 @@ double Ship::JumpRange(bool getCached) const
 		return jumpRange;
 	
 	// Ships without a jump drive have no jump range.
-	if(!attributes.Get("jump drive"))
+	if(!attributes.Get(Attribute::JUMP_DRIVE))
 		return 0.;
 	
 	// Find the outfit that provides the farthest jump range.
 	double best = 0.;
 	// Make it possible for the jump range to be integrated into a ship.
-	if(baseAttributes.Get("jump drive"))
+	if(baseAttributes.Get(Attribute::JUMP_DRIVE))
 	{
-		best = baseAttributes.Get("jump range");
+		best = baseAttributes.Get(Attribute::JUMP_RANGE);
 		if(!best)
 			best = System::DEFAULT_NEIGHBOR_DISTANCE;
 	}
@@ -2995,10 +2995,10 @@ double Ship::JumpRange(bool getCached) const
 double Ship::HyperdriveFuel() const
 {
 	// Don't bother searching through the outfits if there is no hyperdrive.
-	if(!attributes.Get("hyperdrive"))
+	if(!attributes.Get(Attribute::HYPERDRIVE))
 		return JumpDriveFuel();
 	
-	if(attributes.Get("scram drive"))
+	if(attributes.Get(Attribute::SCRAM_DRIVE))
 		return BestFuel("hyperdrive", "scram drive", 150.);
 	
 	return BestFuel("hyperdrive", "", 100.);
@@ -3009,7 +3009,7 @@ double Ship::HyperdriveFuel() const
 double Ship::JumpDriveFuel(double jumpDistance) const
 {
 	// Don't bother searching through the outfits if there is no jump drive.
-	if(!attributes.Get("jump drive"))
+	if(!attributes.Get(Attribute::JUMP_DRIVE))
 		return 0.;
 	
 	return BestFuel("jump drive", "", 200., jumpDistance);
@@ -3022,7 +3022,7 @@ double Ship::JumpFuelMissing() const
 	// Used for smart refueling: transfer only as much as really needed
 	// includes checking if fuel cap is high enough at all
 	double jumpFuel = JumpFuel(targetSystem);
-	if(!jumpFuel || fuel > jumpFuel || jumpFuel > attributes.Get("fuel capacity"))
+	if(!jumpFuel || fuel > jumpFuel || jumpFuel > attributes.Get(Attribute::FUEL_CAPACITY))
 		return 0.;
 	
 	return jumpFuel - fuel;
@@ -3035,14 +3035,14 @@ double Ship::IdleHeat() const
 {
 	// This ship's cooling ability:
 	double coolingEfficiency = CoolingEfficiency();
-	double cooling = coolingEfficiency * attributes.Get("cooling");
-	double activeCooling = coolingEfficiency * attributes.Get("active cooling");
+	double cooling = coolingEfficiency * attributes.Get(Attribute::COOLING);
+	double activeCooling = coolingEfficiency * attributes.Get(Attribute::ACTIVE_COOLING);
 	
 	// Idle heat is the heat level where:
 	// heat = heat * diss + heatGen - cool - activeCool * heat / (100 * mass)
 	// heat = heat * (diss - activeCool / (100 * mass)) + (heatGen - cool)
 	// heat * (1 - diss + activeCool / (100 * mass)) = (heatGen - cool)
-	double production = max(0., attributes.Get("heat generation") - cooling);
+	double production = max(0., attributes.Get(Attribute::HEAT_GENERATION) - cooling);
 	double dissipation = HeatDissipation() + activeCooling / MaximumHeat();
 	if(!dissipation) return production ? numeric_limits<double>::max() : 0;
 	return production / dissipation;
@@ -3053,7 +3053,7 @@ double Ship::IdleHeat() const
 // Get the heat dissipation, in heat units per heat unit per frame.
 double Ship::HeatDissipation() const
 {
-	return .001 * attributes.Get("heat dissipation");
+	return .001 * attributes.Get(Attribute::HEAT_DISSIPATION);
 }
 
 
@@ -3072,7 +3072,7 @@ double Ship::CoolingEfficiency() const
 	// This is an S-curve where the efficiency is 100% if you have no outfits
 	// that create "cooling inefficiency", and as that value increases the
 	// efficiency stays high for a while, then drops off, then approaches 0.
-	double x = attributes.Get("cooling inefficiency");
+	double x = attributes.Get(Attribute::COOLING_INEFFICIENCY);
 	return 2. + 2. / (1. + exp(x / -2.)) - 4. / (1. + exp(x / -4.));
 }
 
@@ -3087,18 +3087,18 @@ int Ship::Crew() const
 
 int Ship::RequiredCrew() const
 {
-	if(attributes.Get("automaton"))
+	if(attributes.Get(Attribute::AUTOMATON))
 		return 0;
 	
 	// Drones do not need crew, but all other ships need at least one.
-	return max<int>(1, attributes.Get("required crew"));
+	return max<int>(1, attributes.Get(Attribute::REQUIRED_CREW));
 }
 
 
 
 void Ship::AddCrew(int count)
 {
-	crew = min<int>(crew + count, attributes.Get("bunks"));
+	crew = min<int>(crew + count, attributes.Get(Attribute::BUNKS));
 }
 
 
@@ -3120,15 +3120,15 @@ double Ship::Mass() const
 
 double Ship::TurnRate() const
 {
-	return attributes.Get("turn") / Mass();
+	return attributes.Get(Attribute::TURN) / Mass();
 }
 
 
 
 double Ship::Acceleration() const
 {
-	double thrust = attributes.Get("thrust");
-	return (thrust ? thrust : attributes.Get("afterburner thrust")) / Mass();
+	double thrust = attributes.Get(Attribute::THRUST);
+	return (thrust ? thrust : attributes.Get(Attribute::AFTERBURNER_THRUST)) / Mass();
 }
 
 
@@ -3138,15 +3138,15 @@ double Ship::MaxVelocity() const
 	// v * drag / mass == thrust / mass
 	// v * drag == thrust
 	// v = thrust / drag
-	double thrust = attributes.Get("thrust");
-	return (thrust ? thrust : attributes.Get("afterburner thrust")) / attributes.Get("drag");
+	double thrust = attributes.Get(Attribute::THRUST);
+	return (thrust ? thrust : attributes.Get(Attribute::AFTERBURNER_THRUST)) / attributes.Get(Attribute::DRAG);
 }
 
 
 
 double Ship::MaxReverseVelocity() const
 {
-	return attributes.Get("reverse thrust") / attributes.Get("drag");
+	return attributes.Get(Attribute::REVERSE_THRUST) / attributes.Get(Attribute::DRAG);
 }
 
 
@@ -3176,13 +3176,13 @@ int Ship::TakeDamage(vector<Visual> &visuals, const Weapon &weapon, double damag
 		damageScaling *= weapon.DamageDropoff(distanceTraveled);
 	
 	// Instantaneous damage types:
-	double shieldDamage = (weapon.ShieldDamage() + weapon.RelativeShieldDamage() * attributes.Get("shields"))
+	double shieldDamage = (weapon.ShieldDamage() + weapon.RelativeShieldDamage() * attributes.Get(Attribute::SHIELDS))
 		* damageScaling / (1. + attributes.Get("shield protection"));
-	double hullDamage = (weapon.HullDamage() + weapon.RelativeHullDamage() * attributes.Get("hull"))
+	double hullDamage = (weapon.HullDamage() + weapon.RelativeHullDamage() * attributes.Get(Attribute::HULL))
 		* damageScaling / (1. + attributes.Get("hull protection"));
-	double energyDamage = (weapon.EnergyDamage() + weapon.RelativeEnergyDamage() * attributes.Get("energy capacity"))
+	double energyDamage = (weapon.EnergyDamage() + weapon.RelativeEnergyDamage() * attributes.Get(Attribute::ENERGY_CAPACITY))
 		* damageScaling / (1. + attributes.Get("energy protection"));
-	double fuelDamage = (weapon.FuelDamage() + weapon.RelativeFuelDamage() * attributes.Get("fuel capacity"))
+	double fuelDamage = (weapon.FuelDamage() + weapon.RelativeFuelDamage() * attributes.Get(Attribute::FUEL_CAPACITY))
 		* damageScaling / (1. + attributes.Get("fuel protection"));
 	double heatDamage = (weapon.HeatDamage() + weapon.RelativeHeatDamage() * MaximumHeat())
 		* damageScaling / (1. + attributes.Get("heat protection"));
@@ -3250,8 +3250,8 @@ int Ship::TakeDamage(vector<Visual> &visuals, const Weapon &weapon, double damag
 	}
 	
 	// Prevent various stats from reaching unallowable values.
-	hull = min(hull, attributes.Get("hull"));
-	shields = min(shields, attributes.Get("shields"));
+	hull = min(hull, attributes.Get(Attribute::HULL));
+	shields = min(shields, attributes.Get(Attribute::SHIELDS));
 	// Weapons are allowed to overcharge a ship's energy or fuel, but code in Ship::DoGeneration()
 	// will clamp it to a maximum value at the beginning of the next frame.
 	energy = max(0., energy);
@@ -3614,13 +3614,13 @@ bool Ship::CanFire(const Weapon *weapon) const
 			return false;
 	}
 	
-	if(energy < weapon->FiringEnergy() + weapon->RelativeFiringEnergy() * attributes.Get("energy capacity"))
+	if(energy < weapon->FiringEnergy() + weapon->RelativeFiringEnergy() * attributes.Get(Attribute::ENERGY_CAPACITY))
 		return false;
-	if(fuel < weapon->FiringFuel() + weapon->RelativeFiringFuel() * attributes.Get("fuel capacity"))
+	if(fuel < weapon->FiringFuel() + weapon->RelativeFiringFuel() * attributes.Get(Attribute::FUEL_CAPACITY))
 		return false;
 	// We do check hull, but we don't check shields. Ships can survive with all shields depleted.
 	// Ships should not disable themselves, so we check if we stay above minimumHull.
-	if(hull - MinimumHull() < weapon->FiringHull() + weapon->RelativeFiringHull() * attributes.Get("hull"))
+	if(hull - MinimumHull() < weapon->FiringHull() + weapon->RelativeFiringHull() * attributes.Get(Attribute::HULL))
 		return false;
 
 	// If a weapon requires heat to fire, (rather than generating heat), we must
@@ -3648,11 +3648,11 @@ void Ship::ExpendAmmo(const Weapon &weapon)
 {
 	// Compute this ship's initial capacities, in case the consumption of the ammunition outfit(s)
 	// modifies them, so that relative costs are calculated based on the pre-firing state of the ship.
-	const double relativeEnergyChange = weapon.RelativeFiringEnergy() * attributes.Get("energy capacity");
-	const double relativeFuelChange = weapon.RelativeFiringFuel() * attributes.Get("fuel capacity");
+	const double relativeEnergyChange = weapon.RelativeFiringEnergy() * attributes.Get(Attribute::ENERGY_CAPACITY);
+	const double relativeFuelChange = weapon.RelativeFiringFuel() * attributes.Get(Attribute::FUEL_CAPACITY);
 	const double relativeHeatChange = !weapon.RelativeFiringHeat() ? 0. : weapon.RelativeFiringHeat() * MaximumHeat();
-	const double relativeHullChange = weapon.RelativeFiringHull() * attributes.Get("hull");
-	const double relativeShieldChange = weapon.RelativeFiringShields() * attributes.Get("shields");
+	const double relativeHullChange = weapon.RelativeFiringHull() * attributes.Get(Attribute::HULL);
+	const double relativeShieldChange = weapon.RelativeFiringShields() * attributes.Get(Attribute::SHIELDS);
 	
 	if(const Outfit *ammo = weapon.Ammo())
 	{
@@ -3831,7 +3831,7 @@ double Ship::MinimumHull() const
 	if(neverDisabled)
 		return 0.;
 	
-	double maximumHull = attributes.Get("hull");
+	double maximumHull = attributes.Get(Attribute::HULL);
 	double absoluteThreshold = attributes.Get("absolute threshold");
 	if(absoluteThreshold > 0.)
 		return absoluteThreshold;
@@ -3858,7 +3858,7 @@ double Ship::BestFuel(const string &type, const string &subtype, double defaultF
 		// the given jump. We can guarantee that at least one jump drive
 		// is capable of making the given jump, as the destination must
 		// be among the neighbors of the current system.
-		double jumpRange = baseAttributes.Get("jump range");
+		double jumpRange = baseAttributes.Get(Attribute::JUMP_RANGE);
 		if(!jumpRange)
 			jumpRange = System::DEFAULT_NEIGHBOR_DISTANCE;
 		// If no distance was given then we're either using a hyperdrive
@@ -377,7 +377,9 @@ void ShipEditor::RenderShip()
 				if(ImGui::InputDoubleEx(it.first, &value))
 				{
 					object->attributes.attributes[it.first] += value - it.second;
+					object->attributes.UpdateHotAttributes();
 					it.second = value;
+					object->baseAttributes.UpdateHotAttributes();
 					SetDirty();
 				}
 			}
@@ -0,0 +1,98 @@
+/* ShipGrid.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "ShipGrid.h"
+
+#include "Point.h"
+#include "Ship.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+	// The size of the grid cells. If more cells than this have been used,
+	// start over.
+	const double CELL_SIZE = 2048.;
+	const size_t MAX_CELLS = 4096;
+
+	// Get the coordinate of the grid cell that contains the given position.
+	int64_t Cell(double position)
+	{
+		return static_cast<int64_t>(floor(position / CELL_SIZE));
+	}
+
+	// Get the key of the grid cell with the given coordinates. Cells that are
+	// 2^32 cells apart share a key, so a cell may hold ships that are far from
+	// each other.
+	uint64_t Key(int64_t x, int64_t y)
+	{
+		return (static_cast<uint64_t>(x) << 32) ^ static_cast<uint32_t>(y);
+	}
+}
+
+
+
+// Remove all the ships from the grid.
+void ShipGrid::Clear()
+{
+	if(cells.size() > MAX_CELLS)
+		cells.clear();
+	for(auto &cell : cells)
+		cell.second.clear();
+	count = 0;
+}
+
+
+
+// Add the given ship, from the roster with the given index.
+void ShipGrid::Add(const shared_ptr<Ship> &ship, size_t roster)
+{
+	const Point &position = ship->Position();
+	cells[Key(Cell(position.X()), Cell(position.Y()))].push_back({&ship, roster, count++});
+}
+
+
+
+// Check if finding the ships within the given range of a point would look at
+// fewer cells than the grid has.
+bool ShipGrid::IsWorthSearching(double range) const
+{
+	const double span = 2. * range / CELL_SIZE + 2.;
+	return span * span <= cells.size();
+}
+
+
+
+// Get the ships in every cell that is within the given range of the given point.
+vector<const ShipGrid::Entry *> ShipGrid::Find(const Point &center, double range) const
+{
+	vector<const Entry *> result;
+	const int64_t minX = Cell(center.X() - range);
+	const int64_t maxX = Cell(center.X() + range);
+	const int64_t minY = Cell(center.Y() - range);
+	const int64_t maxY = Cell(center.Y() + range);
+	for(int64_t y = minY; y <= maxY; ++y)
+		for(int64_t x = minX; x <= maxX; ++x)
+		{
+			auto cell = cells.find(Key(x, y));
+			if(cell != cells.end())
+				for(const Entry &entry : cell->second)
+					result.push_back(&entry);
+		}
+
+	// Return the ships in the order they were added, which is the order that
+	// checking every roster would find them in.
+	sort(result.begin(), result.end(), [](const Entry *a, const Entry *b) { return a->order < b->order; });
+	return result;
+}
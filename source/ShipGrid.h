@@ -0,0 +1,66 @@
+/* ShipGrid.h
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef SHIP_GRID_H_
+#define SHIP_GRID_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class Point;
+class Ship;
+
+
+
+// The ships in the AI's government rosters, sorted into a grid of cells by
+// position, so that the ships near a given point can be found without checking
+// every ship in the system. The cells are kept from one step to the next, so
+// that sorting the ships into them does not need to allocate any memory.
+class ShipGrid {
+public:
+	// A ship in one of the rosters, the index of that roster, and the position
+	// of the ship in all the rosters, one after another.
+	class Entry {
+	public:
+		const std::shared_ptr<Ship> *ship;
+		size_t roster;
+		size_t order;
+	};
+
+
+public:
+	// Remove all the ships from the grid.
+	void Clear();
+	// Add the given ship, from the roster with the given index. The ships must
+	// be added in roster order, and must not move until the grid is cleared.
+	void Add(const std::shared_ptr<Ship> &ship, size_t roster);
+
+	// Check if finding the ships within the given range of a point would look
+	// at fewer cells than the grid has, i.e. whether that is faster than just
+	// checking every ship.
+	bool IsWorthSearching(double range) const;
+	// Get the ships in every cell that is within the given range of the given
+	// point, in the order they were added. Some of them may be farther away.
+	std::vector<const Entry *> Find(const Point &center, double range) const;
+
+
+private:
+	std::unordered_map<uint64_t, std::vector<Entry>> cells;
+	size_t count = 0;
+};
+
+
+
+#endif
@@ -0,0 +1,115 @@
+/* SpriteBudget.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "SpriteBudget.h"
+
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+
+
+
+SpriteBudget::SpriteBudget(size_t limit)
+	: limit(limit)
+{
+}
+
+
+
+// Set the number of bytes that the sprites may use in total.
+void SpriteBudget::SetLimit(size_t limit)
+{
+	this->limit = limit;
+}
+
+
+
+// Note that the given sprite is about to be used.
+bool SpriteBudget::Use(const Sprite *sprite, bool isNearby)
+{
+	auto it = entries.find(sprite);
+	const bool isNew = (it == entries.end());
+	if(isNew)
+		it = entries.emplace(sprite, Entry()).first;
+
+	// A sprite that is needed for its own sake stays that way, even if it is
+	// also needed because it is nearby.
+	it->second.lastUse = ++uses;
+	it->second.isNearby = isNearby && (isNew || it->second.isNearby);
+	return isNew;
+}
+
+
+
+// Set the number of bytes the given sprite uses, once that is known.
+void SpriteBudget::SetMemory(const Sprite *sprite, size_t memory)
+{
+	auto it = entries.find(sprite);
+	if(it != entries.end())
+		it->second.memory = memory;
+}
+
+
+
+// Get the sprites that must be unloaded to fit within the budget.
+vector<const Sprite *> SpriteBudget::Unload()
+{
+	vector<const Sprite *> result;
+	size_t memory = Memory();
+	if(memory <= limit)
+		return result;
+
+	// Sort the sprites in the order they should be unloaded in.
+	vector<pair<const Sprite *, Entry>> order(entries.begin(), entries.end());
+	sort(order.begin(), order.end(), [](const pair<const Sprite *, Entry> &a, const pair<const Sprite *, Entry> &b)
+	{
+		return make_tuple(!a.second.isNearby, a.second.lastUse) < make_tuple(!b.second.isNearby, b.second.lastUse);
+	});
+
+	for(const auto &it : order)
+	{
+		if(memory <= limit)
+			break;
+		// Sprites that are not loaded yet do not free up any memory. The most
+		// recently used sprite may be sorted anywhere, since it may be nearby.
+		if(!it.second.memory || it.second.lastUse == uses)
+			continue;
+
+		memory -= it.second.memory;
+		entries.erase(it.first);
+		result.push_back(it.first);
+	}
+	return result;
+}
+
+
+
+// Get the sprites that are currently loaded.
+vector<const Sprite *> SpriteBudget::Sprites() const
+{
+	vector<const Sprite *> result;
+	for(const auto &it : entries)
+		result.push_back(it.first);
+	return result;
+}
+
+
+
+// Get the number of bytes the loaded sprites use.
+size_t SpriteBudget::Memory() const
+{
+	size_t memory = 0;
+	for(const auto &it : entries)
+		memory += it.second.memory;
+	return memory;
+}
@@ -0,0 +1,69 @@
+/* SpriteBudget.h
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef SPRITE_BUDGET_H_
+#define SPRITE_BUDGET_H_
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+class Sprite;
+
+
+
+// Class that keeps track of the sprites that are only loaded when they are
+// needed, and decides which of them to unload so that the memory they use stays
+// within a budget. Sprites that are only needed because they are nearby (e.g.
+// the landscapes of neighboring systems) are unloaded first, and then the ones
+// that have gone unused for the longest time.
+class SpriteBudget {
+public:
+	explicit SpriteBudget(size_t limit = 0);
+
+	// Set the number of bytes that the sprites may use in total.
+	void SetLimit(size_t limit);
+
+	// Note that the given sprite is about to be used. Returns true if it is
+	// not loaded already, in which case the caller must load it.
+	bool Use(const Sprite *sprite, bool isNearby = false);
+	// Set the number of bytes the given sprite uses, once that is known.
+	void SetMemory(const Sprite *sprite, size_t memory);
+
+	// Get the sprites that must be unloaded to fit within the budget, and stop
+	// keeping track of them. The most recently used sprite is never unloaded.
+	std::vector<const Sprite *> Unload();
+
+	// Get the sprites that are currently loaded.
+	std::vector<const Sprite *> Sprites() const;
+	// Get the number of bytes the loaded sprites use.
+	size_t Memory() const;
+
+
+private:
+	class Entry {
+	public:
+		size_t memory = 0;
+		size_t lastUse = 0;
+		bool isNearby = false;
+	};
+
+
+private:
+	size_t limit;
+	size_t uses = 0;
+	std::map<const Sprite *, Entry> entries;
+};
+
+
+
+#endif
@@ -56,7 +56,7 @@ SpriteQueue::~SpriteQueue()
 
 
 // Add a sprite to load.
-void SpriteQueue::Add(const shared_ptr<ImageSet> &images)
+void SpriteQueue::Add(const shared_ptr<ImageSet> &images, bool inBackground)
 {
 	{
 #ifndef ES_NO_THREADS
@@ -66,7 +66,10 @@ void SpriteQueue::Add(const shared_ptr<ImageSet> &images)
 		if(added < 0)
 			return;
 		
-		toRead.push(images);
+		if(inBackground)
+			toReadInBackground.push(images);
+		else
+			toRead.push(images);
 		++added;
 	}
 #ifndef ES_NO_THREADS
@@ -137,12 +140,11 @@ void SpriteQueue::operator()()
 			// "added" to -1.
 			if(added < 0)
 				return;
-			if(toRead.empty())
+			if(toRead.empty() && toReadInBackground.empty())
 				break;
 			
 			// Extract the one item we should work on reading right now.
-			shared_ptr<ImageSet> imageSet = toRead.front();
-			toRead.pop();
+			shared_ptr<ImageSet> imageSet = TakeNext();
 			
 			// It's now safe to add to the lists.
 			lock.unlock();
@@ -169,18 +171,28 @@ void SpriteQueue::operator()()
 	// "added" to -1.
 	if(added < 0)
 		return;
-	if(toRead.empty())
+	if(toRead.empty() && toReadInBackground.empty())
 		return;
 
 	// Extract the one item we should work on reading right now.
-	shared_ptr<ImageSet> imageSet = toRead.front();
-	toRead.pop();
+	shared_ptr<ImageSet> imageSet = TakeNext();
 	imageSet->Load();
 	toLoad.push(imageSet);
 #endif // ES_NO_THREADS
 }
 
 
+
+// Take the next image set that should be read from disk.
+shared_ptr<ImageSet> SpriteQueue::TakeNext()
+{
+	queue<shared_ptr<ImageSet>> &next = toRead.empty() ? toReadInBackground : toRead;
+	shared_ptr<ImageSet> imageSet = next.front();
+	next.pop();
+	return imageSet;
+}
+
+
 #ifndef ES_NO_THREADS
 double SpriteQueue::DoLoad(unique_lock<mutex> &lock)
 #else
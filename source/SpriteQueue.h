@@ -42,8 +42,9 @@ public:
 	SpriteQueue &operator=(const SpriteQueue &other) = delete;
 	SpriteQueue &operator=(SpriteQueue &&other) = delete;
 	
-	// Add a sprite to load.
-	void Add(const std::shared_ptr<ImageSet> &images);
+	// Add a sprite to load. Sprites loaded in the background are only read once
+	// there are no other sprites waiting to be read.
+	void Add(const std::shared_ptr<ImageSet> &images, bool inBackground = false);
 	// Unload the texture for the given sprite (to free up memory).
 	void Unload(const std::string &name);
 	// Upload more images and find out our percent completion.
@@ -57,6 +58,9 @@ public:
 	
 	
 private:
+	// Take the next image set that should be read from disk. The caller must
+	// hold the read lock, and make sure there is one.
+	std::shared_ptr<ImageSet> TakeNext();
 #ifndef ES_NO_THREADS
 	double DoLoad(std::unique_lock<std::mutex> &lock);
 #else
@@ -67,6 +71,7 @@ private:
 private:
 	// These are the image sets that need to be loaded from disk.
 	std::queue<std::shared_ptr<ImageSet>> toRead;
+	std::queue<std::shared_ptr<ImageSet>> toReadInBackground;
 #ifndef ES_NO_THREADS
 	std::mutex readMutex;
 	std::condition_variable readCondition;
@@ -17,6 +17,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Shader.h"
 #include "Sprite.h"
 
+#include <cstddef>
 #include <vector>
 #include <sstream>
 
@@ -31,17 +32,30 @@ using namespace std;
 namespace {
 	Shader shader;
 	GLint scaleI;
-	GLint frameI;
-	GLint frameCountI;
+	GLint blurScaleI;
+	// The attributes that are different for each item.
 	GLint positionI;
 	GLint transformI;
 	GLint blurI;
-	GLint clipI;
-	GLint alphaI;
-	GLint swizzlerI;
+	GLint frameI;
+	GLint clipAlphaI;
+	GLint swizzleI;
 	
+	// Items drawn one at a time use this VAO, which sets the attributes for
+	// each item as constants, ...
 	GLuint vao;
 	GLuint vbo;
+	// ... while lists of items use this one, which reads them from the buffer
+	// of items, advancing once per copy (instance) of the vertices drawn.
+	GLuint instanceVao;
+	GLuint instanceVbo;
+	
+	// The items are uploaded exactly as they are stored, so the attributes that
+	// are read as pairs must be next to each other.
+	static_assert(offsetof(SpriteShader::Item, frameCount) == offsetof(SpriteShader::Item, frame) + sizeof(float),
+		"frame count must follow frame");
+	static_assert(offsetof(SpriteShader::Item, alpha) == offsetof(SpriteShader::Item, clip) + sizeof(float),
+		"alpha must follow clip");
 
 	const vector<vector<GLint>> SWIZZLE = {
 		{GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA}, // 0 red + yellow markings (republic)
@@ -74,32 +88,79 @@ namespace {
 		{GL_BLUE, GL_ZERO, GL_ZERO, GL_ALPHA}, // 27 red only (cloaked)
 		{GL_ZERO, GL_ZERO, GL_ZERO, GL_ALPHA} // 28 black only (outline)
 	};
+	
+	// Point the item attributes at the items in the buffer of items, starting
+	// with the item at the given index.
+	void PointAttributes(size_t first)
+	{
+		constexpr GLsizei stride = sizeof(SpriteShader::Item);
+		auto offset = [first](size_t member)
+		{
+			return reinterpret_cast<const GLvoid *>(first * stride + member);
+		};
+		glVertexAttribPointer(positionI, 2, GL_FLOAT, GL_FALSE, stride, offset(offsetof(SpriteShader::Item, position)));
+		glVertexAttribPointer(transformI, 4, GL_FLOAT, GL_FALSE, stride, offset(offsetof(SpriteShader::Item, transform)));
+		glVertexAttribPointer(blurI, 2, GL_FLOAT, GL_FALSE, stride, offset(offsetof(SpriteShader::Item, blur)));
+		glVertexAttribPointer(frameI, 2, GL_FLOAT, GL_FALSE, stride, offset(offsetof(SpriteShader::Item, frame)));
+		glVertexAttribPointer(clipAlphaI, 2, GL_FLOAT, GL_FALSE, stride, offset(offsetof(SpriteShader::Item, clip)));
+		if(swizzleI != -1)
+			glVertexAttribPointer(swizzleI, 1, GL_UNSIGNED_INT, GL_FALSE, stride, offset(offsetof(SpriteShader::Item, swizzle)));
+	}
+	
+	// Get the swizzle to use for the given item.
+	int Swizzle(const SpriteShader::Item &item)
+	{
+		// Bounds check for the swizzle value:
+		return (static_cast<size_t>(item.swizzle) >= SWIZZLE.size() ? 0 : item.swizzle);
+	}
 }
 
 bool SpriteShader::useShaderSwizzle = false;
+bool SpriteShader::useInstancing = false;
 
 // Initialize the shaders.
-void SpriteShader::Init(bool useShaderSwizzle)
+void SpriteShader::Init(bool useShaderSwizzle, bool useInstancing)
 {
 	SpriteShader::useShaderSwizzle = useShaderSwizzle;
+	SpriteShader::useInstancing = useInstancing;
 	
-	static const char *vertexCode =
+	// Everything that is different for each item is an attribute rather than a
+	// uniform, so that a list of items can be drawn with a single draw call.
+	ostringstream vertexCodeStream;
+	vertexCodeStream <<
 		"// vertex sprite shader\n"
 		"precision mediump float;\n"
 		"uniform vec2 scale;\n"
-		"uniform vec2 position;\n"
-		"uniform mat2 transform;\n"
-		"uniform vec2 blur;\n"
-		"uniform float clip;\n"
+		"uniform float blurScale;\n"
 		
 		"in vec2 vert;\n"
+		"in vec2 position;\n"
+		"in vec4 transform;\n"
+		"in vec2 blur;\n"
+		// The animation frame and the number of frames.
+		"in vec2 frame;\n"
+		"in vec2 clipAlpha;\n";
+	if(useShaderSwizzle) vertexCodeStream <<
+		"in float swizzle;\n"
+		"flat out int fragSwizzle;\n";
+	vertexCodeStream <<
 		"out vec2 fragTexCoord;\n"
+		"flat out vec2 fragFrame;\n"
+		"flat out vec2 fragBlur;\n"
+		"flat out float fragAlpha;\n"
 		
 		"void main() {\n"
-		"  vec2 blurOff = 2.f * vec2(vert.x * abs(blur.x), vert.y * abs(blur.y));\n"
-		"  gl_Position = vec4((transform * (vert + blurOff) + position) * scale, 0, 1);\n"
+		"  fragBlur = blur * blurScale;\n"
+		"  vec2 blurOff = 2.f * vec2(vert.x * abs(fragBlur.x), vert.y * abs(fragBlur.y));\n"
+		"  gl_Position = vec4((mat2(transform.xy, transform.zw) * (vert + blurOff) + position) * scale, 0, 1);\n"
 		"  vec2 texCoord = vert + vec2(.5, .5);\n"
-		"  fragTexCoord = vec2(texCoord.x, max(clip, texCoord.y)) + blurOff;\n"
+		// Clipping has the opposite sense in the shader.
+		"  fragTexCoord = vec2(texCoord.x, max(1.f - clipAlpha.x, texCoord.y)) + blurOff;\n"
+		"  fragFrame = frame;\n"
+		"  fragAlpha = clipAlpha.y;\n";
+	if(useShaderSwizzle) vertexCodeStream <<
+		"  fragSwizzle = int(swizzle);\n";
+	vertexCodeStream <<
 		"}\n";
 	
 	ostringstream fragmentCodeStream;
@@ -109,24 +170,24 @@ void SpriteShader::Init(bool useShaderSwizzle)
 #ifdef ES_GLES
 		"precision mediump sampler2DArray;\n"
 #endif
-		"uniform sampler2DArray tex;\n"
-		"uniform float frame;\n"
-		"uniform float frameCount;\n"
-		"uniform vec2 blur;\n";
+		"uniform sampler2DArray tex;\n";
 	if(useShaderSwizzle) fragmentCodeStream <<
-		"uniform int swizzler;\n";
+		"flat in int fragSwizzle;\n";
 	fragmentCodeStream <<
-		"uniform float alpha;\n"
 		"const int range = 5;\n"
 		
 		"in vec2 fragTexCoord;\n"
+		"flat in vec2 fragFrame;\n"
+		"flat in vec2 fragBlur;\n"
+		"flat in float fragAlpha;\n"
 		
 		"out vec4 finalColor;\n"
 		
 		"void main() {\n"
-		"  float first = floor(frame);\n"
-		"  float second = mod(ceil(frame), frameCount);\n"
-		"  float fade = frame - first;\n"
+		"  vec2 blur = fragBlur;\n"
+		"  float first = floor(fragFrame.x);\n"
+		"  float second = mod(ceil(fragFrame.x), fragFrame.y);\n"
+		"  float fade = fragFrame.x - first;\n"
 		"  vec4 color;\n"
 		"  if(blur.x == 0.f && blur.y == 0.f)\n"
 		"  {\n"
@@ -158,7 +219,7 @@ void SpriteShader::Init(bool useShaderSwizzle)
 	if(useShaderSwizzle)
 	{
 		fragmentCodeStream <<
-		"  switch (swizzler) {\n"
+		"  switch (fragSwizzle) {\n"
 		"    case 0:\n"
 		"      color = color.rgba;\n"
 		"      break;\n"
@@ -249,23 +310,23 @@ void SpriteShader::Init(bool useShaderSwizzle)
 		"  }\n";
 	}
 	fragmentCodeStream <<
-		"  finalColor = color * alpha;\n"
+		"  finalColor = color * fragAlpha;\n"
 		"}\n";
 	
+	static const string vertexCodeString = vertexCodeStream.str();
+	static const char *vertexCode = vertexCodeString.c_str();
 	static const string fragmentCodeString = fragmentCodeStream.str();
 	static const char *fragmentCode = fragmentCodeString.c_str();
 	
 	shader = Shader(vertexCode, fragmentCode);
 	scaleI = shader.Uniform("scale");
-	frameI = shader.Uniform("frame");
-	frameCountI = shader.Uniform("frameCount");
-	positionI = shader.Uniform("position");
-	transformI = shader.Uniform("transform");
-	blurI = shader.Uniform("blur");
-	clipI = shader.Uniform("clip");
-	alphaI = shader.Uniform("alpha");
-	if(useShaderSwizzle)
-		swizzlerI = shader.Uniform("swizzler");
+	blurScaleI = shader.Uniform("blurScale");
+	positionI = shader.Attrib("position");
+	transformI = shader.Attrib("transform");
+	blurI = shader.Attrib("blur");
+	frameI = shader.Attrib("frame");
+	clipAlphaI = shader.Attrib("clipAlpha");
+	swizzleI = (useShaderSwizzle ? shader.Attrib("swizzle") : -1);
 	
 	glUseProgram(shader.Object());
 	glUniform1i(shader.Uniform("tex"), 0);
@@ -292,6 +353,30 @@ void SpriteShader::Init(bool useShaderSwizzle)
 	// unbind the VBO and VAO
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
+	
+	if(!useInstancing)
+		return;
+	
+	// The instanced VAO uses the same vertices, plus the buffer of items.
+	glGenVertexArrays(1, &instanceVao);
+	glBindVertexArray(instanceVao);
+	
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glEnableVertexAttribArray(shader.Attrib("vert"));
+	glVertexAttribPointer(shader.Attrib("vert"), 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+	
+	glGenBuffers(1, &instanceVbo);
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+	for(GLint attrib : {positionI, transformI, blurI, frameI, clipAlphaI, swizzleI})
+		if(attrib != -1)
+		{
+			glEnableVertexAttribArray(attrib);
+			glVertexAttribDivisor(attrib, 1);
+		}
+	PointAttributes(0);
+	
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
 }
 
 
@@ -321,6 +406,52 @@ void SpriteShader::Draw(const Sprite *sprite, const Point &position, float zoom,
 
 
 
+void SpriteShader::Draw(const vector<Item> &items, bool withBlur)
+{
+	if(!useInstancing)
+	{
+		Bind();
+		for(const Item &item : items)
+			Add(item, withBlur);
+		Unbind();
+		return;
+	}
+	if(items.empty())
+		return;
+	
+	glUseProgram(shader.Object());
+	glBindVertexArray(instanceVao);
+	
+	GLfloat scale[2] = {2.f / Screen::Width(), -2.f / Screen::Height()};
+	glUniform2fv(scaleI, 1, scale);
+	glUniform1f(blurScaleI, withBlur ? 1.f : 0.f);
+	
+	// Upload all the items at once. Respecifying the whole buffer lets the
+	// driver give it new memory rather than waiting for the last frame's draw
+	// calls to finish reading the old contents.
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(Item) * items.size(), items.data(), GL_STREAM_DRAW);
+	
+	// Items must be drawn in order, so only consecutive items with the same
+	// texture can be drawn together.
+	for(size_t start = 0; start < items.size(); )
+	{
+		const size_t end = BatchEnd(items, start, useShaderSwizzle);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, items[start].texture);
+		if(!useShaderSwizzle)
+			glTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_RGBA, SWIZZLE[Swizzle(items[start])].data());
+		
+		PointAttributes(start);
+		glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, end - start);
+		start = end;
+	}
+	
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	Unbind();
+}
+
+
+
 void SpriteShader::Bind()
 {
 	glUseProgram(shader.Object());
@@ -328,6 +459,7 @@ void SpriteShader::Bind()
 	
 	GLfloat scale[2] = {2.f / Screen::Width(), -2.f / Screen::Height()};
 	glUniform2fv(scaleI, 1, scale);
+	glUniform1f(blurScaleI, 1.f);
 }
 
 
@@ -335,23 +467,20 @@ void SpriteShader::Bind()
 void SpriteShader::Add(const Item &item, bool withBlur)
 {
 	glBindTexture(GL_TEXTURE_2D_ARRAY, item.texture);
-
-	glUniform1f(frameI, item.frame);
-	glUniform1f(frameCountI, item.frameCount);
-	glUniform2fv(positionI, 1, item.position);
-	glUniformMatrix2fv(transformI, 1, false, item.transform);
+	
+	// This VAO has no arrays for the item attributes, so set them as constants.
+	glVertexAttrib2fv(positionI, item.position);
+	glVertexAttrib4fv(transformI, item.transform);
 	// Special case: check if the blur should be applied or not.
 	static const float UNBLURRED[2] = {0.f, 0.f};
-	glUniform2fv(blurI, 1, withBlur ? item.blur : UNBLURRED);
-	// Clipping has the opposite sense in the shader.
-	glUniform1f(clipI, 1.f - item.clip);
-	glUniform1f(alphaI, item.alpha);
+	glVertexAttrib2fv(blurI, withBlur ? item.blur : UNBLURRED);
+	glVertexAttrib2f(frameI, item.frame, item.frameCount);
+	glVertexAttrib2f(clipAlphaI, item.clip, item.alpha);
 	
-	// Bounds check for the swizzle value:
-	int swizzle = (static_cast<size_t>(item.swizzle) >= SWIZZLE.size() ? 0 : item.swizzle);
 	// Set the color swizzle.
+	int swizzle = Swizzle(item);
 	if(SpriteShader::useShaderSwizzle)
-		glUniform1i(swizzlerI, swizzle);
+		glVertexAttrib1f(swizzleI, swizzle);
 	else
 		glTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_RGBA, SWIZZLE[swizzle].data());
 	
@@ -362,12 +491,23 @@ void SpriteShader::Add(const Item &item, bool withBlur)
 
 void SpriteShader::Unbind()
 {
-	// Reset the swizzle.
-	if(SpriteShader::useShaderSwizzle)
-		glUniform1i(swizzlerI, 0);
-	else
+	// Reset the swizzle. (The shader's swizzle is set for every item.)
+	if(!SpriteShader::useShaderSwizzle)
 		glTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_RGBA, SWIZZLE[0].data());
 
 	glBindVertexArray(0);
 	glUseProgram(0);
 }
+
+
+
+// Find the end of the batch of items that begins at the given index.
+size_t SpriteShader::BatchEnd(const vector<Item> &items, size_t start, bool useShaderSwizzle)
+{
+	const Item &first = items[start];
+	size_t end = start + 1;
+	while(end < items.size() && items[end].texture == first.texture
+			&& (useShaderSwizzle || items[end].swizzle == first.swizzle))
+		++end;
+	return end;
+}
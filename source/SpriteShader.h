@@ -16,7 +16,9 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 class Sprite;
 class Point;
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 
 
@@ -43,18 +45,27 @@ public:
 	
 public:
 	// Initialize the shaders.
-	static void Init(bool useShaderSwizzle);
+	static void Init(bool useShaderSwizzle, bool useInstancing);
 	
 	// Draw a sprite.
 	static void Draw(const Sprite *sprite, const Point &position, float zoom = 1.f, int swizzle = 0, float frame = 0.f);
+	// Draw a list of items, in order. If instancing is supported, all the items
+	// are uploaded at once, and each batch of them is drawn with one draw call.
+	static void Draw(const std::vector<Item> &items, bool withBlur = false);
 	
 	static void Bind();
 	static void Add(const Item &item, bool withBlur = false);
 	static void Unbind();
 	
+	// Find the end of the batch of items that begins at the given index. All
+	// the items in a batch use the same texture, and also the same swizzle if
+	// the swizzle is a texture setting rather than part of the shader.
+	static size_t BatchEnd(const std::vector<Item> &items, size_t start, bool useShaderSwizzle);
+	
 	
 private:
 	static bool useShaderSwizzle;
+	static bool useInstancing;
 };
 
 
@@ -23,6 +23,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "Planet.h"
 #include "Random.h"
 #include "SpriteSet.h"
+#include "SystemIndex.h"
 
 #include <algorithm>
 #include <cmath>
@@ -351,7 +352,7 @@ void System::Load(const DataNode &node, Set<Planet> &planets, bool initialLoad)
 // Update any information about the system that may have changed due to events,
 // or because the game was started, e.g. neighbors, solar wind and power, or
 // if the system is inhabited.
-void System::UpdateSystem(const Set<System> &systems, const set<double> &neighborDistances)
+void System::UpdateSystem(const SystemIndex &systems, const set<double> &neighborDistances)
 {
 	neighbors.clear();
 	// Neighbors are cached for each system for the purpose of quicker
@@ -390,6 +391,27 @@ void System::UpdateSystem(const Set<System> &systems, const set<double> &neighbo
 
 
 
+// Update whether the given system is one of this system's neighbors, for each
+// of the neighbor distances, e.g. after one of them has been moved. This gives
+// the same result as UpdateNeighbors() would for that system.
+void System::UpdateNeighbor(const System &other)
+{
+	if(&other == this)
+		return;
+	
+	const bool isLinked = links.count(&other);
+	const double distance = other.Position().Distance(position);
+	for(auto &it : neighbors)
+	{
+		if(isLinked || (!other.Name().empty() && distance <= it.first))
+			it.second.insert(&other);
+		else
+			it.second.erase(&other);
+	}
+}
+
+
+
 // Modify a system's links.
 void System::Link(System *other)
 {
@@ -824,7 +846,7 @@ void System::LoadObject(const DataNode &node, Set<Planet> &planets, bool initial
 // Once the star map is fully loaded or an event has changed systems
 // or links, figure out which stars are "neighbors" of this one, i.e.
 // close enough to see or to reach via jump drive.
-void System::UpdateNeighbors(const Set<System> &systems, double distance)
+void System::UpdateNeighbors(const SystemIndex &systems, double distance)
 {
 	set<const System *> &neighborSet = neighbors[distance];
 	
@@ -834,16 +856,10 @@ void System::UpdateNeighbors(const Set<System> &systems, double distance)
 		neighborSet.insert(system);
 	
 	// Any other star system that is within the neighbor distance is also a
-	// neighbor.
-	for(const auto &it : systems)
-	{
-		// Skip systems that have no name.
-		if(it.first.empty() || it.second.Name().empty())
-			continue;
-
-		if(&it.second != this && it.second.Position().Distance(position) <= distance)
-			neighborSet.insert(&it.second);
-	}
+	// neighbor. (Systems that have no name are not in the index.)
+	vector<const System *> nearby;
+	systems.Within(position, distance, nearby, this);
+	neighborSet.insert(nearby.begin(), nearby.end());
 }
 
 
@@ -31,6 +31,7 @@ class Minable;
 class Planet;
 class Ship;
 class Sprite;
+class SystemIndex;
 
 
 
@@ -80,7 +81,10 @@ public:
 	void Load(const DataNode &node, Set<Planet> &planets, bool initialLoad);
 	// Update any information about the system that may have changed due to events,
 	// e.g. neighbors, solar wind and power, or if the system is inhabited.
-	void UpdateSystem(const Set<System> &systems, const std::set<double> &neighborDistances);
+	void UpdateSystem(const SystemIndex &systems, const std::set<double> &neighborDistances);
+	// Update whether the given system is one of this system's neighbors, for
+	// each of the neighbor distances, e.g. after one of them has been moved.
+	void UpdateNeighbor(const System &other);
 	
 	// Modify a system's links.
 	void Link(System *other);
@@ -170,7 +174,7 @@ private:
 	// Once the star map is fully loaded or an event has changed systems
 	// or links, figure out which stars are "neighbors" of this one, i.e.
 	// close enough to see or to reach via jump drive.
-	void UpdateNeighbors(const Set<System> &systems, double distance);
+	void UpdateNeighbors(const SystemIndex &systems, double distance);
 	
 	
 private:
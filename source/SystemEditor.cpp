@@ -61,6 +61,7 @@ SystemEditor::SystemEditor(Editor &editor, bool &show) noexcept
 void SystemEditor::UpdateSystemPosition(const System *system, Point dp)
 {
 	const_cast<System *>(system)->position += dp;
+	GameData::UpdateSystem(const_cast<System *>(system));
 	SetDirty(system);
 }
 
@@ -663,6 +664,7 @@ void SystemEditor::RenderSystem()
 	if(ImGui::InputDouble2Ex("pos", pos))
 	{
 		object->position.Set(pos[0], pos[1]);
+		GameData::UpdateSystem(object);
 		SetDirty();
 	}
 
@@ -1653,8 +1655,8 @@ void SystemEditor::Delete(const System *system, bool safe)
 
 		auto oldNeighbors = system->VisibleNeighbors();
 		GameData::Systems().Erase(system->name);
-		for(auto &&link : oldNeighbors)
-			GameData::UpdateSystem(const_cast<System *>(link));
+		// This removes the deleted system from the neighbors of every system.
+		GameData::UpdateSystem(const_cast<System *>(system));
 
 		auto newSystem = oldLinks.empty() ?
 			oldNeighbors.empty() ? nullptr : *oldNeighbors.begin()
@@ -0,0 +1,144 @@
+/* SystemIndex.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "SystemIndex.h"
+
+#include "System.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+	// The size of each grid cell. This is the default neighbor distance, so
+	// most queries only need to check a 3x3 block of cells.
+	const double CELL_SIZE = 100.;
+	
+	// Get the coordinate of the grid cell that contains the given position.
+	int64_t Cell(double position)
+	{
+		return static_cast<int64_t>(floor(position / CELL_SIZE));
+	}
+}
+
+
+
+// Index all the named systems in the given set, replacing the current contents.
+void SystemIndex::Build(const Set<System> &systems)
+{
+	Clear();
+	for(const auto &it : systems)
+		if(!it.first.empty() && !it.second.Name().empty())
+			Update(&it.second);
+}
+
+
+
+// Add the given system, or update its grid cell if it has moved.
+void SystemIndex::Update(const System *system)
+{
+	const Point &position = system->Position();
+	uint64_t key = Key(Cell(position.X()), Cell(position.Y()));
+	
+	auto it = entries.find(system);
+	if(it != entries.end())
+	{
+		if(it->second.first == key)
+		{
+			it->second.second = position;
+			return;
+		}
+		Remove(system);
+	}
+	cells[key].push_back(system);
+	entries.emplace(system, make_pair(key, position));
+}
+
+
+
+// Remove the given system from the index.
+void SystemIndex::Remove(const System *system)
+{
+	auto it = entries.find(system);
+	if(it == entries.end())
+		return;
+	
+	auto cell = cells.find(it->second.first);
+	vector<const System *> &systems = cell->second;
+	*find(systems.begin(), systems.end(), system) = systems.back();
+	systems.pop_back();
+	if(systems.empty())
+		cells.erase(cell);
+	entries.erase(it);
+}
+
+
+
+void SystemIndex::Clear()
+{
+	cells.clear();
+	entries.clear();
+}
+
+
+
+// Get the position the given system had when it was last added or updated.
+const Point *SystemIndex::Position(const System *system) const
+{
+	auto it = entries.find(system);
+	return it == entries.end() ? nullptr : &it->second.second;
+}
+
+
+
+// Get all the named systems (other than the given one) that are within the
+// given distance of the given point.
+void SystemIndex::Within(const Point &center, double distance, vector<const System *> &result,
+	const System *exclude) const
+{
+	const int64_t minX = Cell(center.X() - distance);
+	const int64_t maxX = Cell(center.X() + distance);
+	const int64_t minY = Cell(center.Y() - distance);
+	const int64_t maxY = Cell(center.Y() + distance);
+	
+	auto check = [&](const vector<const System *> &entries) -> void
+	{
+		for(const System *system : entries)
+			if(system != exclude && !system->Name().empty() && system->Position().Distance(center) <= distance)
+				result.push_back(system);
+	};
+	// If the circle covers more cells than there are occupied cells, it is
+	// faster to check each of the occupied cells instead.
+	if(static_cast<double>(maxX - minX + 1) * (maxY - minY + 1) > cells.size())
+	{
+		for(const auto &it : cells)
+			check(it.second);
+		return;
+	}
+	
+	for(int64_t y = minY; y <= maxY; ++y)
+		for(int64_t x = minX; x <= maxX; ++x)
+		{
+			auto it = cells.find(Key(x, y));
+			if(it != cells.end())
+				check(it->second);
+		}
+}
+
+
+
+// Get the key of the grid cell with the given coordinates.
+uint64_t SystemIndex::Key(int64_t x, int64_t y)
+{
+	return (static_cast<uint64_t>(x) << 32) ^ static_cast<uint32_t>(y);
+}
@@ -0,0 +1,66 @@
+/* SystemIndex.h
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef SYSTEM_INDEX_H_
+#define SYSTEM_INDEX_H_
+
+#include "Point.h"
+#include "Set.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class System;
+
+
+
+// A spatial index of the positions of star systems on the map. Space is split
+// up into a uniform grid, so that finding the systems within a given distance of
+// a point only needs to look at the grid cells that overlap that circle rather
+// than at every system. Systems that move can be updated in place.
+class SystemIndex {
+public:
+	// Index all the named systems in the given set, replacing the current contents.
+	void Build(const Set<System> &systems);
+	// Add the given system, or update its grid cell if it has moved.
+	void Update(const System *system);
+	// Remove the given system from the index.
+	void Remove(const System *system);
+	void Clear();
+	
+	// Get the position the given system had when it was last added or updated,
+	// or a null pointer if it is not in the index.
+	const Point *Position(const System *system) const;
+	
+	// Get all the named systems (other than the given one) that are within the
+	// given distance of the given point. The results are appended to the vector.
+	void Within(const Point &center, double distance, std::vector<const System *> &result,
+		const System *exclude = nullptr) const;
+	
+	
+private:
+	// Get the key of the grid cell with the given coordinates.
+	static uint64_t Key(int64_t x, int64_t y);
+	
+	
+private:
+	std::unordered_map<uint64_t, std::vector<const System *>> cells;
+	// Remember which cell each system was added to, and its position at the
+	// time, so it can be moved.
+	std::unordered_map<const System *, std::pair<uint64_t, Point>> entries;
+};
+
+
+
+#endif
@@ -29,12 +29,14 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "imgui_ex.h"
 #include "imgui_stdlib.h"
 
+#include <iterator>
 #include <list>
 #include <map>
 #include <set>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 class Editor;
@@ -42,6 +44,8 @@ class Editor;
 
 
 void AddNode(Editor &editor, const std::string &file, const std::string &key, const std::string &name);
+// Marks the file that the given node is saved in as needing to be written.
+void MarkChanged(Editor &editor, const std::string &key, const std::string &name);
 
 
 
@@ -91,6 +95,12 @@ public:
 
 	const std::list<T> &Changes() const { return changes; }
 	const std::map<const T *, std::string> &Dirty() const { return dirty; }
+	// Get the saved copy of the object with the given name, if there is one.
+	const T *FindChange(const std::string &name) const
+	{
+		auto it = changeIndex.find(name);
+		return it == changeIndex.end() ? nullptr : &*it->second;
+	}
 
 	void Clear()
 	{
@@ -98,37 +108,25 @@ public:
 		object = nullptr;
 		dirty.clear();
 		changes.clear();
+		changeIndex.clear();
 	}
 
 	// Saves the specified object.
-	void WriteToPlugin(const T *object, bool useDefault = true) { WriteToPlugin(object, useDefault, 0); }
-	template<typename U>
-	void WriteToPlugin(const U *object, bool useDefault, ...)
-	{
-		dirty.erase(object);
-		for(auto &&obj : changes)
-			if(obj.Name() == object->Name())
-			{
-				obj = *object;
-				return;
-			}
-		if(useDefault)
-			AddNode(editor, defaultFileFor<T>(), keyFor<T>(), object->Name());
-		changes.push_back(*object);
-	}
-	template <typename U>
-	void WriteToPlugin(const U *object, bool useDefault, typename std::decay<decltype(std::declval<U>().TrueName())>::type *)
+	void WriteToPlugin(const T *object, bool useDefault = true)
 	{
 		dirty.erase(object);
-		for(auto &&obj : changes)
-			if(obj.TrueName() == object->TrueName())
-			{
-				obj = *object;
-				return;
-			}
+		const std::string name = GetName(*object);
+		auto it = changeIndex.find(name);
+		if(it != changeIndex.end())
+		{
+			*it->second = *object;
+			MarkChanged(editor, keyFor<T>(), name);
+			return;
+		}
 		if(useDefault)
-			AddNode(editor, defaultFileFor<T>(), keyFor<T>(), object->TrueName());
+			AddNode(editor, defaultFileFor<T>(), keyFor<T>(), name);
 		changes.push_back(*object);
+		changeIndex.emplace(name, std::prev(changes.end()));
 	}
 	// Saves every unsaved object.
 	void WriteAll()
@@ -152,12 +150,13 @@ protected:
 	void DeleteFromChanges()
 	{
 		assert(object && "can't delete null object from list");
-		auto it = std::find_if(changes.begin(), changes.end(), [this](const auto &obj)
-				{
-					return GetName(obj) == GetName(*object);
-				});
-		if(it != changes.end())
-			changes.erase(it);
+		auto it = changeIndex.find(GetName(*object));
+		if(it != changeIndex.end())
+		{
+			MarkChanged(editor, keyFor<T>(), it->first);
+			changes.erase(it->second);
+			changeIndex.erase(it);
+		}
 	}
 
 	void RenderSprites(const std::string &name, std::vector<std::pair<Body, int>> &map);
@@ -177,6 +176,8 @@ protected:
 private:
 	std::map<const T *, std::string> dirty;
 	std::list<T> changes;
+	// The saved objects, indexed by name.
+	std::unordered_map<std::string, typename std::list<T>::iterator> changeIndex;
 };
 
 
@@ -0,0 +1,129 @@
+/* ThreadPool.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+using namespace std;
+
+
+
+// Start the worker threads.
+ThreadPool::ThreadPool(int threadCount)
+	: next(0)
+{
+#ifndef ES_NO_THREADS
+	if(threadCount < 0)
+		threadCount = static_cast<int>(max(1u, thread::hardware_concurrency())) - 1;
+	threads.resize(threadCount);
+	for(thread &t : threads)
+		t = thread(&ThreadPool::Work, this);
+#endif // ES_NO_THREADS
+}
+
+
+
+// Destructor, which waits for all worker threads to wrap up.
+ThreadPool::~ThreadPool()
+{
+#ifndef ES_NO_THREADS
+	{
+		lock_guard<mutex> lock(workMutex);
+		shouldQuit = true;
+	}
+	startCondition.notify_all();
+	for(thread &t : threads)
+		t.join();
+#endif // ES_NO_THREADS
+}
+
+
+
+// Call the given function once for each index from 0 to count - 1.
+void ThreadPool::ForEach(size_t count, const function<void(size_t)> &function)
+{
+	// Small loops are not worth waking up the workers for.
+	if(threads.empty() || count < 2)
+	{
+		for(size_t i = 0; i < count; ++i)
+			function(i);
+		return;
+	}
+
+#ifndef ES_NO_THREADS
+	{
+		lock_guard<mutex> lock(workMutex);
+		task = &function;
+		taskCount = count;
+		next = 0;
+		busy = threads.size();
+		++generation;
+	}
+	startCondition.notify_all();
+
+	Run();
+
+	// Wait for every worker to be done with this loop, so that none of them
+	// is still looking at it when the next one begins.
+	unique_lock<mutex> lock(workMutex);
+	doneCondition.wait(lock, [this]() noexcept -> bool { return !busy; });
+	task = nullptr;
+#endif // ES_NO_THREADS
+}
+
+
+
+// Get the number of threads (including the calling thread) that share the work.
+int ThreadPool::Concurrency() const
+{
+	return threads.size() + 1;
+}
+
+
+
+// Thread entry point.
+void ThreadPool::Work()
+{
+#ifndef ES_NO_THREADS
+	size_t done = 0;
+	while(true)
+	{
+		{
+			unique_lock<mutex> lock(workMutex);
+			startCondition.wait(lock, [this, done]() noexcept -> bool { return shouldQuit || generation != done; });
+			if(shouldQuit)
+				return;
+			done = generation;
+		}
+
+		Run();
+
+		bool isLast = false;
+		{
+			lock_guard<mutex> lock(workMutex);
+			isLast = !--busy;
+		}
+		if(isLast)
+			doneCondition.notify_one();
+	}
+#endif // ES_NO_THREADS
+}
+
+
+
+// Claim and run indices of the current loop until there are none left.
+void ThreadPool::Run()
+{
+	for(size_t i = next++; i < taskCount; i = next++)
+		(*task)(i);
+}
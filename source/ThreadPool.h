@@ -0,0 +1,82 @@
+/* ThreadPool.h
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+// Class holding a set of worker threads that can split up a loop between them,
+// for work that has to be done every step (so starting new threads each time
+// would be too slow). The calling thread helps with the work, and each thread
+// takes the next unclaimed index whenever it finishes one, so that the load is
+// balanced even if some indices take much longer than others.
+class ThreadPool {
+public:
+	// Start the given number of worker threads, or one fewer than the number of
+	// processor cores if no number is given.
+	explicit ThreadPool(int threadCount = -1);
+	~ThreadPool();
+
+	// No moving or copying this class.
+	ThreadPool(const ThreadPool &other) = delete;
+	ThreadPool(ThreadPool &&other) = delete;
+	ThreadPool &operator=(const ThreadPool &other) = delete;
+	ThreadPool &operator=(ThreadPool &&other) = delete;
+
+	// Call the given function once for each index from 0 to count - 1, and
+	// return once all the calls have finished. The calls may happen in any
+	// order and at the same time, so the function must only write to data that
+	// belongs to the index it is given.
+	void ForEach(size_t count, const std::function<void(size_t)> &function);
+
+	// Get the number of threads (including the calling thread) that share the work.
+	int Concurrency() const;
+
+
+private:
+	// Thread entry point.
+	void Work();
+	// Claim and run indices of the current loop until there are none left.
+	void Run();
+
+
+private:
+	std::vector<std::thread> threads;
+#ifndef ES_NO_THREADS
+	std::mutex workMutex;
+	std::condition_variable startCondition;
+	std::condition_variable doneCondition;
+#endif // ES_NO_THREADS
+
+	// The loop that is currently being run.
+	const std::function<void(size_t)> *task = nullptr;
+	size_t taskCount = 0;
+	std::atomic<size_t> next;
+	// Each loop gets a new number, so the workers can tell when a new one begins.
+	size_t generation = 0;
+	// The number of worker threads that have not finished the current loop.
+	size_t busy = 0;
+	bool shouldQuit = false;
+};
+
+
+
+#endif
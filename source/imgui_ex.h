@@ -15,6 +15,7 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 
 #define IMGUI_DEFINE_MATH_OPERATORS
 
+#include "NameIndex.h"
 #include "Set.h"
 #include "imgui.h"
 #include "imgui_internal.h"
@@ -25,6 +26,8 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include <functional>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 
@@ -71,6 +74,28 @@ bool IsValid(const T &obj, decltype(obj.TrueName(), void()) *)
 
 
 
+// Get the search index of the names in the given set, updating it if any names
+// were added or removed since it was last used.
+template <typename T>
+const NameIndex &SearchIndexFor(const Set<T> &elements)
+{
+	static std::unordered_map<const Set<T> *, std::pair<size_t, NameIndex>> indices;
+	auto result = indices.try_emplace(&elements);
+	auto &index = result.first->second;
+	if(result.second || index.first != elements.Revision())
+	{
+		std::vector<const std::string *> names;
+		names.reserve(elements.size());
+		for(const auto &it : elements)
+			names.push_back(&it.first);
+		index.second.Assign(names);
+		index.first = elements.Revision();
+	}
+	return index.second;
+}
+
+
+
 template <typename T>
 IMGUI_API bool ImGui::InputCombo(const char *label, std::string *input, T **element, const Set<T> &elements, std::function<bool(const std::string &)> sort)
 {
@@ -124,64 +149,29 @@ IMGUI_API bool ImGui::InputCombo(const char *label, std::string *input, T **elem
 			return true;
 		}
 
-		std::vector<const std::string *> strings;
-		strings.reserve(elements.size());
-		for(auto it = elements.begin(); it != elements.end(); ++it)
-			if(IsValid(it->second, 0) && (!sort || sort(it->first)))
-				strings.push_back(&it->first);
-
-		std::vector<std::pair<double, const char *>> weights;
-		for(auto &&second : strings)
-		{
-			const auto generatePairs = [](const std::string &str)
-			{
-				std::vector<std::pair<char, char>> pair;
-				for(int i = 0; i < static_cast<int>(str.size()); ++i)
-					pair.emplace_back(str[i], i + 1 < static_cast<int>(str.size()) ? str[i + 1] : '\0');
-				return pair;
-			};
-			std::vector<std::pair<char, char>> lhsPairs = generatePairs(*input);
-			std::vector<std::pair<char, char>> rhsPairs = generatePairs(*second);
-
-			int sameCount = 0;
-			const auto transform = [](std::pair<char, char> c)
-			{
-				if(std::isalpha(c.first))
-					c.first = std::tolower(c.first);
-				if(std::isalpha(c.second))
-					c.second = std::tolower(c.second);
-				return c;
-			};
-			for(int i = 0, size = std::min(lhsPairs.size(), rhsPairs.size()); i < size; ++i)
-			{
-				const auto &lhs = transform(lhsPairs[i]);
-				const auto &rhs = transform(rhsPairs[i]);
-				if(lhs == rhs)
-					++sameCount;
-				else if(i == size - 1 && lhs.second == '\0' && lhs.first == rhs.first)
-					++sameCount;
-			}
-
-			weights.emplace_back((2. * sameCount) / (lhsPairs.size() + rhsPairs.size()), second->c_str());
-		}
-
-		std::sort(weights.begin(), weights.end(),
-				[](const std::pair<double, const char *> &lhs, const std::pair<double, const char *> &rhs)
-					{ return lhs.first > rhs.first; });
+		// Only list the best matches, unless there is nothing to match against.
+		const size_t MAX_MATCHES = 100;
+		std::vector<std::pair<double, const std::string *>> weights;
+		SearchIndexFor(elements).Search(*input, input->empty() ? elements.size() : MAX_MATCHES, weights,
+				[&elements, &sort](const std::string &name)
+				{
+					return IsValid(*elements.Find(name), 0) && (!sort || sort(name));
+				});
 
 		if(!weights.empty())
 		{
 			auto topWeight = weights[0].first;
 			for(const auto &item : weights)
 			{
+				const char *name = item.second->c_str();
 				// Allow the user to select an entry in the combo box.
 				// This is a hack to workaround the fact that we change the focus when clicking an
 				// entry and that this means that the filtered list will change (breaking entries).
-				if(GetActiveID() == GetCurrentWindow()->GetID(item.second) || GetFocusID() == GetCurrentWindow()->GetID(item.second))
+				if(GetActiveID() == GetCurrentWindow()->GetID(name) || GetFocusID() == GetCurrentWindow()->GetID(name))
 				{
-					*element = const_cast<T *>(elements.Get(item.second));
+					*element = const_cast<T *>(elements.Get(name));
 					changed = true;
-					*input = item.second;
+					*input = name;
 					CloseCurrentPopup();
 					SetActiveID(0, GetCurrentWindow());
 				}
@@ -189,11 +179,11 @@ IMGUI_API bool ImGui::InputCombo(const char *label, std::string *input, T **elem
 				if(topWeight && item.first < topWeight * .45)
 					continue;
 
-				if(Selectable(item.second) || autocomplete)
+				if(Selectable(name) || autocomplete)
 				{
-					*element = const_cast<T *>(elements.Get(item.second));
+					*element = const_cast<T *>(elements.Get(name));
 					changed = true;
-					*input = item.second;
+					*input = name;
 					if(autocomplete)
 					{
 						autocomplete = false;
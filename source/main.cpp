@@ -157,7 +157,7 @@ int main(int argc, char *argv[])
 		if(!GameWindow::Init())
 			return 1;
 		
-		GameData::LoadShaders(!GameWindow::HasSwizzle());
+		GameData::LoadShaders(!GameWindow::HasSwizzle(), GameWindow::HasInstancing());
 		
 		// Show something other than a blank window.
 		GameWindow::Step();
@@ -0,0 +1,221 @@
+/* test_ai.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/AI.h"
+
+// ... and any system includes needed for the test file.
+#include "datanode-factory.h"
+#include "../../source/Angle.h"
+#include "../../source/Command.h"
+#include "../../source/Flotsam.h"
+#include "../../source/GameData.h"
+#include "../../source/Government.h"
+#include "../../source/Minable.h"
+#include "../../source/Outfit.h"
+#include "../../source/Personality.h"
+#include "../../source/PlayerInfo.h"
+#include "../../source/Point.h"
+#include "../../source/Random.h"
+#include "../../source/Ship.h"
+#include "../../source/System.h"
+#include "../../source/ThreadPool.h"
+#include "../../source/Visual.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+
+// The names of all the objects used by these tests, so that they do not mix
+// with any other objects that were loaded.
+const std::string PREFIX = "AI Test ";
+
+// The personality and government of each ship, and the ship it escorts.
+struct Crew {
+	std::string personality;
+	std::string government;
+	int parent;
+};
+const std::vector<Crew> CREWS = {
+	{"heroic opportunistic", "Red", -1}, {"escort opportunistic", "Red", 0}, {"escort", "Red", 0}, {"escort timid", "Red", 2},
+	{"opportunistic vindictive", "Blue", -1}, {"escort", "Blue", 4}, {"escort heroic", "Blue", 4},
+	{"surveillance", "Blue", -1}, {"staying", "Blue", -1}, {"staying uninterested", "Gray", -1},
+	{"swarming opportunistic", "Gray", -1}, {"swarming", "Gray", -1}, {"swarming", "Gray", -1}, {"swarming", "Gray", -1},
+	{"timid", "Gray", -1}, {"timid frugal", "Gray", 14}, {"coward", "Red", 0}, {"unconstrained", "Gray", -1},
+};
+
+// What a ship decided to do in one step.
+struct Decision {
+	Command command;
+	double turn;
+	std::vector<double> aim;
+	int target;
+	const System *targetSystem;
+
+	bool operator==(const Decision &other) const
+	{
+		return !(command < other.command) && !(other.command < command) && turn == other.turn
+			&& aim == other.aim && target == other.target && targetSystem == other.targetSystem;
+	}
+};
+
+// Create or change an object the way an event would.
+void Change(const std::string &text)
+{
+	GameData::Change(AsDataNode(text));
+}
+
+// Define the governments, the systems, and the turrets that the ships use.
+void DefineWorld()
+{
+	Change("government \"" + PREFIX + "Red\"\n\t\"attitude toward\"\n\t\t\"" + PREFIX + "Blue\" -1");
+	Change("government \"" + PREFIX + "Blue\"\n\t\"attitude toward\"\n\t\t\"" + PREFIX + "Red\" -1");
+	Change("government \"" + PREFIX + "Gray\"");
+	Change("system \"" + PREFIX + "Home\"\n\tpos 0 0\n\tlink \"" + PREFIX + "Away\"");
+	Change("system \"" + PREFIX + "Away\"\n\tpos 50 0\n\tlink \"" + PREFIX + "Home\"");
+	const_cast<Outfit *>(GameData::Outfits().Get(PREFIX + "Turret"))->Load(AsDataNode(
+		"outfit \"" + PREFIX + "Turret\"\n"
+		"\tcategory \"Turrets\"\n"
+		"\t\"turret mounts\" -1\n"
+		"\tweapon\n"
+		"\t\tvelocity 20\n"
+		"\t\tlifetime 60\n"
+		"\t\treload 10\n"
+		"\t\t\"turret turn\" 3\n"
+		"\t\t\"hull damage\" 1"));
+}
+
+const System *GetSystem(const std::string &name)
+{
+	return GameData::Systems().Get(PREFIX + name);
+}
+
+// Create the ships, in places that depend on the shared random number generator.
+std::list<std::shared_ptr<Ship>> MakeShips()
+{
+	std::list<std::shared_ptr<Ship>> ships;
+	std::vector<std::shared_ptr<Ship>> byIndex;
+	for(const Crew &crew : CREWS)
+	{
+		auto ship = std::make_shared<Ship>(AsDataNode(
+			"ship \"" + PREFIX + "Ship\"\n"
+			"\tattributes\n"
+			"\t\tcategory \"Light Warship\"\n"
+			"\t\tmass 100\n"
+			"\t\tdrag 1\n"
+			"\t\tthrust 20\n"
+			"\t\tturn 200\n"
+			"\t\thull 1000\n"
+			"\t\tshields 1000\n"
+			"\t\t\"fuel capacity\" 500\n"
+			"\t\thyperdrive 1\n"
+			"\t\t\"jump fuel\" 100\n"
+			"\t\t\"energy capacity\" 1000\n"
+			"\t\t\"energy generation\" 50\n"
+			"\t\t\"heat dissipation\" .5\n"
+			"\t\t\"cargo space\" 50\n"
+			"\t\tbunks 2\n"
+			"\t\t\"turret mounts\" 2\n"
+			"\toutfits\n"
+			"\t\t\"" + PREFIX + "Turret\" 2\n"
+			"\tturret -5 0 \"" + PREFIX + "Turret\"\n"
+			"\tturret 5 0 \"" + PREFIX + "Turret\""));
+		ship->FinishLoading(true);
+		ship->SetSystem(GetSystem("Home"));
+		ship->SetGovernment(GameData::Governments().Get(PREFIX + crew.government));
+		Personality personality;
+		personality.Load(AsDataNode("personality " + crew.personality));
+		ship->SetPersonality(personality);
+		ship->Place(Point(Random::Real() * 6000. - 3000., Random::Real() * 6000. - 3000.),
+			Angle::Random().Unit() * 2., Angle::Random());
+		ship->Recharge(true);
+		if(crew.parent >= 0)
+			ship->SetParent(byIndex[crew.parent]);
+		byIndex.push_back(ship);
+		ships.push_back(ship);
+	}
+	return ships;
+}
+
+// Let the AI run the given ships for the given number of steps, and record
+// what it decided for each of them in each step.
+std::vector<std::vector<Decision>> Run(int threadCount, uint64_t seed, int steps)
+{
+	Random::Seed(seed);
+	std::list<std::shared_ptr<Ship>> ships = MakeShips();
+	std::list<std::shared_ptr<Minable>> minables;
+	std::list<std::shared_ptr<Flotsam>> flotsam;
+	ThreadPool workers(threadCount);
+	AI ai(ships, minables, flotsam, workers);
+	PlayerInfo player;
+	player.SetSystem(*GetSystem("Home"));
+	std::vector<Visual> visuals;
+
+	std::vector<std::vector<Decision>> result;
+	for(int i = 0; i < steps; ++i)
+	{
+		Command activeCommands;
+		ai.Step(player, activeCommands);
+		result.emplace_back();
+		for(const std::shared_ptr<Ship> &ship : ships)
+		{
+			const Command &command = ship->Commands();
+			Decision decision{command, command.Turn(), {command.Aim(0), command.Aim(1)}, -1, ship->GetTargetSystem()};
+			auto target = std::find(ships.begin(), ships.end(), ship->GetTargetShip());
+			if(target != ships.end())
+				decision.target = std::distance(ships.begin(), target);
+			result.back().push_back(decision);
+		}
+		for(const std::shared_ptr<Ship> &ship : ships)
+			ship->Move(visuals, flotsam);
+		visuals.clear();
+	}
+	return result;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Deciding what the ships do on several threads", "[AI]" ) {
+	DefineWorld();
+	GIVEN( "fleets of escorts, swarms, and ships on their own" ) {
+		const int STEPS = 60;
+		const std::vector<uint64_t> SEEDS = {1, 2, 3};
+		WHEN( "the same ships are run again on one thread" ) {
+			THEN( "every decision is the same" ) {
+				for(uint64_t seed : SEEDS)
+					CHECK( Run(0, seed, STEPS) == Run(0, seed, STEPS) );
+			}
+		}
+		WHEN( "the same ships are run on several threads" ) {
+			THEN( "every decision is the same as on one thread" ) {
+				for(uint64_t seed : SEEDS)
+					CHECK( Run(3, seed, STEPS) == Run(0, seed, STEPS) );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,162 @@
+/* test_batchDrawList.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/BatchDrawList.h"
+
+// ... and any system includes needed for the test file.
+#include "../../source/Sprite.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+	// The number of times memory has been allocated anywhere in the program.
+	std::atomic<size_t> allocationCount(0);
+}
+
+// Count every allocation, so the tests can check whether reusing a storage
+// needs any new memory.
+void *operator new(std::size_t size)
+{
+	++allocationCount;
+	if(void *p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+namespace { // test namespace
+// #region mock data
+
+// Add a copy of the given sprite, marking all its vertex data with the given
+// value so that it can be found after sorting.
+void AddCopy(BatchDrawList::Storage &storage, const Sprite *sprite, float value)
+{
+	float *v = storage.Add(sprite);
+	std::fill(v, v + BatchDrawList::Storage::FLOATS, value);
+}
+
+// Add copies of three sprites in a mixed up order, as projectiles would be.
+void AddFrame(BatchDrawList::Storage &storage, const std::vector<Sprite> &sprites, int copies)
+{
+	for(int i = 0; i < copies; ++i)
+		AddCopy(storage, &sprites[(i * 7) % 3], i);
+}
+
+// Draw one frame with the given number of copies, and return the number of
+// times that memory was allocated while doing so.
+size_t DrawFrame(BatchDrawList::Storage &storage, const std::vector<Sprite> &sprites, int copies)
+{
+	const size_t before = allocationCount;
+	storage.Clear();
+	AddFrame(storage, sprites, copies);
+	storage.Sort();
+	return allocationCount - before;
+}
+
+// Get the marker values of the copies in the given group, in order.
+std::vector<float> Markers(const BatchDrawList::Storage &storage, const BatchDrawList::Storage::Group &group)
+{
+	std::vector<float> markers;
+	for(size_t i = group.begin; i < group.end; i += BatchDrawList::Storage::FLOATS)
+		markers.push_back(storage.Sorted()[i]);
+	return markers;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Grouping a batch draw list by sprite", "[BatchDrawList]" ) {
+	GIVEN( "copies of several sprites added in a mixed up order" ) {
+		const std::vector<Sprite> sprites(3);
+		BatchDrawList::Storage storage;
+		AddCopy(storage, &sprites[2], 0.f);
+		AddCopy(storage, &sprites[0], 1.f);
+		AddCopy(storage, &sprites[2], 2.f);
+		AddCopy(storage, &sprites[1], 3.f);
+		AddCopy(storage, &sprites[2], 4.f);
+		AddCopy(storage, &sprites[0], 5.f);
+
+		WHEN( "the storage is sorted" ) {
+			storage.Sort();
+			const auto &groups = storage.Groups();
+			THEN( "there is one group for each sprite, in order of address" ) {
+				REQUIRE( groups.size() == 3 );
+				CHECK( groups[0].sprite == &sprites[0] );
+				CHECK( groups[1].sprite == &sprites[1] );
+				CHECK( groups[2].sprite == &sprites[2] );
+				CHECK( storage.Sorted().size() == 6 * BatchDrawList::Storage::FLOATS );
+			}
+			THEN( "the copies of each sprite are in the order they were added" ) {
+				CHECK( Markers(storage, groups[0]) == std::vector<float>{1.f, 5.f} );
+				CHECK( Markers(storage, groups[1]) == std::vector<float>{3.f} );
+				CHECK( Markers(storage, groups[2]) == std::vector<float>{0.f, 2.f, 4.f} );
+			}
+		}
+		WHEN( "the storage is cleared" ) {
+			storage.Clear();
+			storage.Sort();
+			THEN( "there is nothing to draw" ) {
+				CHECK( storage.Groups().empty() );
+				CHECK( storage.Sorted().empty() );
+			}
+		}
+	}
+}
+
+SCENARIO( "Reusing a batch draw list from one frame to the next", "[BatchDrawList]" ) {
+	GIVEN( "a storage that has been used for one frame" ) {
+		const std::vector<Sprite> sprites(3);
+		BatchDrawList::Storage storage;
+		REQUIRE( DrawFrame(storage, sprites, 1000) > 0 );
+
+		WHEN( "later frames draw the same number of sprites or fewer" ) {
+			size_t allocations = 0;
+			for(int copies : {1000, 400, 1000, 0, 999})
+				allocations += DrawFrame(storage, sprites, copies);
+			THEN( "no more memory is allocated" ) {
+				CHECK( allocations == 0 );
+			}
+		}
+		WHEN( "a later frame draws more sprites" ) {
+			const size_t grown = DrawFrame(storage, sprites, 3000);
+			const size_t again = DrawFrame(storage, sprites, 3000);
+			THEN( "the storage grows, and then stops allocating again" ) {
+				CHECK( grown > 0 );
+				CHECK( again == 0 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,257 @@
+/* test_collisionSet.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/CollisionSet.h"
+
+// ... and any system includes needed for the test file.
+#include "../../source/Body.h"
+#include "../../source/Point.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+
+// Bodies without a sprite take up a single point, which is enough to check
+// which grid cells a query looks at.
+std::vector<Body> MakeBodies()
+{
+	std::vector<Body> bodies;
+	for(int y = -3; y <= 3; ++y)
+		for(int x = -3; x <= 3; ++x)
+			bodies.emplace_back(nullptr, Point(100. * x + 7., 100. * y - 11.));
+	return bodies;
+}
+
+std::vector<Body *> Sorted(std::vector<Body *> bodies)
+{
+	std::sort(bodies.begin(), bodies.end());
+	return bodies;
+}
+
+// Scatter the given number of bodies over a square of the given size.
+std::vector<Body> ScatterBodies(int count, double size)
+{
+	std::vector<Body> bodies;
+	unsigned state = 12345u;
+	const auto next = [&state, size]()
+	{
+		state = state * 1103515245u + 12345u;
+		return size * ((state >> 8) & 0xFFFF) / 65536. - .5 * size;
+	};
+	for(int i = 0; i < count; ++i)
+	{
+		const double x = next();
+		bodies.emplace_back(nullptr, Point(x, next()));
+	}
+	return bodies;
+}
+
+// A body that can be moved around, to test how the set follows it.
+class MovingBody : public Body {
+public:
+	MovingBody() : Body(nullptr, Point()) {}
+	void MoveTo(const Point &point) { position = point; }
+};
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Querying a collision set with buffers owned by the caller", "[CollisionSet]" ) {
+	GIVEN( "a set of bodies spread over several grid cells" ) {
+		std::vector<Body> bodies = MakeBodies();
+		CollisionSet set(64u, 8u);
+		set.Clear(0);
+		for(Body &body : bodies)
+			set.Add(body);
+		set.Finish();
+
+		std::vector<Body *> result;
+		WHEN( "looking for bodies within a circle" ) {
+			const Point center(20., -30.);
+			const double radius = 180.;
+			set.Circle(center, radius, result);
+			THEN( "each body in range is found exactly once" ) {
+				std::vector<Body *> expected;
+				for(Body &body : bodies)
+					if(body.Position().Distance(center) <= radius)
+						expected.push_back(&body);
+				CHECK( Sorted(result) == Sorted(expected) );
+			}
+			THEN( "the result is the same as the one stored in the set" ) {
+				CHECK( result == set.Circle(center, radius) );
+			}
+		}
+		WHEN( "looking for bodies touching a ring" ) {
+			const Point center(-50., 40.);
+			set.Ring(center, 100., 250., result);
+			THEN( "only the bodies between the inner and outer range are found" ) {
+				std::vector<Body *> expected;
+				for(Body &body : bodies)
+				{
+					const double distance = body.Position().Distance(center);
+					if(distance >= 100. && distance <= 250.)
+						expected.push_back(&body);
+				}
+				CHECK( Sorted(result) == Sorted(expected) );
+			}
+		}
+		WHEN( "the circle is larger than the whole grid" ) {
+			set.Circle(Point(), 1000., result);
+			THEN( "every body is still found only once" ) {
+				CHECK( result.size() == bodies.size() );
+				const std::vector<Body *> sorted = Sorted(result);
+				CHECK( std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end() );
+			}
+		}
+		WHEN( "the buffer already holds the result of another query" ) {
+			set.Circle(Point(), 1000., result);
+			set.Circle(Point(1000., 1000.), 10., result);
+			THEN( "it is replaced" ) {
+				CHECK( result.empty() );
+			}
+		}
+	}
+}
+
+SCENARIO( "Querying a crowded collision set", "[CollisionSet]" ) {
+	GIVEN( "many bodies in each grid cell" ) {
+		std::vector<Body> bodies = ScatterBodies(300, 256.);
+		CollisionSet set(64u, 8u);
+		set.Clear(0);
+		for(Body &body : bodies)
+			set.Add(body);
+		set.Finish();
+
+		std::vector<Body *> result;
+		THEN( "rings of any size find the same bodies as checking each one" ) {
+			for(const double inner : {0., 10., 40., 95.})
+				for(const double outer : {5., 41., 100., 300.})
+				{
+					const Point center(13.5, -27.25);
+					set.Ring(center, inner, outer, result);
+					std::vector<Body *> expected;
+					for(Body &body : bodies)
+					{
+						const double distance = body.Position().Distance(center);
+						if(distance >= inner && distance <= outer)
+							expected.push_back(&body);
+					}
+					CHECK( Sorted(result) == Sorted(expected) );
+				}
+		}
+	}
+}
+
+SCENARIO( "Updating a collision set from one step to the next", "[CollisionSet]" ) {
+	GIVEN( "a set of bodies" ) {
+		std::vector<MovingBody> bodies(3);
+		bodies[0].MoveTo(Point(10., 10.));
+		bodies[1].MoveTo(Point(100., 10.));
+		bodies[2].MoveTo(Point(-100., -100.));
+		CollisionSet set(64u, 8u);
+		set.Clear(0);
+		for(Body &body : bodies)
+			set.Add(body);
+		set.Finish();
+
+		WHEN( "the bodies move and are added again" ) {
+			bodies[0].MoveTo(Point(12., 11.));
+			bodies[1].MoveTo(Point(-90., -80.));
+			set.Update(1);
+			for(Body &body : bodies)
+				set.Add(body);
+			set.Finish();
+			THEN( "they are found in their new positions only" ) {
+				CHECK( set.Circle(Point(100., 10.), 30.).empty() );
+				CHECK( Sorted(set.Circle(Point(-95., -90.), 30.)) == Sorted({&bodies[1], &bodies[2]}) );
+				CHECK( set.Circle(Point(10., 10.), 30.) == std::vector<Body *>{&bodies[0]} );
+			}
+		}
+		WHEN( "a body is not added again" ) {
+			set.Update(1);
+			set.Add(bodies[0]);
+			set.Add(bodies[2]);
+			set.Finish();
+			THEN( "it is removed from the set" ) {
+				CHECK( Sorted(set.Circle(Point(), 1000.)) == Sorted({&bodies[0], &bodies[2]}) );
+			}
+		}
+		WHEN( "a body is added twice" ) {
+			set.Update(1);
+			for(Body &body : bodies)
+				set.Add(body);
+			set.Add(bodies[1]);
+			set.Finish();
+			THEN( "it is only in the set once" ) {
+				CHECK( set.Circle(Point(), 1000.).size() == bodies.size() );
+			}
+		}
+		WHEN( "the set is cleared" ) {
+			set.Clear(1);
+			set.Add(bodies[2]);
+			set.Finish();
+			THEN( "only the bodies added since then are in it" ) {
+				CHECK( set.Circle(Point(), 1000.) == std::vector<Body *>{&bodies[2]} );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+// #region benchmarks
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE( "Benchmark CollisionSet::Circle", "[!benchmark][CollisionSet]" ) {
+	// Compare checking the distance to each body through its pointer with the
+	// set's range check on its own copies of the positions.
+	for(const int count : {100, 500, 2000})
+	{
+		std::vector<Body> bodies = ScatterBodies(count, 4096.);
+		std::vector<Body *> pointers;
+		for(Body &body : bodies)
+			pointers.push_back(&body);
+		CollisionSet set(256u, 32u);
+		set.Clear(0);
+		for(Body &body : bodies)
+			set.Add(body);
+		set.Finish();
+
+		const Point center(100., -200.);
+		std::vector<Body *> result;
+		BENCHMARK( "Distance to each body, " + std::to_string(count) + " bodies" ) {
+			result.clear();
+			for(Body *body : pointers)
+				if(body->Position().Distance(center) <= 600.)
+					result.push_back(body);
+			return result.size();
+		};
+		BENCHMARK( "CollisionSet::Circle, " + std::to_string(count) + " bodies" ) {
+			set.Circle(center, 600., result);
+			return result.size();
+		};
+	}
+}
+#endif
+// #endregion benchmarks
+
+
+
+} // test namespace
@@ -21,8 +21,12 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "output-capture.hpp"
 
 // ... and any system includes needed for the test file.
+#include "../../source/DataFile.h"
+#include "../../source/Files.h"
+
 #include <map>
 #include <string>
+#include <vector>
 
 namespace { // test namespace
 
@@ -175,4 +179,39 @@ SCENARIO( "Applying changes to conditions", "[ConditionSet][Usage]" ) {
 
 
 
+// #region benchmarks
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE( "Benchmark testing the offer conditions of every mission", "[!benchmark][ConditionSet]" ) {
+	// Load the "to offer" conditions of every mission in the game data, and
+	// give the player a condition for each mission that has been done.
+	std::vector<ConditionSet> sets;
+	ConditionSet::Conditions conditions = {{"combat rating", 2000}, {"day", 16}, {"month", 11}, {"year", 3014}};
+	for(const std::string &path : Files::RecursiveList("data/"))
+	{
+		const DataFile file(path);
+		for(const DataNode &node : file)
+			if(node.Token(0) == "mission" && node.Size() >= 2)
+			{
+				conditions[node.Token(1) + ": offered"] = 1;
+				conditions[node.Token(1) + ": done"] = conditions.size() % 2;
+				for(const DataNode &child : node)
+					if(child.Size() == 2 && child.Token(0) == "to" && child.Token(1) == "offer")
+						sets.emplace_back(child);
+			}
+	}
+	if(sets.empty())
+		WARN( "The game data was not found, so there is nothing to benchmark." );
+	
+	BENCHMARK( "ConditionSet::Test" ) {
+		int offered = 0;
+		for(const ConditionSet &set : sets)
+			offered += set.Test(conditions);
+		return offered;
+	};
+}
+#endif
+// #endregion benchmarks
+
+
+
 } // test namespace
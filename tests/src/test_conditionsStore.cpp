@@ -0,0 +1,113 @@
+/* test_conditionsStore.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/ConditionsStore.h"
+
+// ... and any system includes needed for the test file.
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace { // test namespace
+// #region mock data
+
+// Look up the value of the given condition by its ID.
+const int64_t *FindById(const ConditionsStore &store, const std::string &name)
+{
+	return store.Find(ConditionsStore::Id(name));
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Looking up conditions by ID", "[ConditionsStore]" ) {
+	GIVEN( "the same name" ) {
+		THEN( "it always has the same ID, which differs from other names' IDs" ) {
+			CHECK( ConditionsStore::Id("store test a") == ConditionsStore::Id("store test a") );
+			CHECK( ConditionsStore::Id("store test a") != ConditionsStore::Id("store test b") );
+		}
+	}
+	GIVEN( "a store with some conditions" ) {
+		ConditionsStore store = {{"store test a", 3}, {"store test b", -2}};
+		THEN( "they can be found by name or by ID" ) {
+			REQUIRE( FindById(store, "store test a") );
+			CHECK( *FindById(store, "store test a") == 3 );
+			CHECK( store.Get(ConditionsStore::Id("store test b")) == -2 );
+			CHECK( store.find("store test b")->second == -2 );
+		}
+		THEN( "conditions that are not in it are not found, and have a value of 0" ) {
+			CHECK_FALSE( FindById(store, "store test missing") );
+			CHECK( store.Get(ConditionsStore::Id("store test missing")) == 0 );
+			CHECK( store.Get(1000000) == 0 );
+		}
+		WHEN( "a condition is added or changed" ) {
+			store["store test c"] = 7;
+			++store["store test a"];
+			THEN( "its ID gives the new value" ) {
+				REQUIRE( FindById(store, "store test c") );
+				CHECK( *FindById(store, "store test c") == 7 );
+				CHECK( *FindById(store, "store test a") == 4 );
+				CHECK( store.size() == 3 );
+			}
+		}
+		WHEN( "conditions are erased" ) {
+			store["store test c"] = 7;
+			CHECK( store.erase("store test a") == 1 );
+			CHECK( store.erase("store test missing") == 0 );
+			store.erase(store.lower_bound("store test c"), store.end());
+			THEN( "their IDs no longer find them" ) {
+				CHECK_FALSE( FindById(store, "store test a") );
+				CHECK_FALSE( FindById(store, "store test c") );
+				CHECK( *FindById(store, "store test b") == -2 );
+			}
+			AND_THEN( "they can be added again" ) {
+				store["store test a"] = 1;
+				CHECK( *FindById(store, "store test a") == 1 );
+			}
+		}
+		WHEN( "it is cleared" ) {
+			store.clear();
+			THEN( "nothing is found" ) {
+				CHECK( store.empty() );
+				CHECK_FALSE( FindById(store, "store test a") );
+			}
+		}
+		WHEN( "it is copied" ) {
+			ConditionsStore copy = store;
+			ConditionsStore assigned;
+			assigned = store;
+			store["store test a"] = 10;
+			THEN( "the copies' IDs find their own values" ) {
+				CHECK( *FindById(copy, "store test a") == 3 );
+				CHECK( *FindById(assigned, "store test a") == 3 );
+				CHECK( *FindById(store, "store test a") == 10 );
+			}
+		}
+		WHEN( "it is moved" ) {
+			ConditionsStore moved = std::move(store);
+			THEN( "the IDs still find the values" ) {
+				CHECK( *FindById(moved, "store test a") == 3 );
+				CHECK( *FindById(moved, "store test b") == -2 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,164 @@
+/* test_dataFile.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/DataFile.h"
+
+// Include a helper for capturing & asserting on logged output.
+#include "output-capture.hpp"
+
+// ... and any system includes needed for the test file.
+#include "../../source/DataNode.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+
+// Parse the given text.
+DataFile AsDataFile(const std::string &text)
+{
+	std::istringstream in(text);
+	return DataFile(in);
+}
+
+// Get the first token of each of the given nodes.
+template <class Container>
+std::vector<std::string> Keys(const Container &nodes)
+{
+	std::vector<std::string> keys;
+	for(const DataNode &node : nodes)
+		keys.emplace_back(node.Token(0));
+	return keys;
+}
+
+const std::string SHUTTLE =
+	"ship Shuttle\n"
+	"\tattributes\n"
+	"\t\t\"mass\" 70\n"
+	"\t\tcategory Transport\n"
+	"\n"
+	"# A comment.\n"
+	"\tengine -12 38 # Another comment.\n"
+	"outfit `\"Quoted\" Name`\n";
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Parsing text into a DataFile", "[DataFile]" ) {
+	OutputSink traces(std::cerr);
+	GIVEN( "no text" ) {
+		const DataFile file;
+		THEN( "there are no nodes" ) {
+			CHECK( file.begin() == file.end() );
+		}
+	}
+	GIVEN( "nested nodes" ) {
+		const DataFile file = AsDataFile(SHUTTLE);
+		THEN( "the top level nodes are siblings" ) {
+			CHECK( Keys(file) == std::vector<std::string>{"ship", "outfit"} );
+		}
+		THEN( "each node has the right tokens and children" ) {
+			const DataNode &ship = *file.begin();
+			REQUIRE( ship.Size() == 2 );
+			CHECK( ship.Token(1) == "Shuttle" );
+			CHECK( Keys(ship) == std::vector<std::string>{"attributes", "engine"} );
+
+			const DataNode &attributes = *ship.begin();
+			CHECK( Keys(attributes) == std::vector<std::string>{"mass", "category"} );
+			const DataNode &mass = *attributes.begin();
+			CHECK( mass.IsNumber(1) );
+			CHECK( mass.Value(1) == 70. );
+
+			const DataNode &engine = *++ship.begin();
+			REQUIRE( engine.Size() == 3 );
+			CHECK_FALSE( engine.HasChildren() );
+			CHECK( engine.Value(1) == -12. );
+			CHECK( engine.Value(2) == 38. );
+			const std::vector<std::string> tokens(engine.Tokens().begin(), engine.Tokens().end());
+			CHECK( tokens == std::vector<std::string>{"engine", "-12", "38"} );
+
+			const DataNode &outfit = *++file.begin();
+			REQUIRE( outfit.Size() == 2 );
+			CHECK( outfit.Token(1) == "\"Quoted\" Name" );
+			CHECK_FALSE( outfit.HasChildren() );
+		}
+		THEN( "the nodes print traces that include their parents" ) {
+			const DataNode &category = *++file.begin()->begin()->begin();
+			CHECK( category.PrintTrace() == 6 );
+			CHECK( traces.Flush() == "L1:   ship Shuttle\nL2:     attributes\nL4:       category Transport\n" );
+		}
+		WHEN( "a node is copied" ) {
+			DataNode ship = *file.begin();
+			THEN( "the copy has the same tokens and children" ) {
+				REQUIRE( ship.Size() == 2 );
+				CHECK( ship.Token(0) == "ship" );
+				CHECK( Keys(ship) == std::vector<std::string>{"attributes", "engine"} );
+				CHECK( Keys(*ship.begin()) == std::vector<std::string>{"mass", "category"} );
+			}
+			THEN( "the copy does not refer to the file" ) {
+				CHECK( &ship.Token(0) != &file.begin()->Token(0) );
+				CHECK( &*ship.begin() != &*file.begin()->begin() );
+				const DataNode &category = *++ship.begin()->begin();
+				CHECK( category.PrintTrace() == 4 );
+				CHECK( traces.Flush() == "ship Shuttle\nL2:   attributes\nL4:     category Transport\n" );
+			}
+			AND_WHEN( "the copy is moved" ) {
+				const DataNode *attributes = &*ship.begin();
+				DataNode moved = std::move(ship);
+				THEN( "its children do not move" ) {
+					CHECK( &*moved.begin() == attributes );
+					CHECK( moved.Token(1) == "Shuttle" );
+					CHECK_FALSE( ship.HasChildren() );
+				}
+			}
+		}
+		WHEN( "the file is moved" ) {
+			const DataNode *ship = &*file.begin();
+			DataFile moved = AsDataFile(SHUTTLE);
+			const DataNode *other = &*moved.begin();
+			DataFile target = std::move(moved);
+			THEN( "its nodes do not move" ) {
+				CHECK( &*target.begin() == other );
+				CHECK( Keys(target) == Keys(file) );
+				CHECK( &*file.begin() == ship );
+			}
+		}
+	}
+	GIVEN( "a line with a missing closing quote" ) {
+		const DataFile file = AsDataFile("name \"Unfinished\n");
+		THEN( "the token extends to the end of the line" ) {
+			const DataNode &node = *file.begin();
+			REQUIRE( node.Size() == 2 );
+			CHECK( node.Token(1) == "Unfinished" );
+			CHECK( traces.Flush() == "\nClosing quotation mark is missing:\nL1:   name Unfinished\n" );
+		}
+	}
+	GIVEN( "lines with mixed indentation" ) {
+		const DataFile file = AsDataFile("ship\n\tattributes\n\t  mass 10\n");
+		THEN( "a warning is printed for the line" ) {
+			CHECK( traces.Flush() == "\nMixed whitespace usage in line\nL1:   ship\nL2:     attributes\n" );
+			CHECK( Keys(*file.begin()->begin()) == std::vector<std::string>{"mass"} );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
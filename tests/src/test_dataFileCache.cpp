@@ -0,0 +1,150 @@
+/* test_dataFileCache.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/DataFileCache.h"
+
+// Include a helper for capturing & asserting on logged output.
+#include "output-capture.hpp"
+
+// ... and any system includes needed for the test file.
+#include "../../source/DataFile.h"
+#include "../../source/DataNode.h"
+#include "../../source/Files.h"
+
+#include <string>
+#include <vector>
+
+#if !defined _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace { // test namespace
+// #region mock data
+
+// A data file with mixed indentation, which the parser warns about.
+const std::string MIXED = "ship Shuttle\n\tattributes\n\t  mass 10\n";
+
+// Write the given text to the given file, and give it the given modification
+// time, which is long enough ago for the file to be cached.
+void WriteFile(const std::string &path, const std::string &text, long nanoseconds)
+{
+	Files::Write(path, text);
+	const timespec times[2] = {{1600000000, nanoseconds}, {1600000000, nanoseconds}};
+	utimensat(AT_FDCWD, path.c_str(), times, 0);
+}
+
+// Load the given file through the cache, and get the first token of the
+// first node's first child.
+std::string LoadCached(const std::string &path)
+{
+	DataFile file;
+	file.LoadCached(path);
+	if(file.begin() == file.end() || !file.begin()->HasChildren())
+		return "";
+	return file.begin()->begin()->Token(0);
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Caching parsed data files", "[DataFileCache]" ) {
+	OutputSink traces(std::cerr);
+	char name[] = "/tmp/es-cache-XXXXXX";
+	REQUIRE( mkdtemp(name) );
+	const std::string directory = std::string(name) + "/";
+	const std::string path = directory + "ships.txt";
+	DataFileCache::Init(directory + "cache/");
+
+	GIVEN( "a data file that has been loaded once" ) {
+		WriteFile(path, "ship Shuttle\n\tattributes\n", 100);
+		REQUIRE( LoadCached(path) == "attributes" );
+		const std::vector<std::string> cached = Files::List(directory + "cache/");
+		REQUIRE( cached.size() == 1 );
+
+		WHEN( "the file is loaded again without having changed" ) {
+			// Change the file without changing its size or modification time, so
+			// that it is clear whether the cached copy is used.
+			WriteFile(path, "ship Shuttle\n\tattributez\n", 100);
+			THEN( "the cached copy is used" ) {
+				CHECK( LoadCached(path) == "attributes" );
+			}
+		}
+		WHEN( "the file is changed within the same second, without changing its size" ) {
+			WriteFile(path, "ship Shuttle\n\tattributez\n", 200);
+			THEN( "it is parsed again" ) {
+				CHECK( LoadCached(path) == "attributez" );
+				WriteFile(path, "ship Shuttle\n\tattributes\n", 200);
+				CHECK( LoadCached(path) == "attributez" );
+			}
+		}
+		WHEN( "the file is loaded right after it was modified" ) {
+			Files::Write(path, "ship Shuttle\n\tattributez\n");
+			REQUIRE( LoadCached(path) == "attributez" );
+			THEN( "it is not cached yet, in case it changes again within the same second" ) {
+				WriteFile(path, "ship Shuttle\n\tattributey\n", 100);
+				CHECK( LoadCached(path) == "attributes" );
+			}
+		}
+		WHEN( "the file no longer exists the next time the game starts" ) {
+			Files::Delete(path);
+			Files::Write(cached.front() + ".tmp", "half written");
+			DataFileCache::Init(directory + "cache/");
+			DataFileCache::Prune();
+			THEN( "its cached copy is deleted" ) {
+				CHECK( Files::List(directory + "cache/").empty() );
+			}
+		}
+		WHEN( "the file still exists the next time the game starts" ) {
+			DataFileCache::Init(directory + "cache/");
+			REQUIRE( LoadCached(path) == "attributes" );
+			DataFileCache::Prune();
+			THEN( "its cached copy is kept" ) {
+				CHECK( Files::List(directory + "cache/") == cached );
+			}
+		}
+	}
+	GIVEN( "a data file with mixed indentation" ) {
+		WriteFile(path, MIXED, 100);
+		LoadCached(path);
+		const std::string warnings = traces.Flush();
+		REQUIRE( warnings.find("Mixed whitespace usage in line") != std::string::npos );
+
+		WHEN( "it is loaded from the cache" ) {
+			// Fix the indentation without changing the size or modification time,
+			// so the cached copy is used.
+			WriteFile(path, "ship Shuttle\n\tattributes\n\t\t\tmass 10\n", 100);
+			REQUIRE( LoadCached(path) == "attributes" );
+			THEN( "the same warnings are printed" ) {
+				CHECK( traces.Flush() == warnings );
+			}
+		}
+	}
+
+	for(const std::string &file : Files::List(directory + "cache/"))
+		Files::Delete(file);
+	rmdir((directory + "cache/").c_str());
+	Files::Delete(path);
+	rmdir(name);
+	DataFileCache::Init("");
+}
+// #endregion unit tests
+
+
+
+} // test namespace
+#endif
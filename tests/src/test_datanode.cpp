@@ -39,7 +39,7 @@ TEST_CASE( "DataNode Basics", "[DataNode]" ) {
 	SECTION( "Class Traits" ) {
 		CHECK_FALSE( std::is_trivial<T>::value );
 		// The class layout apparently satisfies StandardLayoutType when building/testing for Steam, but false otherwise.
-		// This may change in the future, with the expectation of false everywhere (due to the list<DataNode> field).
+		// This may change in the future, with the expectation of false everywhere (due to the unique_ptr field).
 		// CHECK_FALSE( std::is_standard_layout<T>::value );
 		CHECK( std::is_nothrow_destructible<T>::value );
 		CHECK_FALSE( std::is_trivially_destructible<T>::value );
@@ -47,8 +47,8 @@ TEST_CASE( "DataNode Basics", "[DataNode]" ) {
 	SECTION( "Construction Traits" ) {
 		CHECK( std::is_default_constructible<T>::value );
 		CHECK_FALSE( std::is_trivially_default_constructible<T>::value );
-		// We explicitly allocate some memory when default-constructing DataNodes.
-		CHECK_FALSE( std::is_nothrow_default_constructible<T>::value );
+		// A default-constructed DataNode does not own any tokens yet.
+		CHECK( std::is_nothrow_default_constructible<T>::value );
 		CHECK( std::is_copy_constructible<T>::value );
 		// We have work to do when copy-constructing, including allocations.
 		CHECK_FALSE( std::is_trivially_copy_constructible<T>::value );
@@ -60,7 +60,7 @@ TEST_CASE( "DataNode Basics", "[DataNode]" ) {
 	}
 	SECTION( "Copy Traits" ) {
 		CHECK( std::is_copy_assignable<T>::value );
-		// The class data can be spread out due to vector + list contents.
+		// The class data can be spread out over the tokens and nodes of an arena.
 		CHECK_FALSE( std::is_trivially_copyable<T>::value );
 		// We have work to do when copying.
 		CHECK_FALSE( std::is_trivially_copy_assignable<T>::value );
@@ -82,9 +82,6 @@ SCENARIO( "Creating a DataNode", "[DataNode]") {
 			CHECK_FALSE( root.HasChildren() );
 			CHECK( root.Tokens().empty() );
 		}
-		THEN( "it preallocates capacity for tokens" ) {
-			CHECK( root.Tokens().capacity() == 4 );
-		}
 	}
 	GIVEN( "When created without a parent" ) {
 		THEN( "it prints its token trace at the correct level" ) {
@@ -0,0 +1,198 @@
+/* test_gameData.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/GameData.h"
+
+// ... and any system includes needed for the test file.
+#include "datanode-factory.h"
+#include "../../source/Set.h"
+#include "../../source/System.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+
+// The jump ranges that the systems' neighbors are found for.
+const std::vector<double> DISTANCES = {100., 160., 250.};
+
+// The names of all the systems used by these tests, so that they do not mix
+// with any other systems that were loaded.
+const std::string PREFIX = "Neighbor Test ";
+
+// Everything that the neighbor lists say about the test systems, by name.
+using Neighbors = std::map<std::string, std::map<double, std::set<std::string>>>;
+
+System *GetSystem(const std::string &name)
+{
+	return const_cast<System *>(GameData::Systems().Get(PREFIX + name));
+}
+
+// Create or change a system the way an event would.
+void Change(const std::string &text)
+{
+	GameData::Change(AsDataNode(text));
+}
+
+// Give the system with the given name the given position, and patch the
+// neighbor lists the way the editor does when a system is moved.
+void Move(const std::string &name, double x, double y)
+{
+	Change("system \"" + PREFIX + name + "\"\n\tpos " + std::to_string(x) + " " + std::to_string(y));
+	GameData::UpdateSystem(GetSystem(name));
+}
+
+// Delete a system the way the editor does.
+void Delete(const std::string &name)
+{
+	System *system = GetSystem(name);
+	const std::set<const System *> links = system->Links();
+	for(const System *link : links)
+	{
+		const_cast<System *>(link)->Unlink(system);
+		GameData::UpdateSystem(const_cast<System *>(link));
+	}
+	GameData::Systems().Erase(PREFIX + name);
+	GameData::UpdateSystem(system);
+}
+
+// Get the neighbors of each of the test systems.
+Neighbors GetNeighbors()
+{
+	Neighbors result;
+	for(const auto &it : GameData::Systems())
+	{
+		if(it.first.compare(0, PREFIX.size(), PREFIX) || it.second.Name().empty())
+			continue;
+		auto &neighbors = result[it.first];
+		for(double distance : DISTANCES)
+			for(const System *neighbor : it.second.JumpNeighbors(distance))
+				neighbors[distance].insert(neighbor->Name());
+		for(const System *neighbor : it.second.VisibleNeighbors())
+			neighbors[0.].insert(neighbor->Name());
+	}
+	return result;
+}
+
+// Check whether the second system is a neighbor of the first one.
+bool IsNeighbor(const Neighbors &neighbors, const std::string &name, const std::string &other, double distance)
+{
+	auto it = neighbors.find(PREFIX + name);
+	if(it == neighbors.end())
+		return false;
+	auto dit = it->second.find(distance);
+	return dit != it->second.end() && dit->second.count(PREFIX + other);
+}
+
+// Get the neighbors that a full rebuild finds for the systems as they are now.
+Neighbors Rebuild()
+{
+	GameData::UpdateSystems(true);
+	return GetNeighbors();
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Updating the neighbors of the systems that changed", "[GameData]" ) {
+	for(double distance : DISTANCES)
+		GameData::AddJumpRange(distance);
+
+	GIVEN( "systems near each other, some of them linked" ) {
+		const std::vector<std::pair<double, double>> positions = {
+			{0., 0.}, {90., 0.}, {180., 10.}, {-60., -80.}, {-150., 40.}, {300., 300.}, {40., 230.}, {-20., 120.}
+		};
+		for(size_t i = 0; i < positions.size(); ++i)
+			Change("system \"" + PREFIX + std::to_string(i) + "\"\n\tpos " + std::to_string(positions[i].first)
+				+ " " + std::to_string(positions[i].second));
+		Change("system \"" + PREFIX + "7\"\n\t\"jump range\" 160");
+		Change("link \"" + PREFIX + "0\" \"" + PREFIX + "5\"");
+		Change("link \"" + PREFIX + "1\" \"" + PREFIX + "2\"");
+		const Neighbors before = Rebuild();
+		REQUIRE( before.size() == positions.size() );
+		REQUIRE( IsNeighbor(before, "0", "5", 100.) );
+		REQUIRE( IsNeighbor(before, "0", "1", 100.) );
+
+		WHEN( "a system is moved within range of others" ) {
+			Move("5", 20., 30.);
+			const Neighbors patched = GetNeighbors();
+			THEN( "the neighbor lists are the same as after a full rebuild" ) {
+				CHECK( patched == Rebuild() );
+				CHECK( patched != before );
+			}
+		}
+		WHEN( "a system is moved out of range of its neighbors" ) {
+			Move("1", 5000., -5000.);
+			const Neighbors patched = GetNeighbors();
+			THEN( "the neighbor lists are the same as after a full rebuild" ) {
+				CHECK( patched == Rebuild() );
+				CHECK_FALSE( IsNeighbor(patched, "0", "1", 100.) );
+				CHECK( IsNeighbor(patched, "2", "1", 100.) );
+			}
+		}
+		WHEN( "a system with its own jump range is moved" ) {
+			Move("7", 100., 100.);
+			const Neighbors patched = GetNeighbors();
+			THEN( "the neighbor lists are the same as after a full rebuild" ) {
+				CHECK( patched == Rebuild() );
+			}
+		}
+		WHEN( "a system is deleted" ) {
+			Delete("0");
+			const Neighbors patched = GetNeighbors();
+			THEN( "the neighbor lists are the same as after a full rebuild" ) {
+				CHECK( patched == Rebuild() );
+				CHECK_FALSE( patched.count(PREFIX + "0") );
+				CHECK_FALSE( IsNeighbor(patched, "1", "0", 100.) );
+				CHECK_FALSE( IsNeighbor(patched, "3", "0", 100.) );
+			}
+		}
+		WHEN( "a system is added" ) {
+			Move("8", 45., -10.);
+			const Neighbors patched = GetNeighbors();
+			THEN( "the neighbor lists are the same as after a full rebuild" ) {
+				CHECK( patched == Rebuild() );
+				CHECK( IsNeighbor(patched, "0", "8", 100.) );
+			}
+		}
+		WHEN( "systems are linked and unlinked" ) {
+			GetSystem("3")->Link(GetSystem("6"));
+			GetSystem("1")->Unlink(GetSystem("2"));
+			for(const char *name : {"1", "2", "3", "6"})
+				GameData::UpdateSystem(GetSystem(name));
+			const Neighbors patched = GetNeighbors();
+			THEN( "the neighbor lists are the same as after a full rebuild" ) {
+				CHECK( patched == Rebuild() );
+				CHECK( IsNeighbor(patched, "3", "6", 100.) );
+			}
+		}
+
+		// Remove the test systems again.
+		for(const auto &it : GameData::Systems())
+			if(!it.first.compare(0, PREFIX.size(), PREFIX))
+				GameData::Systems().Erase(it.first);
+		GameData::UpdateSystems(true);
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
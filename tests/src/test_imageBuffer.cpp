@@ -0,0 +1,179 @@
+/* test_imageBuffer.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/ImageBuffer.h"
+
+// ... and any system includes needed for the test file.
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+
+// Fill every frame of the given buffer with pixels that cover every
+// combination of color and alpha values.
+void Fill(ImageBuffer &buffer, int width, int height)
+{
+	buffer.Allocate(width, height);
+	uint32_t state = 12345u;
+	for(int frame = 0; frame < buffer.Frames(); ++frame)
+		for(int y = 0; y < height; ++y)
+		{
+			uint32_t *it = buffer.Begin(y, frame);
+			for(int x = 0; x < width; ++x)
+			{
+				state = state * 1103515245u + 12345u;
+				const uint32_t alpha = (x + y * width) & 0xFF;
+				const uint32_t color = (x + y * width) >> 8;
+				it[x] = (alpha << 24) | ((state >> 8) & 0xFF0000) | ((color & 0xFF) << 8) | (state >> 24);
+			}
+		}
+}
+
+std::vector<uint32_t> Pixels(const ImageBuffer &buffer)
+{
+	return std::vector<uint32_t>(buffer.Pixels(), buffer.Pixels() + buffer.Width() * buffer.Height() * buffer.Frames());
+}
+
+// The way each pixel was converted before the conversion was vectorized.
+uint32_t PremultiplyReference(uint32_t pixel, int additive)
+{
+	uint64_t value = pixel;
+	uint64_t alpha = (value & 0xFF000000) >> 24;
+	uint64_t red = (((value & 0xFF0000) * alpha) / 255) & 0xFF0000;
+	uint64_t green = (((value & 0xFF00) * alpha) / 255) & 0xFF00;
+	uint64_t blue = (((value & 0xFF) * alpha) / 255) & 0xFF;
+	value = red | green | blue;
+	if(additive == 1)
+		alpha >>= 2;
+	if(additive != 2)
+		value |= (alpha << 24);
+	return static_cast<uint32_t>(value);
+}
+
+// The way images were shrunk before it was vectorized.
+std::vector<uint32_t> ShrinkReference(const ImageBuffer &buffer)
+{
+	const int width = buffer.Width() / 2;
+	const int height = buffer.Height() / 2;
+	std::vector<uint32_t> result(width * height * buffer.Frames());
+	unsigned char *out = reinterpret_cast<unsigned char *>(result.data());
+	const unsigned char *begin = reinterpret_cast<const unsigned char *>(buffer.Pixels());
+	for(int y = 0; y < height * buffer.Frames(); ++y)
+	{
+		const unsigned char *aIt = begin + (4 * buffer.Width()) * (2 * y);
+		const unsigned char *aEnd = aIt + 4 * 2 * width;
+		const unsigned char *bIt = begin + (4 * buffer.Width()) * (2 * y + 1);
+		for( ; aIt != aEnd; aIt += 4, bIt += 4)
+			for(int channel = 0; channel < 4; ++channel, ++aIt, ++bIt, ++out)
+				*out = (static_cast<unsigned>(aIt[0]) + static_cast<unsigned>(bIt[0])
+					+ static_cast<unsigned>(aIt[4]) + static_cast<unsigned>(bIt[4]) + 2) / 4;
+	}
+	return result;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Converting an image to premultiplied alpha", "[ImageBuffer]" ) {
+	GIVEN( "an image with every combination of color and alpha" ) {
+		// The width is not a multiple of four, so some pixels are converted
+		// one at a time at the end of each row.
+		ImageBuffer buffer(2);
+		Fill(buffer, 257, 256);
+		const std::vector<uint32_t> original = Pixels(buffer);
+		for(int additive = 0; additive <= 2; ++additive)
+			WHEN( "it is converted with blending mode " + std::to_string(additive) ) {
+				buffer.Premultiply(1, additive);
+				THEN( "every pixel in that frame matches converting it on its own" ) {
+					const std::vector<uint32_t> result = Pixels(buffer);
+					const size_t frameSize = 257 * 256;
+					size_t mismatches = 0;
+					for(size_t i = 0; i < frameSize; ++i)
+					{
+						mismatches += (result[i] != original[i]);
+						mismatches += (result[i + frameSize] != PremultiplyReference(original[i + frameSize], additive));
+					}
+					CHECK( mismatches == 0 );
+				}
+			}
+	}
+}
+
+SCENARIO( "Shrinking an image to half size", "[ImageBuffer]" ) {
+	GIVEN( "an image whose width leaves some pixels after the last full block" ) {
+		ImageBuffer buffer(3);
+		Fill(buffer, 45, 21);
+		const std::vector<uint32_t> expected = ShrinkReference(buffer);
+		WHEN( "it is shrunk" ) {
+			buffer.ShrinkToHalfSize();
+			THEN( "it has half the size, rounded down" ) {
+				CHECK( buffer.Width() == 22 );
+				CHECK( buffer.Height() == 10 );
+				CHECK( buffer.Frames() == 3 );
+			}
+			THEN( "each pixel is the rounded average of the four it replaces" ) {
+				CHECK( Pixels(buffer) == expected );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+// #region benchmarks
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE( "Benchmark ImageBuffer conversions", "[!benchmark][ImageBuffer]" ) {
+	// A typical ship sprite: several frames of a few hundred pixels each way.
+	ImageBuffer source(4);
+	Fill(source, 480, 360);
+	const std::vector<uint32_t> original = Pixels(source);
+	std::vector<uint32_t> pixels = original;
+
+	BENCHMARK( "Premultiply one pixel at a time" ) {
+		for(uint32_t &pixel : pixels)
+			pixel = PremultiplyReference(pixel, 0);
+		return pixels[0];
+	};
+	BENCHMARK( "ImageBuffer::Premultiply" ) {
+		for(int frame = 0; frame < source.Frames(); ++frame)
+			source.Premultiply(frame, 0);
+		return source.Pixels()[0];
+	};
+	BENCHMARK( "Shrink one channel at a time" ) {
+		return ShrinkReference(source).size();
+	};
+	BENCHMARK_ADVANCED( "ImageBuffer::ShrinkToHalfSize" )(Catch::Benchmark::Chronometer meter) {
+		std::vector<ImageBuffer> buffers(meter.runs());
+		for(ImageBuffer &buffer : buffers)
+		{
+			buffer.Clear(source.Frames());
+			buffer.Allocate(source.Width(), source.Height());
+			std::copy(original.begin(), original.end(), buffer.Pixels());
+		}
+		meter.measure([&buffers](int i) { buffers[i].ShrinkToHalfSize(); return buffers[i].Width(); });
+	};
+}
+#endif
+// #endregion benchmarks
+
+
+
+} // test namespace
@@ -0,0 +1,151 @@
+/* test_mask.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/Mask.h"
+
+// ... and any system includes needed for the test file.
+#include "../../source/Angle.h"
+#include "../../source/ImageBuffer.h"
+#include "../../source/Point.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+
+// Draw a filled ring, with a second smaller blob off to one side, so that the
+// mask has an outline with a hole in it and an outline of its own.
+void DrawShape(ImageBuffer &image)
+{
+	image.Allocate(80, 60);
+	for(int y = 0; y < image.Height(); ++y)
+	{
+		uint32_t *row = image.Begin(y);
+		for(int x = 0; x < image.Width(); ++x)
+		{
+			const Point p(x - 30.5, y - 30.5);
+			const double length = p.Length();
+			const bool isRing = length < 25. && length > 12.;
+			const bool isBlob = Point(x - 68.5, y - 12.5).Length() < 8.;
+			row[x] = (isRing || isBlob) ? 0xFFFFFFFFu : 0u;
+		}
+	}
+}
+
+// The way the checks were done before the edges were packed: walk every edge
+// of every outline, one at a time.
+bool ContainsReference(const Mask &mask, Point point)
+{
+	int intersections = 0;
+	for(const std::vector<Point> &outline : mask.Outlines())
+	{
+		Point prev = outline.back();
+		for(const Point &next : outline)
+		{
+			if(prev.X() != next.X())
+				if((prev.X() <= point.X()) == (point.X() < next.X()))
+				{
+					double y = prev.Y() + (next.Y() - prev.Y()) *
+						(point.X() - prev.X()) / (next.X() - prev.X());
+					intersections += (y >= point.Y());
+				}
+			prev = next;
+		}
+	}
+	return (intersections & 1);
+}
+
+double IntersectionReference(const Mask &mask, Point sA, Point vA)
+{
+	double closest = 1.;
+	for(const std::vector<Point> &outline : mask.Outlines())
+	{
+		Point prev = outline.back();
+		for(const Point &next : outline)
+		{
+			Point vB = next - prev;
+			double cross = vB.Cross(vA);
+			if(cross > 0.)
+			{
+				Point vS = prev - sA;
+				double uB = vA.Cross(vS);
+				double uA = vB.Cross(vS);
+				if((uB >= 0.) & (uB < cross) & (uA >= 0.))
+					closest = std::min(closest, uA / cross);
+			}
+			prev = next;
+		}
+	}
+	return closest;
+}
+
+double CollideReference(const Mask &mask, Point sA, Point vA)
+{
+	if(sA.Length() > mask.Radius() + vA.Length())
+		return 1.;
+	if(sA.Length() <= mask.Radius() && ContainsReference(mask, sA))
+		return 0.;
+	return IntersectionReference(mask, sA, vA);
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Checking for collisions with a mask", "[Mask]" ) {
+	GIVEN( "a mask made from an image" ) {
+		ImageBuffer image;
+		DrawShape(image);
+		Mask mask;
+		mask.Create(image);
+		REQUIRE( mask.IsLoaded() );
+		REQUIRE( mask.Outlines().size() == 3 );
+
+		THEN( "points in the shape are contained and points in the hole are not" ) {
+			CHECK( mask.Contains(Point(4.25, .25), Angle()) );
+			CHECK_FALSE( mask.Contains(Point(-4.75, 0.), Angle()) );
+			CHECK( mask.Contains(Point(14.25, -8.75), Angle()) );
+		}
+		THEN( "every check gives the same result as walking the edges one at a time" ) {
+			for(int y = -24; y <= 24; y += 3)
+				for(int x = -24; x <= 24; x += 3)
+				{
+					const Point point(x + .25, y - .5);
+					CHECK( mask.Contains(point, Angle()) == ContainsReference(mask, point) );
+					for(const Point &v : {Point(40., 3.), Point(-7., -30.), Point(.5, 60.), Point(0., 0.)})
+						CHECK( mask.Collide(point, v, Angle()) == CollideReference(mask, point, v) );
+				}
+		}
+		WHEN( "the mask is scaled" ) {
+			const Mask scaled = mask * 2.;
+			THEN( "the checks use the scaled outlines" ) {
+				CHECK( scaled.Contains(Point(8.5, .5), Angle()) );
+				CHECK_FALSE( scaled.Contains(Point(-9.5, .5), Angle()) );
+				const Point from(-40., -40.);
+				const Point v(80., 80.);
+				CHECK( scaled.Collide(from, v, Angle()) == CollideReference(scaled, from, v) );
+				CHECK( scaled.Collide(from, v, Angle()) < 1. );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,115 @@
+/* test_maskCache.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/MaskCache.h"
+
+// ... and any system includes needed for the test file.
+#include "../../source/Angle.h"
+#include "../../source/ImageBuffer.h"
+#include "../../source/Mask.h"
+#include "../../source/Point.h"
+
+#include <cstdint>
+#include <string>
+
+namespace { // test namespace
+// #region mock data
+
+// Draw two blobs, so that the mask has more than one outline.
+Mask MakeMask()
+{
+	ImageBuffer image;
+	image.Allocate(40, 30);
+	for(int y = 0; y < image.Height(); ++y)
+	{
+		uint32_t *row = image.Begin(y);
+		for(int x = 0; x < image.Width(); ++x)
+		{
+			const bool isBig = Point(x - 12.5, y - 14.5).Length() < 10.;
+			const bool isSmall = Point(x - 32.5, y - 8.5).Length() < 5.;
+			row[x] = (isBig || isSmall) ? 0xFFFFFFFFu : 0u;
+		}
+	}
+	Mask mask;
+	mask.Create(image);
+	return mask;
+}
+
+const std::string KEY = "images/ship/test.png\n1234";
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Saving a collision mask in binary form", "[MaskCache]" ) {
+	GIVEN( "a mask made from an image" ) {
+		const Mask mask = MakeMask();
+		REQUIRE( mask.IsLoaded() );
+		REQUIRE( mask.Outlines().size() == 2 );
+		const std::string data = MaskCache::Encode(KEY, mask);
+
+		WHEN( "it is decoded with the same key" ) {
+			Mask loaded;
+			const bool decoded = MaskCache::Decode(data, KEY, loaded);
+			THEN( "the mask is exactly the same" ) {
+				REQUIRE( decoded );
+				CHECK( loaded.IsLoaded() );
+				CHECK( loaded.Outlines() == mask.Outlines() );
+				CHECK( loaded.Radius() == mask.Radius() );
+				const Point from(-30., -20.);
+				const Point v(60., 45.);
+				CHECK( loaded.Collide(from, v, Angle()) == mask.Collide(from, v, Angle()) );
+				CHECK( loaded.Contains(Point(-2., .5), Angle()) == mask.Contains(Point(-2., .5), Angle()) );
+			}
+		}
+		WHEN( "it is decoded for a different image or a newer version of it" ) {
+			Mask loaded;
+			THEN( "it is rejected" ) {
+				CHECK_FALSE( MaskCache::Decode(data, "images/ship/other.png\n1234", loaded) );
+				CHECK_FALSE( MaskCache::Decode(data, "images/ship/test.png\n1235", loaded) );
+				CHECK_FALSE( loaded.IsLoaded() );
+			}
+		}
+		WHEN( "the data is cut short or has extra bytes" ) {
+			Mask loaded;
+			THEN( "it is rejected" ) {
+				CHECK_FALSE( MaskCache::Decode(std::string(), KEY, loaded) );
+				CHECK_FALSE( MaskCache::Decode(data.substr(0, data.size() / 2), KEY, loaded) );
+				CHECK_FALSE( MaskCache::Decode(data.substr(0, data.size() - 1), KEY, loaded) );
+				CHECK_FALSE( MaskCache::Decode(data + '\0', KEY, loaded) );
+				CHECK_FALSE( loaded.IsLoaded() );
+			}
+		}
+		WHEN( "the number of outlines is corrupted" ) {
+			// The outline count comes right after the magic number, the version
+			// and the key.
+			std::string corrupted = data;
+			const size_t countPos = 3 * sizeof(uint32_t) + KEY.size();
+			for(size_t i = 0; i < sizeof(uint32_t); ++i)
+				corrupted[countPos + i] = '\xFF';
+			Mask loaded;
+			THEN( "it is rejected" ) {
+				CHECK_FALSE( MaskCache::Decode(corrupted, KEY, loaded) );
+				CHECK_FALSE( loaded.IsLoaded() );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
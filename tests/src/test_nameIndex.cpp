@@ -0,0 +1,148 @@
+/* test_nameIndex.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/NameIndex.h"
+
+// ... and any system includes needed for the test file.
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+
+using Matches = std::vector<std::pair<double, const std::string *>>;
+
+// Get just the names of the given matches.
+std::vector<std::string> Names(const Matches &matches)
+{
+	std::vector<std::string> names;
+	for(const auto &match : matches)
+		names.push_back(*match.second);
+	return names;
+}
+
+// Score two strings by comparing each pair of characters of one to the pair at
+// the same position of the other, which is what the index should compute.
+double Score(const std::string &text, const std::string &name)
+{
+	const auto lower = [](const std::string &str, size_t i)
+	{
+		return i < str.size() ? std::tolower(static_cast<unsigned char>(str[i])) : 0;
+	};
+	int same = 0;
+	const size_t size = std::min(text.size(), name.size());
+	for(size_t i = 0; i < size; ++i)
+		if(lower(text, i) == lower(name, i)
+				&& (lower(text, i + 1) == lower(name, i + 1) || (i == size - 1 && i + 1 == text.size())))
+			++same;
+	return (2. * same) / (text.size() + name.size());
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Searching through a list of names", "[NameIndex]" ) {
+	GIVEN( "an index of some names" ) {
+		NameIndex index;
+		const std::vector<std::string> names = {"Shuttle", "Star Barge", "Sparrow", "Bastion", "Bulk Freighter",
+			"Heavy Shuttle", "shield generator", "Star Queen"};
+		for(const std::string &name : names)
+			index.Add(name);
+		Matches result;
+
+		THEN( "it contains the names" ) {
+			CHECK( index.Has("Sparrow") );
+			CHECK_FALSE( index.Has("Sparrow ") );
+		}
+		WHEN( "searching for part of a name" ) {
+			index.Search("sh", 10, result);
+			THEN( "the names with the most matching pairs come first" ) {
+				REQUIRE( result.size() == 2 );
+				CHECK( Names(result) == std::vector<std::string>{"Shuttle", "shield generator"} );
+			}
+		}
+		THEN( "every name gets the same score as comparing it directly" ) {
+			for(const std::string text : {"S", "st", "Star", "star q", "Bulk Freighter", "Shuttle+", "xyz"})
+			{
+				index.Search(text, names.size(), result);
+				for(const auto &match : result)
+					if(match.first)
+						CHECK( match.first == Score(text, *match.second) );
+				for(const std::string &name : names)
+				{
+					const bool found = std::any_of(result.begin(), result.end(),
+						[&name](const std::pair<double, const std::string *> &match) { return *match.second == name; });
+					if(Score(text, name) > 0.)
+						CHECK( found );
+				}
+			}
+		}
+		WHEN( "there are more matches than the limit" ) {
+			index.Search("S", 2, result);
+			THEN( "only the best matches are returned, sorted by name if they are equal" ) {
+				CHECK( Names(result) == std::vector<std::string>{"Shuttle", "Sparrow"} );
+			}
+		}
+		WHEN( "nothing matches" ) {
+			index.Search("xyz", 3, result);
+			THEN( "the first names in alphabetical order are returned" ) {
+				CHECK( Names(result) == std::vector<std::string>{"Bastion", "Bulk Freighter", "Heavy Shuttle"} );
+				CHECK( result[0].first == 0. );
+			}
+		}
+		WHEN( "a filter is given" ) {
+			index.Search("s", 10, result, [](const std::string &name) { return name != "Sparrow"; });
+			THEN( "names that are filtered out are not returned" ) {
+				const std::vector<std::string> found = Names(result);
+				CHECK( std::find(found.begin(), found.end(), "Sparrow") == found.end() );
+				CHECK( found.size() == 4 );
+			}
+		}
+		WHEN( "a name is removed" ) {
+			index.Remove("Shuttle");
+			index.Search("Shuttle", 10, result);
+			THEN( "it is no longer returned" ) {
+				const std::vector<std::string> found = Names(result);
+				CHECK_FALSE( index.Has("Shuttle") );
+				CHECK( std::find(found.begin(), found.end(), "Shuttle") == found.end() );
+			}
+			AND_WHEN( "it is added back" ) {
+				index.Add("Shuttle");
+				index.Search("Shuttle", 1, result);
+				THEN( "it is returned again" ) {
+					CHECK( Names(result) == std::vector<std::string>{"Shuttle"} );
+				}
+			}
+		}
+		WHEN( "a different list of names is assigned" ) {
+			const std::vector<std::string> others = {"Sparrow", "Hawk"};
+			index.Assign({&others[0], &others[1]});
+			index.Search("", 10, result);
+			THEN( "only the names in that list are in the index" ) {
+				CHECK( Names(result) == std::vector<std::string>{"Hawk", "Sparrow"} );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,81 @@
+/* test_outfit.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/Outfit.h"
+
+// ... and any system includes needed for the test file.
+
+namespace { // test namespace
+// #region mock data
+
+// Create an outfit with the given attributes.
+Outfit MakeOutfit(double thrust, double drag, double custom)
+{
+	Outfit outfit;
+	outfit.Set("thrust", thrust);
+	outfit.Set("drag", drag);
+	outfit.Set("plugin attribute", custom);
+	return outfit;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Looking up often-used outfit attributes", "[Outfit]" ) {
+	GIVEN( "an outfit with no attributes" ) {
+		const Outfit outfit = Outfit();
+		THEN( "every attribute is zero" ) {
+			CHECK( outfit.Get(Attribute::THRUST) == 0. );
+			CHECK( outfit.Get(Attribute::TURNING_HEAT) == 0. );
+		}
+	}
+	GIVEN( "an outfit with some attributes" ) {
+		Outfit outfit = MakeOutfit(20., 3., 5.);
+		THEN( "they can be looked up by name or by identifier" ) {
+			CHECK( outfit.Get(Attribute::THRUST) == 20. );
+			CHECK( outfit.Get(Attribute::DRAG) == 3. );
+			CHECK( outfit.Get("thrust") == 20. );
+			CHECK( outfit.Get("plugin attribute") == 5. );
+			CHECK( outfit.Get(Attribute::TURN) == 0. );
+		}
+		WHEN( "an attribute is changed" ) {
+			outfit.Set("drag", 1.5);
+			THEN( "its identifier gives the new value" ) {
+				CHECK( outfit.Get(Attribute::DRAG) == 1.5 );
+			}
+		}
+		WHEN( "other outfits are added to it" ) {
+			outfit.Add(MakeOutfit(10., 1., 2.), 3);
+			THEN( "its identifiers give the totals" ) {
+				CHECK( outfit.Get(Attribute::THRUST) == 50. );
+				CHECK( outfit.Get(Attribute::DRAG) == 6. );
+				CHECK( outfit.Get("plugin attribute") == 11. );
+			}
+		}
+		WHEN( "it is copied" ) {
+			const Outfit copy = outfit;
+			THEN( "the copy gives the same values" ) {
+				CHECK( copy.Get(Attribute::THRUST) == 20. );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,85 @@
+/* test_routeCache.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/RouteCache.h"
+
+// ... and any system includes needed for the test file.
+#include "../../source/DistanceMap.h"
+#include "../../source/System.h"
+
+#include <list>
+#include <memory>
+
+namespace { // test namespace
+// #region mock data
+
+// Create a chain of systems, each linked to the next one.
+std::list<System> MakeChain(int count)
+{
+	std::list<System> systems(count);
+	for(auto it = std::next(systems.begin()); it != systems.end(); ++it)
+		it->Link(&*std::prev(it));
+	return systems;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Sharing the routes between systems", "[RouteCache]" ) {
+	RouteCache::Clear();
+	GIVEN( "a chain of four linked systems" ) {
+		std::list<System> systems = MakeChain(4);
+		const System *first = &systems.front();
+		const System *last = &systems.back();
+
+		WHEN( "the routes from one of them are needed" ) {
+			const std::shared_ptr<const DistanceMap> routes = RouteCache::Get(first);
+			THEN( "they are the same as a map without any limits" ) {
+				const DistanceMap expected(first);
+				for(const System &system : systems)
+				{
+					CHECK( routes->Days(&system) == expected.Days(&system) );
+					CHECK( routes->Route(&system) == expected.Route(&system) );
+				}
+				CHECK( routes->Days(last) == 3 );
+			}
+			THEN( "they are only found once" ) {
+				CHECK( RouteCache::Get(first) == routes );
+				CHECK( RouteCache::Get(last) != routes );
+				CHECK( RouteCache::Size() == 2 );
+			}
+		}
+		WHEN( "the systems change after the routes were found" ) {
+			const std::shared_ptr<const DistanceMap> routes = RouteCache::Get(first);
+			systems.front().Link(&systems.back());
+			RouteCache::Clear();
+			THEN( "the old routes can still be used" ) {
+				CHECK( routes->Days(last) == 3 );
+			}
+			THEN( "new routes are found" ) {
+				CHECK( RouteCache::Size() == 0 );
+				CHECK( RouteCache::Get(first)->Days(last) == 1 );
+			}
+		}
+	}
+	RouteCache::Clear();
+}
+// #endregion unit tests
+
+
+
+} // test namespace
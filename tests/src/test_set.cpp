@@ -16,7 +16,9 @@ PARTICULAR PURPOSE.  See the GNU General Public License for more details.
 #include "../../source/Set.h"
 
 // ... and any system includes needed for the test file.
+#include <map>
 #include <string>
+#include <vector>
 
 namespace { // test namespace
 // #region mock data
@@ -24,6 +26,24 @@ class T {
 public:
 	int a = 1;
 };
+
+// Get the names of the objects in the given set, in iteration order.
+std::vector<std::string> Names(const Set<T> &s)
+{
+	std::vector<std::string> names;
+	for(const auto &it : s)
+		names.push_back(it.first);
+	return names;
+}
+
+// Make a list of names similar to those of the objects in the game data.
+std::vector<std::string> MakeNames(int count)
+{
+	std::vector<std::string> names;
+	for(int i = 0; i < count; ++i)
+		names.push_back("Object Name " + std::to_string(i * 7919 % count));
+	return names;
+}
 // #endregion mock data
 
 
@@ -140,8 +160,161 @@ SCENARIO( "A Set can be reverted to an earlier state", "[Set]" ) {
 		}
 	}
 }
+
+SCENARIO( "Iterating over a Set", "[Set]" ) {
+	GIVEN( "a Set with data added out of order" ) {
+		auto s = Set<T>{};
+		s.Get("C");
+		s.Get("A");
+		s.Get("B");
+		
+		THEN( "the objects are visited in order of their names" ) {
+			CHECK( Names(s) == std::vector<std::string>{"A", "B", "C"} );
+		}
+		WHEN( "more objects are added" ) {
+			REQUIRE( Names(s).size() == 3 );
+			s.Get("AA");
+			THEN( "they are included the next time the set is iterated" ) {
+				CHECK( Names(s) == std::vector<std::string>{"A", "AA", "B", "C"} );
+			}
+		}
+		WHEN( "an object is renamed" ) {
+			const T *ptr = s.Find("A");
+			s.Rename("A", "D");
+			THEN( "it moves to its new place in the order" ) {
+				CHECK( Names(s) == std::vector<std::string>{"B", "C", "D"} );
+			}
+			THEN( "pointers to it are still valid" ) {
+				CHECK( s.Find("D") == ptr );
+			}
+		}
+		WHEN( "objects are added before the current one during an iteration" ) {
+			std::vector<std::string> visited;
+			for(const auto &it : s)
+			{
+				s.Get("0" + it.first);
+				visited.push_back(it.first);
+			}
+			THEN( "each of the original objects is visited once" ) {
+				CHECK( visited == std::vector<std::string>{"A", "B", "C"} );
+				CHECK( s.size() == 6 );
+			}
+		}
+		WHEN( "objects are added after the current one during an iteration" ) {
+			std::vector<std::string> visited;
+			for(const auto &it : s)
+			{
+				if(it.first.size() == 1)
+					s.Get(it.first + "+");
+				visited.push_back(it.first);
+			}
+			THEN( "they are visited as well" ) {
+				CHECK( visited == std::vector<std::string>{"A", "A+", "B", "B+", "C", "C+"} );
+			}
+		}
+		WHEN( "the set is copied or moved" ) {
+			const Set<T> copy = s;
+			Set<T> moved = std::move(s);
+			THEN( "the new sets are iterated in the same order" ) {
+				CHECK( Names(copy) == std::vector<std::string>{"A", "B", "C"} );
+				CHECK( Names(moved) == std::vector<std::string>{"A", "B", "C"} );
+			}
+		}
+		WHEN( "it is reverted to a set with fewer objects" ) {
+			auto other = Set<T>{};
+			other.Get("B");
+			s.Revert(other);
+			THEN( "the removed objects are no longer visited" ) {
+				CHECK( Names(s) == std::vector<std::string>{"B"} );
+			}
+		}
+	}
+	GIVEN( "a Set that grows large" ) {
+		auto s = Set<T>{};
+		const T *first = s.Get("first");
+		for(const std::string &name : MakeNames(10000))
+			s.Get(name);
+		THEN( "pointers to its objects stay valid" ) {
+			CHECK( s.Find("first") == first );
+		}
+	}
+}
+
+SCENARIO( "Tracking changes to the names in a Set", "[Set]" ) {
+	GIVEN( "a Set with some data" ) {
+		auto s = Set<T>{};
+		s.Get("A");
+		const size_t revision = s.Revision();
+		WHEN( "existing objects are looked up" ) {
+			s.Get("A");
+			s.Find("B");
+			THEN( "the revision does not change" ) {
+				CHECK( s.Revision() == revision );
+			}
+		}
+		WHEN( "an object is added" ) {
+			s.Get("B");
+			THEN( "the revision changes" ) {
+				CHECK( s.Revision() != revision );
+			}
+		}
+		WHEN( "an object is renamed" ) {
+			s.Rename("A", "B");
+			THEN( "the revision changes" ) {
+				CHECK( s.Revision() != revision );
+			}
+		}
+	}
+}
 // #endregion unit tests
 
+// #region benchmarks
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE( "Benchmark Set lookups", "[!benchmark][set]" ) {
+	// Compare against the std::map that Set used to be implemented with.
+	const std::vector<std::string> names = MakeNames(2000);
+	BENCHMARK( "std::map filling" ) {
+		std::map<std::string, T> m;
+		for(const std::string &name : names)
+			m[name];
+		return m.size();
+	};
+	BENCHMARK( "Set::Get filling" ) {
+		Set<T> s;
+		for(const std::string &name : names)
+			s.Get(name);
+		return s.size();
+	};
+	
+	std::map<std::string, T> m;
+	Set<T> s;
+	for(const std::string &name : names)
+	{
+		m[name];
+		s.Get(name);
+	}
+	BENCHMARK( "std::map::find" ) {
+		int found = 0;
+		for(const std::string &name : names)
+			found += m.find(name) != m.end();
+		return found;
+	};
+	BENCHMARK( "Set::Find" ) {
+		int found = 0;
+		for(const std::string &name : names)
+			found += s.Find(name) != nullptr;
+		return found;
+	};
+	BENCHMARK( "Set iteration" ) {
+		int total = 0;
+		for(const auto &it : s)
+			total += it.second.a;
+		return total;
+	};
+}
+#endif
+// #endregion benchmarks
+
 
 
 } // test namespace
@@ -0,0 +1,167 @@
+/* test_shipGrid.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/ShipGrid.h"
+
+// ... and any system includes needed for the test file.
+#include "../../source/Point.h"
+#include "../../source/Ship.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+
+// The size of the grid cells.
+const double CELL = 2048.;
+// The distance at which the cell coordinates wrap around, so that cells this
+// far apart share a key.
+const double WRAP = CELL * 4294967296.;
+
+// Make a ship at each of the given positions.
+std::vector<std::shared_ptr<Ship>> MakeShips(const std::vector<Point> &positions)
+{
+	std::vector<std::shared_ptr<Ship>> ships;
+	for(const Point &position : positions)
+	{
+		ships.push_back(std::make_shared<Ship>());
+		ships.back()->Place(position);
+	}
+	return ships;
+}
+
+// Ships on and right next to the cell edges, scattered ships, and ships that
+// are in cells that share a key with the cells near the origin.
+std::vector<Point> MakePositions()
+{
+	std::vector<Point> positions;
+	for(double x : {-CELL, -.001, 0., CELL - .001, CELL, 2. * CELL})
+		for(double y : {-CELL, 0., CELL})
+			positions.emplace_back(x, y);
+	unsigned state = 12345u;
+	const auto next = [&state]()
+	{
+		state = state * 1103515245u + 12345u;
+		return 20000. * ((state >> 8) & 0xFFFF) / 65536. - 10000.;
+	};
+	for(int i = 0; i < 200; ++i)
+	{
+		const double x = next();
+		positions.emplace_back(x, next());
+	}
+	for(const Point &offset : {Point(WRAP, 0.), Point(0., WRAP), Point(-WRAP, -WRAP)})
+	{
+		positions.push_back(offset + Point(10., 10.));
+		positions.push_back(offset + Point(CELL, -5.));
+	}
+	return positions;
+}
+
+// Add the ships to the grid the way the AI does, spread over a few rosters.
+void Fill(ShipGrid &grid, const std::vector<std::shared_ptr<Ship>> &ships)
+{
+	grid.Clear();
+	for(size_t i = 0; i < ships.size(); ++i)
+		grid.Add(ships[i], i % 3);
+}
+
+// Find the ships within range by checking the grid, returning the index and
+// roster of each one.
+std::vector<std::pair<size_t, size_t>> FromGrid(const ShipGrid &grid, const Point &center, double range)
+{
+	std::vector<std::pair<size_t, size_t>> result;
+	for(const ShipGrid::Entry *entry : grid.Find(center, range))
+		if(center.Distance((*entry->ship)->Position()) < range)
+			result.emplace_back(entry->order, entry->roster);
+	return result;
+}
+
+// Find the ships within range by checking every ship.
+std::vector<std::pair<size_t, size_t>> FromScan(const std::vector<std::shared_ptr<Ship>> &ships,
+	const Point &center, double range)
+{
+	std::vector<std::pair<size_t, size_t>> result;
+	for(size_t i = 0; i < ships.size(); ++i)
+		if(center.Distance(ships[i]->Position()) < range)
+			result.emplace_back(i, i % 3);
+	return result;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Finding the ships near a point", "[ShipGrid]" ) {
+	GIVEN( "ships on cell edges, scattered ships, and ships where the cells wrap around" ) {
+		const std::vector<std::shared_ptr<Ship>> ships = MakeShips(MakePositions());
+		ShipGrid grid;
+		Fill(grid, ships);
+
+		WHEN( "the ships near a point are found through the grid" ) {
+			std::vector<Point> centers = {
+				Point(), Point(CELL, CELL), Point(-CELL, 0.), Point(CELL - .001, -.001), Point(1000., -3000.),
+				Point(WRAP, 0.), Point(WRAP + 5., 15.), Point(0., WRAP), Point(-WRAP, -WRAP)
+			};
+			for(int i = 0; i < 20; ++i)
+				centers.push_back(ships[30 + i]->Position() + Point(i * 37., -i * 53.));
+			THEN( "they are the same ships, in the same order, as checking every ship finds" ) {
+				for(const Point &center : centers)
+					for(double range : {.001, 10., 100., CELL - .001, CELL, CELL + .001, 3000., 2. * CELL + 1.})
+					{
+						CAPTURE( center.X(), center.Y(), range );
+						CHECK( FromGrid(grid, center, range) == FromScan(ships, center, range) );
+					}
+			}
+		}
+		WHEN( "the cells are reused for another step" ) {
+			for(const std::shared_ptr<Ship> &ship : ships)
+				ship->Place(ship->Position() + Point(CELL / 3., -CELL / 2.));
+			Fill(grid, ships);
+			THEN( "the ships are only found where they are now" ) {
+				for(const Point &center : {Point(), Point(CELL / 3., -CELL / 2.), Point(WRAP + 700., -1000.)})
+					for(double range : {10., 1000., CELL})
+					{
+						CAPTURE( center.X(), center.Y(), range );
+						CHECK( FromGrid(grid, center, range) == FromScan(ships, center, range) );
+					}
+			}
+		}
+	}
+}
+
+SCENARIO( "Deciding whether to search the grid", "[ShipGrid]" ) {
+	GIVEN( "ships spread over many cells" ) {
+		std::vector<Point> positions;
+		for(int i = 0; i < 100; ++i)
+			positions.emplace_back(i * CELL, 0.);
+		const std::vector<std::shared_ptr<Ship>> ships = MakeShips(positions);
+		ShipGrid grid;
+		Fill(grid, ships);
+		THEN( "searching is worth it for a short range" ) {
+			CHECK( grid.IsWorthSearching(100.) );
+		}
+		THEN( "searching is not worth it for a range that covers more cells than the grid has" ) {
+			CHECK_FALSE( grid.IsWorthSearching(20. * CELL) );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,109 @@
+/* test_spriteBudget.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/SpriteBudget.h"
+
+// ... and any system includes needed for the test file.
+#include "../../source/Sprite.h"
+
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+
+// Use the given sprite, and set its memory as if it had finished loading.
+bool Load(SpriteBudget &budget, const Sprite &sprite, size_t memory, bool isNearby = false)
+{
+	const bool isNew = budget.Use(&sprite, isNearby);
+	budget.SetMemory(&sprite, memory);
+	return isNew;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Keeping sprites loaded on demand within a memory budget", "[SpriteBudget]" ) {
+	GIVEN( "a budget with room for three sprites" ) {
+		const std::vector<Sprite> sprites(5);
+		SpriteBudget budget(300);
+		REQUIRE( Load(budget, sprites[0], 100) );
+		REQUIRE( Load(budget, sprites[1], 100) );
+		REQUIRE( Load(budget, sprites[2], 100) );
+		REQUIRE( budget.Unload().empty() );
+		REQUIRE( budget.Memory() == 300 );
+
+		WHEN( "a sprite that is already loaded is used again" ) {
+			THEN( "it does not need to be loaded" ) {
+				CHECK_FALSE( budget.Use(&sprites[1]) );
+				CHECK( budget.Unload().empty() );
+			}
+		}
+		WHEN( "another sprite is loaded" ) {
+			budget.Use(&sprites[0]);
+			Load(budget, sprites[3], 100);
+			THEN( "the one that has gone unused the longest is unloaded" ) {
+				CHECK( budget.Unload() == std::vector<const Sprite *>{&sprites[1]} );
+				CHECK( budget.Memory() == 300 );
+				CHECK( budget.Use(&sprites[1]) );
+			}
+		}
+		WHEN( "some sprites are only nearby" ) {
+			Load(budget, sprites[3], 100, true);
+			Load(budget, sprites[4], 100, true);
+			budget.Use(&sprites[0]);
+			THEN( "they are unloaded before any others, oldest first" ) {
+				CHECK( budget.Unload() == std::vector<const Sprite *>{&sprites[3], &sprites[4]} );
+				CHECK( budget.Memory() == 300 );
+			}
+		}
+		WHEN( "the most recently used sprite is only nearby" ) {
+			Load(budget, sprites[3], 100, true);
+			THEN( "it is kept, and older sprites are unloaded instead" ) {
+				CHECK( budget.Unload() == std::vector<const Sprite *>{&sprites[0]} );
+				CHECK( budget.Memory() == 300 );
+				CHECK_FALSE( budget.Use(&sprites[3]) );
+			}
+		}
+		WHEN( "a sprite that is needed for its own sake is also nearby" ) {
+			budget.Use(&sprites[0], true);
+			Load(budget, sprites[3], 100);
+			THEN( "it is not unloaded before the older sprites" ) {
+				CHECK( budget.Unload() == std::vector<const Sprite *>{&sprites[1]} );
+				CHECK_FALSE( budget.Use(&sprites[0]) );
+			}
+		}
+		WHEN( "a new sprite has not finished loading yet" ) {
+			budget.Use(&sprites[3]);
+			THEN( "it takes up no memory and nothing needs to be unloaded" ) {
+				CHECK( budget.Memory() == 300 );
+				CHECK( budget.Unload().empty() );
+			}
+		}
+		WHEN( "the budget shrinks below the most recent sprite" ) {
+			budget.SetLimit(50);
+			THEN( "every sprite but the most recent is unloaded" ) {
+				CHECK( budget.Unload() == std::vector<const Sprite *>{&sprites[0], &sprites[1]} );
+				CHECK( budget.Sprites() == std::vector<const Sprite *>{&sprites[2]} );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,90 @@
+/* test_spriteShader.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/SpriteShader.h"
+
+// ... and any system includes needed for the test file.
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+
+// Make a list of items from the texture and swizzle of each one.
+std::vector<SpriteShader::Item> MakeItems(const std::vector<std::pair<uint32_t, uint32_t>> &textures)
+{
+	std::vector<SpriteShader::Item> items;
+	for(const auto &it : textures)
+	{
+		items.emplace_back();
+		items.back().texture = it.first;
+		items.back().swizzle = it.second;
+	}
+	return items;
+}
+
+// Split the items into batches, the same way they are drawn, and return the
+// index of the first item of each batch.
+std::vector<size_t> BatchStarts(const std::vector<SpriteShader::Item> &items, bool useShaderSwizzle)
+{
+	std::vector<size_t> starts;
+	for(size_t start = 0; start < items.size(); start = SpriteShader::BatchEnd(items, start, useShaderSwizzle))
+		starts.push_back(start);
+	return starts;
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Splitting a draw list into batches", "[SpriteShader]" ) {
+	GIVEN( "many items that all use the same texture" ) {
+		const auto items = MakeItems(std::vector<std::pair<uint32_t, uint32_t>>(500, {7, 0}));
+		THEN( "they are all drawn with one draw call" ) {
+			CHECK( BatchStarts(items, true) == std::vector<size_t>{0} );
+			CHECK( BatchStarts(items, false) == std::vector<size_t>{0} );
+		}
+	}
+	GIVEN( "items whose textures change partway through the list" ) {
+		const auto items = MakeItems({{1, 0}, {1, 0}, {1, 0}, {2, 0}, {2, 0}, {1, 0}, {3, 0}});
+		THEN( "each run of items with the same texture is one batch" ) {
+			CHECK( BatchStarts(items, true) == std::vector<size_t>{0, 3, 5, 6} );
+		}
+		THEN( "items with a texture that was used earlier are not moved out of order" ) {
+			CHECK( BatchStarts(items, true).size() == 4 );
+		}
+	}
+	GIVEN( "items with the same texture but different swizzles" ) {
+		const auto items = MakeItems({{4, 0}, {4, 2}, {4, 2}, {4, 5}, {5, 5}});
+		WHEN( "the swizzle is applied by the shader" ) {
+			THEN( "only the texture splits the batches" ) {
+				CHECK( BatchStarts(items, true) == std::vector<size_t>{0, 4} );
+			}
+		}
+		WHEN( "the swizzle is a texture setting" ) {
+			THEN( "a change of swizzle also starts a new batch" ) {
+				CHECK( BatchStarts(items, false) == std::vector<size_t>{0, 1, 3, 4} );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,181 @@
+/* test_systemIndex.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/SystemIndex.h"
+
+// ... and any system includes needed for the test file.
+#include "datanode-factory.h"
+#include "../../source/Planet.h"
+#include "../../source/Point.h"
+#include "../../source/Set.h"
+#include "../../source/System.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+// #region mock data
+
+// Coordinates on both sides of the grid lines, and right on them.
+const std::vector<double> COORDINATES = {
+	-300., -250., -200.5, -200., -100., -99.5, -.5, 0., .5, 50., 99.999, 100., 150., 200., 300.
+};
+
+// Give the system with the given name the given position.
+void Place(Set<System> &systems, const std::string &name, double x, double y)
+{
+	Set<Planet> planets;
+	systems.Get(name)->Load(AsDataNode("system \"" + name + "\"\n\tpos " + std::to_string(x) + " "
+		+ std::to_string(y)), planets, true);
+}
+
+// Create a system at each combination of the coordinates.
+Set<System> MakeGrid()
+{
+	Set<System> systems;
+	int i = 0;
+	for(double x : COORDINATES)
+		for(double y : COORDINATES)
+			Place(systems, "System " + std::to_string(i++), x, y);
+	return systems;
+}
+
+// Find the systems within the given distance by checking every one of them.
+std::vector<const System *> BruteForce(const Set<System> &systems, const Point &center, double distance,
+	const System *exclude = nullptr)
+{
+	std::vector<const System *> result;
+	for(const auto &it : systems)
+		if(&it.second != exclude && !it.second.Name().empty() && it.second.Position().Distance(center) <= distance)
+			result.push_back(&it.second);
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+// Find the systems within the given distance using the index.
+std::vector<const System *> Within(const SystemIndex &index, const Point &center, double distance,
+	const System *exclude = nullptr)
+{
+	std::vector<const System *> result;
+	index.Within(center, distance, result, exclude);
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+// Check that the index finds the same systems as a brute-force search for
+// queries centered on and between the grid lines, with various distances.
+void CheckQueries(const SystemIndex &index, const Set<System> &systems)
+{
+	for(double x : COORDINATES)
+		for(double y : {-200., -99.5, 0., 100., 150.})
+			for(double distance : {0., 50., 99.999, 100., 100.5, 250.})
+			{
+				const Point center(x, y);
+				CAPTURE( x, y, distance );
+				CHECK( Within(index, center, distance) == BruteForce(systems, center, distance) );
+			}
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Finding the systems near a point", "[SystemIndex]" ) {
+	GIVEN( "systems on and around the grid lines, at positive and negative coordinates" ) {
+		const Set<System> systems = MakeGrid();
+		SystemIndex index;
+		index.Build(systems);
+
+		THEN( "queries find the same systems as checking every system" ) {
+			CheckQueries(index, systems);
+		}
+		THEN( "systems exactly at the query distance are included" ) {
+			const System *system = systems.Find("System 0");
+			const Point &position = system->Position();
+			const std::vector<const System *> result = Within(index, position + Point(100., 0.), 100.);
+			CHECK( std::count(result.begin(), result.end(), system) == 1 );
+		}
+		THEN( "the excluded system is left out" ) {
+			const System *system = systems.Find("System 100");
+			const Point &center = system->Position();
+			const std::vector<const System *> result = Within(index, center, 150., system);
+			CHECK( result == BruteForce(systems, center, 150., system) );
+			CHECK( std::count(result.begin(), result.end(), system) == 0 );
+		}
+		THEN( "queries that cover more cells than are occupied find the same systems" ) {
+			for(double distance : {1000., 1e6})
+			{
+				CHECK( Within(index, Point(), distance) == BruteForce(systems, Point(), distance) );
+				CHECK( Within(index, Point(-5000., 3000.), distance)
+					== BruteForce(systems, Point(-5000., 3000.), distance) );
+			}
+		}
+		WHEN( "systems are moved to other cells, or within their cell" ) {
+			Set<System> moved = systems;
+			index.Build(moved);
+			Place(moved, "System 3", 401., -401.);
+			Place(moved, "System 7", -7., 12.);
+			Place(moved, "System 8", .25, .5);
+			Place(moved, "System 9", 100., 0.);
+			for(const char *name : {"System 3", "System 7", "System 8", "System 9"})
+				index.Update(moved.Find(name));
+			THEN( "queries find them at their new positions" ) {
+				CheckQueries(index, moved);
+				CHECK( *index.Position(moved.Find("System 3")) == Point(401., -401.) );
+			}
+		}
+		WHEN( "systems are removed" ) {
+			Set<System> remaining = systems;
+			index.Build(remaining);
+			for(const char *name : {"System 0", "System 17", "System 112"})
+			{
+				index.Remove(remaining.Find(name));
+				remaining.Erase(name);
+			}
+			THEN( "queries no longer find them" ) {
+				CheckQueries(index, remaining);
+				CHECK( index.Position(remaining.Find("System 17")) == nullptr );
+			}
+		}
+	}
+	GIVEN( "a few systems far apart" ) {
+		Set<System> systems;
+		Place(systems, "Near", -150., -150.);
+		Place(systems, "Far", 12345., -6789.);
+		Place(systems, "Farther", -98765., 43210.);
+		SystemIndex index;
+		index.Build(systems);
+		THEN( "large queries check the occupied cells instead of every cell they cover" ) {
+			for(double distance : {100., 15000., 200000.})
+				CHECK( Within(index, Point(), distance) == BruteForce(systems, Point(), distance) );
+		}
+	}
+	GIVEN( "systems without a name" ) {
+		Set<System> systems = MakeGrid();
+		systems.Find("System 5")->SetName("");
+		SystemIndex index;
+		index.Build(systems);
+		THEN( "they are never found" ) {
+			CheckQueries(index, systems);
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,74 @@
+/* test_threadPool.cpp
+Copyright (c) 2026 quyykk
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../source/ThreadPool.h"
+
+// ... and any system includes needed for the test file.
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace { // test namespace
+
+// #region unit tests
+SCENARIO( "Splitting a loop over a ThreadPool", "[ThreadPool]" ) {
+	GIVEN( "a pool with several worker threads" ) {
+		ThreadPool pool(3);
+		THEN( "the calling thread is counted as well" ) {
+			CHECK( pool.Concurrency() == 4 );
+		}
+		WHEN( "a loop is run" ) {
+			std::vector<int> calls(1000);
+			pool.ForEach(calls.size(), [&calls](size_t i) { ++calls[i]; });
+			THEN( "every index is visited exactly once" ) {
+				CHECK( std::all_of(calls.begin(), calls.end(), [](int count) { return count == 1; }) );
+			}
+		}
+		WHEN( "many loops are run one after another" ) {
+			std::atomic<int> total(0);
+			for(int loop = 0; loop < 200; ++loop)
+				pool.ForEach(loop % 7, [&total](size_t) { ++total; });
+			THEN( "each of them finishes before the next one begins" ) {
+				int expected = 0;
+				for(int loop = 0; loop < 200; ++loop)
+					expected += loop % 7;
+				CHECK( total == expected );
+			}
+		}
+		WHEN( "an empty loop is run" ) {
+			bool called = false;
+			pool.ForEach(0, [&called](size_t) { called = true; });
+			THEN( "nothing is called" ) {
+				CHECK_FALSE( called );
+			}
+		}
+	}
+	GIVEN( "a pool without any worker threads" ) {
+		ThreadPool pool(0);
+		WHEN( "a loop is run" ) {
+			std::vector<size_t> order;
+			pool.ForEach(5, [&order](size_t i) { order.push_back(i); });
+			THEN( "the calling thread does all the work, in order" ) {
+				CHECK( pool.Concurrency() == 1 );
+				CHECK( order == std::vector<size_t>{0, 1, 2, 3, 4} );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace